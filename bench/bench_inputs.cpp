@@ -0,0 +1,382 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "bench_inputs.h"
+
+#include "../src/base/application.h"
+#include "../src/base/document.h"
+#include "../src/base/io_system.h"
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <TDataStd_Name.hxx>
+#include <TopLoc_Location.hxx>
+#include <XCAFDoc_ShapeTool.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+
+#include <fmt/format.h>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace Mayo::Bench {
+
+namespace {
+
+// Square grid of vertices whose z coordinate is a smooth function of (x, y)
+class HeightField {
+public:
+    explicit HeightField(uint64_t minTriangleCount)
+        : m_size(int(std::ceil(std::sqrt(double(minTriangleCount) / 2.))) + 1)
+    {}
+
+    int vertexCount() const { return m_size * m_size; }
+    uint64_t triangleCount() const { return 2 * uint64_t(m_size - 1) * uint64_t(m_size - 1); }
+
+    std::array<float, 3> vertex(int i, int j) const {
+        const float x = float(i);
+        const float y = float(j);
+        return { x, y, 4.f * std::sin(x * 0.05f) * std::cos(y * 0.05f) };
+    }
+
+    std::array<float, 3> vertex(int index) const { return this->vertex(index % m_size, index / m_size); }
+
+    // Calls fn(v0, v1, v2) for each triangle, vertices being identified by their index
+    template<typename Function>
+    void forEachTriangle(Function fn) const {
+        for (int j = 0; j + 1 < m_size; ++j) {
+            for (int i = 0; i + 1 < m_size; ++i) {
+                const int v00 = j * m_size + i;
+                const int v10 = v00 + 1;
+                const int v01 = v00 + m_size;
+                const int v11 = v01 + 1;
+                fn(v00, v10, v11);
+                fn(v00, v11, v01);
+            }
+        }
+    }
+
+    // Color of some vertex, varies along x and y
+    std::array<uint8_t, 3> vertexColor(int index) const {
+        const int i = index % m_size;
+        const int j = index / m_size;
+        return { uint8_t((i * 255) / m_size), uint8_t((j * 255) / m_size), 128 };
+    }
+
+private:
+    int m_size = 0;
+};
+
+std::array<float, 3> triangleNormal(
+        const std::array<float, 3>& p0, const std::array<float, 3>& p1, const std::array<float, 3>& p2
+    )
+{
+    const float u[] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+    const float v[] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+    std::array<float, 3> n = { u[1]*v[2] - u[2]*v[1], u[2]*v[0] - u[0]*v[2], u[0]*v[1] - u[1]*v[0] };
+    const float length = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+    if (length > 0.f) {
+        for (float& coord : n)
+            coord /= length;
+    }
+
+    return n;
+}
+
+// Output file stream with a large buffer, throws on opening errors
+class OutputFile {
+public:
+    explicit OutputFile(const FilePath& filepath)
+        : m_fstr(filepath, std::ios::out | std::ios::binary)
+    {
+        if (!m_fstr.is_open())
+            throw std::runtime_error(fmt::format("Can't open file '{}'", filepath.u8string()));
+    }
+
+    ~OutputFile() {
+        this->flush();
+    }
+
+    fmt::memory_buffer& buffer() {
+        if (m_buffer.size() > 1024 * 1024)
+            this->flush();
+
+        return m_buffer;
+    }
+
+    template<typename T> void writeBinary(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        this->buffer().append(bytes, bytes + sizeof(T));
+    }
+
+    void flush() {
+        m_fstr.write(m_buffer.data(), m_buffer.size());
+        m_buffer.clear();
+    }
+
+private:
+    std::ofstream m_fstr;
+    fmt::memory_buffer m_buffer;
+};
+
+} // namespace
+
+GeneratedInput generateStlBinary(const FilePath& filepath, uint64_t triangleCount)
+{
+    const HeightField field(triangleCount);
+    OutputFile file(filepath);
+    const std::string header = fmt::format("{:<80}", "mayo_bench height field");
+    file.buffer().append(header.data(), header.data() + header.size());
+    file.writeBinary(uint32_t(field.triangleCount()));
+    field.forEachTriangle([&](int v0, int v1, int v2) {
+        const std::array<float, 3> pnts[] = { field.vertex(v0), field.vertex(v1), field.vertex(v2) };
+        for (float coord : triangleNormal(pnts[0], pnts[1], pnts[2]))
+            file.writeBinary(coord);
+
+        for (const std::array<float, 3>& pnt : pnts) {
+            for (float coord : pnt)
+                file.writeBinary(coord);
+        }
+
+        file.writeBinary(uint16_t(0)); // Attribute byte count
+    });
+
+    return { filepath, IO::Format_STL, field.triangleCount(), 0 };
+}
+
+GeneratedInput generateStlAscii(const FilePath& filepath, uint64_t triangleCount)
+{
+    const HeightField field(triangleCount);
+    OutputFile file(filepath);
+    fmt::format_to(std::back_inserter(file.buffer()), "solid mayo_bench\n");
+    field.forEachTriangle([&](int v0, int v1, int v2) {
+        const std::array<float, 3> pnts[] = { field.vertex(v0), field.vertex(v1), field.vertex(v2) };
+        const std::array<float, 3> n = triangleNormal(pnts[0], pnts[1], pnts[2]);
+        auto out = std::back_inserter(file.buffer());
+        fmt::format_to(out, "  facet normal {:e} {:e} {:e}\n    outer loop\n", n[0], n[1], n[2]);
+        for (const std::array<float, 3>& pnt : pnts)
+            fmt::format_to(out, "      vertex {:e} {:e} {:e}\n", pnt[0], pnt[1], pnt[2]);
+
+        fmt::format_to(out, "    endloop\n  endfacet\n");
+    });
+    fmt::format_to(std::back_inserter(file.buffer()), "endsolid mayo_bench\n");
+    return { filepath, IO::Format_STL, field.triangleCount(), 0 };
+}
+
+GeneratedInput generatePlyColored(const FilePath& filepath, uint64_t triangleCount)
+{
+    const HeightField field(triangleCount);
+    OutputFile file(filepath);
+    fmt::format_to(
+        std::back_inserter(file.buffer()),
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "comment mayo_bench height field\n"
+        "element vertex {}\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "property uchar red\n"
+        "property uchar green\n"
+        "property uchar blue\n"
+        "element face {}\n"
+        "property list uchar int vertex_indices\n"
+        "end_header\n",
+        field.vertexCount(), field.triangleCount()
+    );
+    for (int i = 0; i < field.vertexCount(); ++i) {
+        for (float coord : field.vertex(i))
+            file.writeBinary(coord);
+
+        for (uint8_t component : field.vertexColor(i))
+            file.writeBinary(component);
+    }
+
+    field.forEachTriangle([&](int v0, int v1, int v2) {
+        file.writeBinary(uint8_t(3));
+        file.writeBinary(int32_t(v0));
+        file.writeBinary(int32_t(v1));
+        file.writeBinary(int32_t(v2));
+    });
+
+    return { filepath, IO::Format_PLY, field.triangleCount(), 0 };
+}
+
+GeneratedInput generateOff(const FilePath& filepath, uint64_t triangleCount)
+{
+    const HeightField field(triangleCount);
+    OutputFile file(filepath);
+    fmt::format_to(std::back_inserter(file.buffer()), "OFF\n{} {} 0\n", field.vertexCount(), field.triangleCount());
+    for (int i = 0; i < field.vertexCount(); ++i) {
+        const std::array<float, 3> pnt = field.vertex(i);
+        fmt::format_to(std::back_inserter(file.buffer()), "{} {} {}\n", pnt[0], pnt[1], pnt[2]);
+    }
+
+    field.forEachTriangle([&](int v0, int v1, int v2) {
+        fmt::format_to(std::back_inserter(file.buffer()), "3 {} {} {}\n", v0, v1, v2);
+    });
+
+    return { filepath, IO::Format_OFF, field.triangleCount(), 0 };
+}
+
+GeneratedInput generateDxf(const FilePath& filepath, int entityCount)
+{
+    OutputFile file(filepath);
+    fmt::format_to(
+        std::back_inserter(file.buffer()),
+        "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1009\n0\nENDSEC\n0\nSECTION\n2\nENTITIES\n"
+    );
+    for (int i = 0; i < entityCount; ++i) {
+        const double x = (i % 1000) * 10.;
+        const double y = (i / 1000) * 10.;
+        auto out = std::back_inserter(file.buffer());
+        switch (i % 3) {
+        case 0:
+            fmt::format_to(
+                out, "0\nLINE\n8\n0\n10\n{}\n20\n{}\n30\n0\n11\n{}\n21\n{}\n31\n0\n", x, y, x + 8., y + 8.
+            );
+            break;
+        case 1:
+            fmt::format_to(out, "0\nCIRCLE\n8\n0\n10\n{}\n20\n{}\n30\n0\n40\n4\n", x + 5., y + 5.);
+            break;
+        case 2:
+            fmt::format_to(
+                out,
+                "0\n3DFACE\n8\n0\n"
+                "10\n{0}\n20\n{1}\n30\n0\n11\n{2}\n21\n{1}\n31\n0\n"
+                "12\n{2}\n22\n{3}\n32\n1\n13\n{0}\n23\n{3}\n33\n1\n",
+                x, y, x + 8., y + 8.
+            );
+            break;
+        }
+    }
+
+    fmt::format_to(std::back_inserter(file.buffer()), "0\nENDSEC\n0\nEOF\n");
+    return { filepath, IO::Format_DXF, 0, entityCount };
+}
+
+GeneratedInput generateStepAssembly(
+        const IO::System& ioSystem,
+        const ApplicationPtr& app,
+        const FilePath& filepath,
+        int partCount,
+        int instanceCount
+    )
+{
+    DocumentPtr doc = app->newDocument();
+    OccHandle<XCAFDoc_ShapeTool> shapeTool = doc->xcaf().shapeTool();
+    std::vector<TDF_Label> vecPartLabel;
+    for (int i = 0; i < partCount; ++i) {
+        const TopoDS_Shape shape =
+            i % 2 == 0 ?
+                BRepPrimAPI_MakeBox(1. + i % 5, 1. + i % 3, 1. + i % 7).Shape() :
+                BRepPrimAPI_MakeCylinder(0.5 + 0.1 * (i % 4), 1. + i % 3).Shape()
+            ;
+        const TDF_Label labelPart = shapeTool->AddShape(shape, false/*!makeAssembly*/);
+        TDataStd_Name::Set(labelPart, TCollection_ExtendedString(fmt::format("part_{}", i).c_str()));
+        vecPartLabel.push_back(labelPart);
+    }
+
+    const TDF_Label labelAssembly = shapeTool->NewShape();
+    TDataStd_Name::Set(labelAssembly, "mayo_bench_assembly");
+    for (int i = 0; i < instanceCount; ++i) {
+        gp_Trsf trsf;
+        trsf.SetTranslation(gp_Vec((i % 100) * 10., ((i / 100) % 100) * 10., (i / 10000) * 10.));
+        shapeTool->AddComponent(labelAssembly, vecPartLabel.at(i % partCount), TopLoc_Location(trsf));
+    }
+
+    shapeTool->UpdateAssemblies();
+    doc->addEntityTreeNode(labelAssembly);
+    const bool okExport = ioSystem.exportApplicationItems()
+            .targetFile(filepath)
+            .targetFormat(IO::Format_STEP)
+            .withItem(ApplicationItem{doc})
+            .execute()
+        ;
+    app->closeDocument(doc);
+    if (!okExport)
+        throw std::runtime_error(fmt::format("Can't write STEP file '{}'", filepath.u8string()));
+
+    return { filepath, IO::Format_STEP, 0, instanceCount };
+}
+
+GeneratedInput generateColladaInstances(
+        const FilePath& filepath,
+        int partCount,
+        int instanceCount,
+        uint64_t trianglesPerPart
+    )
+{
+    const HeightField field(trianglesPerPart);
+    OutputFile file(filepath);
+    fmt::format_to(
+        std::back_inserter(file.buffer()),
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">\n"
+        "<asset><unit name=\"meter\" meter=\"1\"/><up_axis>Z_UP</up_axis></asset>\n"
+        "<library_geometries>\n"
+    );
+    for (int i = 0; i < instanceCount; ++i) {
+        // Parts differ by the amplitude of their height field
+        const int part = i % partCount;
+        const float zScale = 1.f + part * 0.25f;
+        auto out = std::back_inserter(file.buffer());
+        fmt::format_to(
+            out,
+            "<geometry id=\"mesh_{0}\"><mesh>\n"
+            "<source id=\"mesh_{0}_pos\"><float_array id=\"mesh_{0}_pos_array\" count=\"{1}\">",
+            i, 3 * field.vertexCount()
+        );
+        for (int v = 0; v < field.vertexCount(); ++v) {
+            const std::array<float, 3> pnt = field.vertex(v);
+            fmt::format_to(std::back_inserter(file.buffer()), "{} {} {} ", pnt[0], pnt[1], pnt[2] * zScale);
+        }
+
+        fmt::format_to(
+            std::back_inserter(file.buffer()),
+            "</float_array>\n"
+            "<technique_common><accessor source=\"#mesh_{0}_pos_array\" count=\"{1}\" stride=\"3\">"
+            "<param name=\"X\" type=\"float\"/><param name=\"Y\" type=\"float\"/><param name=\"Z\" type=\"float\"/>"
+            "</accessor></technique_common></source>\n"
+            "<vertices id=\"mesh_{0}_vtx\"><input semantic=\"POSITION\" source=\"#mesh_{0}_pos\"/></vertices>\n"
+            "<triangles count=\"{2}\"><input semantic=\"VERTEX\" source=\"#mesh_{0}_vtx\" offset=\"0\"/><p>",
+            i, field.vertexCount(), field.triangleCount()
+        );
+        field.forEachTriangle([&](int v0, int v1, int v2) {
+            fmt::format_to(std::back_inserter(file.buffer()), "{} {} {} ", v0, v1, v2);
+        });
+        fmt::format_to(std::back_inserter(file.buffer()), "</p></triangles>\n</mesh></geometry>\n");
+    }
+
+    fmt::format_to(
+        std::back_inserter(file.buffer()),
+        "</library_geometries>\n"
+        "<library_visual_scenes><visual_scene id=\"scene\" name=\"mayo_bench_instances\">\n"
+    );
+    const float spacing = field.vertex(field.vertexCount() - 1)[0] + 2.f;
+    for (int i = 0; i < instanceCount; ++i) {
+        fmt::format_to(
+            std::back_inserter(file.buffer()),
+            "<node id=\"node_{0}\" name=\"part_{1}\"><translate>{2} {3} 0</translate>"
+            "<instance_geometry url=\"#mesh_{0}\"/></node>\n",
+            i, i % partCount, (i % 100) * spacing, (i / 100) * spacing
+        );
+    }
+
+    fmt::format_to(
+        std::back_inserter(file.buffer()),
+        "</visual_scene></library_visual_scenes>\n"
+        "<scene><instance_visual_scene url=\"#scene\"/></scene>\n"
+        "</COLLADA>\n"
+    );
+    return { filepath, IO::Format_COLLADA, field.triangleCount() * instanceCount, instanceCount };
+}
+
+} // namespace Mayo::Bench
@@ -0,0 +1,67 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "../src/base/application_ptr.h"
+#include "../src/base/filepath.h"
+#include "../src/base/io_format.h"
+
+#include <cstdint>
+
+namespace Mayo {
+
+namespace IO { class System; }
+
+namespace Bench {
+
+// Description of a synthetic input file created by one of the generate*() functions
+struct GeneratedInput {
+    FilePath filepath;
+    IO::Format format = IO::Format_Unknown;
+    uint64_t triangleCount = 0; // Count of mesh triangles, 0 if not applicable
+    int entityCount = 0; // Count of DXF entities or STEP component instances, 0 if not applicable
+};
+
+// Generators are deterministic: same arguments produce byte-identical files, so results of
+// different runs(or versions) can be compared
+// Mesh generators write a triangulated height field of at least 'triangleCount' triangles(count is
+// rounded up to fit a square grid)
+// NOTE Binary formats are written in little-endian byte order, assumed to be the host byte order
+
+GeneratedInput generateStlBinary(const FilePath& filepath, uint64_t triangleCount);
+GeneratedInput generateStlAscii(const FilePath& filepath, uint64_t triangleCount);
+
+// Binary little-endian PLY with per-vertex colors
+GeneratedInput generatePlyColored(const FilePath& filepath, uint64_t triangleCount);
+
+GeneratedInput generateOff(const FilePath& filepath, uint64_t triangleCount);
+
+// DXF R12 file made of 'entityCount' entities(LINE, CIRCLE and 3DFACE)
+GeneratedInput generateDxf(const FilePath& filepath, int entityCount);
+
+// STEP assembly of 'instanceCount' component instances of 'partCount' distinct parts(boxes and
+// cylinders). The file is written with the STEP writer registered in 'ioSystem'
+GeneratedInput generateStepAssembly(
+        const IO::System& ioSystem,
+        const ApplicationPtr& app,
+        const FilePath& filepath,
+        int partCount,
+        int instanceCount
+);
+
+// COLLADA scene of 'instanceCount' nodes, each one having its own geometry(of at least
+// 'trianglesPerPart' triangles) that is a copy of one of 'partCount' distinct height fields. Copies
+// are written as separate geometries so assimp post-processing steps(vertex joining, instance
+// detection, graph optimization) have actual work to do
+GeneratedInput generateColladaInstances(
+        const FilePath& filepath,
+        int partCount,
+        int instanceCount,
+        uint64_t trianglesPerPart
+);
+
+} // namespace Bench
+} // namespace Mayo
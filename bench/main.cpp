@@ -0,0 +1,455 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+// mayo_bench: times the readers and writers of IO::System on large synthetic inputs
+//
+// Inputs are generated deterministically in the working directory(see --work-dir), results are
+// written in JSON format(see --output) so they can be compared between versions
+// Abort latency of the readers is also measured: time between the abort request of an import task
+// and its end(operation "abort" in results). With option --max-abort-latency the program exits with
+// failure code if a latency exceeds the bound
+// When the assimp plugin is available, a COLLADA scene is read once per assimp post-processing
+// profile(results "read_collada_<profile>") so load time and memory of the profiles can be compared
+
+#include "bench_inputs.h"
+
+#include "../src/base/application.h"
+#include "../src/base/document.h"
+#include "../src/base/filepath_conv.h"
+#include "../src/base/io_parameters_provider.h"
+#include "../src/base/io_performance_report.h"
+#include "../src/base/io_system.h"
+#include "../src/base/property_enumeration.h"
+#include "../src/base/task_manager.h"
+#include "../src/io_assimp/io_assimp.h"
+#include "../src/io_dxf/io_dxf.h"
+#include "../src/io_occ/io_occ.h"
+#include "../src/io_off/io_off_reader.h"
+#include "../src/io_off/io_off_writer.h"
+#include "../src/io_ply/io_ply_reader.h"
+#include "../src/io_ply/io_ply_writer.h"
+#include <common/mayo_version.h>
+
+#include <Standard_Version.hxx>
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Mayo::Bench {
+
+namespace {
+
+// Stores arguments(options) passed at command line
+struct CommandLineArguments {
+    FilePath workDirectory = "mayo_bench_inputs";
+    FilePath filepathOutput; // Empty: results are written to standard output
+    uint64_t triangleCount = 2'000'000;
+    int dxfEntityCount = 100'000;
+    int stepPartCount = 50;
+    int stepInstanceCount = 10'000;
+    int assimpPartCount = 20;
+    int assimpInstanceCount = 2'000;
+    int maxAbortLatency_ms = -1; // Negative: abort latency isn't checked
+    bool abortOnly = false;
+};
+
+void printUsage(std::ostream& ostr)
+{
+    ostr << "Usage: mayo_bench [options]\n"
+            "Options:\n"
+            "  --work-dir <dir>         Directory of generated inputs and written outputs(default: mayo_bench_inputs)\n"
+            "  --output <filepath>      Writes JSON results into file instead of standard output\n"
+            "  --triangles <count>      Triangle count of mesh inputs(default: 2000000)\n"
+            "  --dxf-entities <count>   Entity count of DXF input(default: 100000)\n"
+            "  --step-parts <count>     Count of distinct parts in STEP input(default: 50)\n"
+            "  --step-instances <count> Count of part instances in STEP input(default: 10000)\n"
+            "  --assimp-parts <count>   Count of distinct parts in COLLADA input(default: 20)\n"
+            "  --assimp-instances <count> Count of part instances in COLLADA input(default: 2000)\n"
+            "  --max-abort-latency <ms> Fails if abort latency of a reader exceeds this bound\n"
+            "  --abort-only             Measures only abort latency of readers\n"
+            "  --help                   Display this help\n";
+}
+
+CommandLineArguments processCommandLine(int argc, char* argv[])
+{
+    CommandLineArguments args;
+    auto fnValue = [&](int& i) -> std::string {
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for option " << argv[i] << "\n";
+            std::exit(EXIT_FAILURE);
+        }
+
+        return argv[++i];
+    };
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0) {
+            printUsage(std::cout);
+            std::exit(EXIT_SUCCESS);
+        }
+        else if (std::strcmp(arg, "--work-dir") == 0) {
+            args.workDirectory = filepathFrom(fnValue(i));
+        }
+        else if (std::strcmp(arg, "--output") == 0) {
+            args.filepathOutput = filepathFrom(fnValue(i));
+        }
+        else if (std::strcmp(arg, "--triangles") == 0) {
+            args.triangleCount = std::stoull(fnValue(i));
+        }
+        else if (std::strcmp(arg, "--dxf-entities") == 0) {
+            args.dxfEntityCount = std::stoi(fnValue(i));
+        }
+        else if (std::strcmp(arg, "--step-parts") == 0) {
+            args.stepPartCount = std::max(std::stoi(fnValue(i)), 1);
+        }
+        else if (std::strcmp(arg, "--step-instances") == 0) {
+            args.stepInstanceCount = std::stoi(fnValue(i));
+        }
+        else if (std::strcmp(arg, "--assimp-parts") == 0) {
+            args.assimpPartCount = std::max(std::stoi(fnValue(i)), 1);
+        }
+        else if (std::strcmp(arg, "--assimp-instances") == 0) {
+            args.assimpInstanceCount = std::stoi(fnValue(i));
+        }
+        else if (std::strcmp(arg, "--abort-only") == 0) {
+            args.abortOnly = true;
+        }
+        else if (std::strcmp(arg, "--max-abort-latency") == 0) {
+            args.maxAbortLatency_ms = std::max(std::stoi(fnValue(i)), 0);
+        }
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            printUsage(std::cerr);
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    return args;
+}
+
+// Result of a single benchmark case: read or write of a file through IO::System
+struct BenchResult {
+    std::string name;
+    std::string operation;
+    bool success = false;
+    IO::PerformanceReport::FileEntry entry;
+    double time_ms = 0.;
+    uint64_t triangleCount = 0;
+};
+
+std::string toJson(const BenchResult& result)
+{
+    const double time_s = result.time_ms / 1000.;
+    const double throughput_MBps = time_s > 0. ? (result.entry.fileSize / 1e6) / time_s : 0.;
+    const double trianglesPerSecond = time_s > 0. ? result.triangleCount / time_s : 0.;
+    const IO::PerformanceReport::FileEntry& entry = result.entry;
+    return fmt::format(
+        "{{\"name\": \"{}\", \"operation\": \"{}\", \"format\": \"{}\", \"success\": {}, "
+        "\"fileSize\": {}, \"time_ms\": {:.3f}, "
+        "\"stages_ms\": {{\"probe\": {:.3f}, \"read\": {:.3f}, \"transfer\": {:.3f}, \"write\": {:.3f}}}, "
+        "\"throughput_MBps\": {:.3f}, \"triangleCount\": {}, \"trianglesPerSecond\": {:.0f}, "
+        "\"entityCount\": {}, \"faceCount\": {}, \"peakMemoryDelta\": {}}}",
+        result.name, result.operation, IO::formatIdentifier(entry.format), result.success ? "true" : "false",
+        entry.fileSize, result.time_ms,
+        entry.probeTime_ms, entry.readTime_ms, entry.transferTime_ms, entry.writeTime_ms,
+        throughput_MBps, result.triangleCount, trianglesPerSecond,
+        entry.entityCount, entry.faceCount, entry.peakMemoryDelta
+    );
+}
+
+std::string toLowerCase(std::string_view str)
+{
+    std::string strLower(str);
+    for (char& c : strLower)
+        c = char(std::tolower(static_cast<unsigned char>(c)));
+
+    return strLower;
+}
+
+// Provides the parameters of a single reader format, null for other formats
+class ReaderParametersProvider : public IO::ParametersProvider {
+public:
+    ReaderParametersProvider(IO::Format format, const PropertyGroup* parameters)
+        : m_format(format), m_parameters(parameters)
+    {}
+
+    const PropertyGroup* findReaderParameters(IO::Format format) const override {
+        return format == m_format ? m_parameters : nullptr;
+    }
+
+    const PropertyGroup* findWriterParameters(IO::Format) const override {
+        return nullptr;
+    }
+
+private:
+    IO::Format m_format = IO::Format_Unknown;
+    const PropertyGroup* m_parameters = nullptr;
+};
+
+class Benchmark {
+public:
+    explicit Benchmark(const CommandLineArguments& args)
+        : m_args(args), m_app(makeOccHandle<Application>())
+    {
+        m_ioSystem.addFactoryReader(std::make_unique<IO::DxfFactoryReader>());
+        m_ioSystem.addFactoryReader(std::make_unique<IO::OccFactoryReader>());
+        m_ioSystem.addFactoryReader(std::make_unique<IO::OffFactoryReader>());
+        m_ioSystem.addFactoryReader(std::make_unique<IO::PlyFactoryReader>());
+        m_ioSystem.addFactoryReader(IO::AssimpFactoryReader::create());
+
+        m_ioSystem.addFactoryWriter(std::make_unique<IO::OccFactoryWriter>());
+        m_ioSystem.addFactoryWriter(std::make_unique<IO::OffFactoryWriter>());
+        m_ioSystem.addFactoryWriter(std::make_unique<IO::PlyFactoryWriter>());
+
+        IO::addPredefinedFormatProbes(&m_ioSystem);
+    }
+
+    void run()
+    {
+        std_filesystem::create_directories(m_args.workDirectory);
+        auto fnWorkFile = [=](const char* filename) { return m_args.workDirectory / filename; };
+
+        std::cerr << "Generating inputs in " << m_args.workDirectory.u8string() << "\n";
+        const GeneratedInput stlBinary = generateStlBinary(fnWorkFile("mesh_binary.stl"), m_args.triangleCount);
+        const GeneratedInput stlAscii = generateStlAscii(fnWorkFile("mesh_ascii.stl"), m_args.triangleCount);
+        const GeneratedInput plyColored = generatePlyColored(fnWorkFile("mesh_colored.ply"), m_args.triangleCount);
+        const GeneratedInput off = generateOff(fnWorkFile("mesh.off"), m_args.triangleCount);
+        const GeneratedInput dxf = generateDxf(fnWorkFile("entities.dxf"), m_args.dxfEntityCount);
+        const GeneratedInput step = generateStepAssembly(
+            m_ioSystem, m_app, fnWorkFile("assembly.step"), m_args.stepPartCount, m_args.stepInstanceCount
+        );
+
+        // Abort latency of readers
+        this->benchAbort("abort_stl_binary", stlBinary);
+        this->benchAbort("abort_stl_ascii", stlAscii);
+        this->benchAbort("abort_ply_colored", plyColored);
+        this->benchAbort("abort_off", off);
+        this->benchAbort("abort_dxf", dxf);
+        this->benchAbort("abort_step_assembly", step);
+        if (m_args.abortOnly)
+            return;
+
+        // Readers
+        const DocumentPtr meshDoc = this->benchRead("read_stl_binary", stlBinary);
+        m_app->closeDocument(this->benchRead("read_stl_ascii", stlAscii));
+        m_app->closeDocument(this->benchRead("read_ply_colored", plyColored));
+        m_app->closeDocument(this->benchRead("read_off", off));
+        m_app->closeDocument(this->benchRead("read_dxf", dxf));
+        const DocumentPtr stepDoc = this->benchRead("read_step_assembly", step);
+
+        // Writers, items being the ones previously read
+        const uint64_t meshTriangleCount = stlBinary.triangleCount;
+        this->benchWrite("write_stl_binary", meshDoc, fnWorkFile("out_binary.stl"), IO::Format_STL, meshTriangleCount);
+        this->benchWrite("write_stl_ascii", meshDoc, fnWorkFile("out_ascii.stl"), IO::Format_STL, meshTriangleCount, "Ascii");
+        this->benchWrite("write_ply", meshDoc, fnWorkFile("out.ply"), IO::Format_PLY, meshTriangleCount);
+        this->benchWrite("write_off", meshDoc, fnWorkFile("out.off"), IO::Format_OFF, meshTriangleCount);
+        this->benchWrite("write_step_assembly", stepDoc, fnWorkFile("out_assembly.step"), IO::Format_STEP, 0);
+        m_app->closeDocument(meshDoc);
+        m_app->closeDocument(stepDoc);
+
+        // Post-processing profiles of the assimp reader
+        if (m_ioSystem.findFactoryReader(IO::Format_COLLADA)) {
+            const GeneratedInput collada = generateColladaInstances(
+                fnWorkFile("instances.dae"), m_args.assimpPartCount, m_args.assimpInstanceCount, 512
+            );
+            for (const char* profile : { "Default", "Fast", "Instanced", "Compact" }) {
+                const std::string name = "read_collada_" + toLowerCase(profile);
+                m_app->closeDocument(this->benchRead(name.c_str(), collada, profile));
+            }
+        }
+    }
+
+    // Whether an abort latency exceeds the bound given with --max-abort-latency
+    bool abortLatencyExceeded() const
+    {
+        return std::any_of(m_vecResult.cbegin(), m_vecResult.cend(), [](const BenchResult& result) {
+            return result.operation == "abort" && !result.success;
+        });
+    }
+
+    std::string resultsJson() const
+    {
+        std::string json = "{\n";
+        json += fmt::format("  \"mayoVersion\": \"{}\",\n", strVersion);
+        json += fmt::format("  \"occVersion\": \"{}\",\n", OCC_VERSION_COMPLETE);
+        json += fmt::format("  \"processPeakMemory\": {},\n", IO::PerformanceReport::processPeakMemory());
+        json += "  \"results\": [";
+        for (const BenchResult& result : m_vecResult) {
+            json += &result != &m_vecResult.front() ? ",\n    " : "\n    ";
+            json += toJson(result);
+        }
+
+        json += "\n  ]\n}\n";
+        return json;
+    }
+
+private:
+    DocumentPtr benchRead(const char* name, const GeneratedInput& input, const char* assimpProfile = nullptr)
+    {
+        std::cerr << "Running " << name << "\n";
+        std::unique_ptr<PropertyGroup> parameters;
+        if (assimpProfile) {
+            parameters = m_ioSystem.findFactoryReader(input.format)->createProperties(input.format, nullptr);
+            for (Property* property : parameters->properties()) {
+                auto propEnum = dynamic_cast<PropertyEnumeration*>(property);
+                if (propEnum && property->name().key == "postProcessProfile")
+                    propEnum->setValueByName(assimpProfile);
+            }
+        }
+
+        const ReaderParametersProvider parametersProvider(input.format, parameters.get());
+        DocumentPtr doc = m_app->newDocument();
+        IO::PerformanceReport report;
+        BenchResult result;
+        result.name = name;
+        result.operation = "read";
+        result.success = m_ioSystem.importInDocument()
+                .targetDocument(doc)
+                .withFilepath(input.filepath)
+                .withParametersProvider(&parametersProvider)
+                .withPerformanceReport(&report)
+                .execute()
+            ;
+        if (!report.files.empty())
+            result.entry = report.files.front();
+
+        result.time_ms = report.totalTime_ms;
+        result.triangleCount = std::max(result.entry.triangleCount, input.triangleCount);
+        m_vecResult.push_back(result);
+        return doc;
+    }
+
+    // Measures the time between the abort request of an import task and its end
+    void benchAbort(const char* name, const GeneratedInput& input)
+    {
+        std::cerr << "Running " << name << "\n";
+        // Abort is requested once the reader made some progress or after a short delay(some
+        // readers report progress only at transfer stage)
+        TaskManager taskMgr;
+        const DocumentPtr doc = m_app->newDocument();
+        const TaskId taskId = taskMgr.newTask([&](TaskProgress* progress) {
+            m_ioSystem.importInDocument()
+                    .targetDocument(doc)
+                    .withFilepath(input.filepath)
+                    .withTaskProgress(progress)
+                    .execute()
+                ;
+        });
+        using Clock = std::chrono::steady_clock;
+        const auto timeStart = Clock::now();
+        taskMgr.run(taskId, TaskAutoDestroy::Off);
+        while (taskMgr.progress(taskId) <= 0. && (Clock::now() - timeStart) < std::chrono::milliseconds(100))
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        const auto timeAbort = Clock::now();
+        taskMgr.requestAbort(taskId);
+        taskMgr.waitForDone(taskId);
+        BenchResult result;
+        result.name = name;
+        result.operation = "abort";
+        result.entry.format = input.format;
+        result.time_ms = std::chrono::duration<double, std::milli>(Clock::now() - timeAbort).count();
+        result.success = m_args.maxAbortLatency_ms < 0 || result.time_ms <= m_args.maxAbortLatency_ms;
+        if (!result.success) {
+            std::cerr << fmt::format(
+                "Abort latency of {} is {:.0f}ms, exceeds {}ms\n", name, result.time_ms, m_args.maxAbortLatency_ms
+            );
+        }
+
+        m_vecResult.push_back(result);
+        m_app->closeDocument(doc);
+    }
+
+    void benchWrite(
+            const char* name,
+            const DocumentPtr& doc,
+            const FilePath& filepath,
+            IO::Format format,
+            uint64_t triangleCount,
+            const char* stlFormat = nullptr
+        )
+    {
+        std::cerr << "Running " << name << "\n";
+        std::unique_ptr<PropertyGroup> parameters;
+        if (stlFormat) {
+            parameters = m_ioSystem.findFactoryWriter(format)->createProperties(format, nullptr);
+            for (Property* property : parameters->properties()) {
+                auto propEnum = dynamic_cast<PropertyEnumeration*>(property);
+                if (propEnum && property->name().key == "targetFormat")
+                    propEnum->setValueByName(stlFormat);
+            }
+        }
+
+        IO::PerformanceReport report;
+        BenchResult result;
+        result.name = name;
+        result.operation = "write";
+        result.success = m_ioSystem.exportApplicationItems()
+                .targetFile(filepath)
+                .targetFormat(format)
+                .withItem(ApplicationItem{doc})
+                .withParameters(parameters.get())
+                .withPerformanceReport(&report)
+                .execute()
+            ;
+        if (!report.files.empty())
+            result.entry = report.files.front();
+
+        result.time_ms = report.totalTime_ms;
+        result.triangleCount = triangleCount;
+        m_vecResult.push_back(result);
+    }
+
+    CommandLineArguments m_args;
+    ApplicationPtr m_app;
+    IO::System m_ioSystem;
+    std::vector<BenchResult> m_vecResult;
+};
+
+} // namespace
+
+} // namespace Mayo::Bench
+
+int main(int argc, char* argv[])
+{
+    using namespace Mayo;
+    const Bench::CommandLineArguments args = Bench::processCommandLine(argc, argv);
+    try {
+        Bench::Benchmark benchmark(args);
+        benchmark.run();
+        const std::string json = benchmark.resultsJson();
+        if (args.filepathOutput.empty()) {
+            std::cout << json;
+        }
+        else {
+            std::ofstream fstr(args.filepathOutput);
+            fstr << json;
+            if (!fstr.good()) {
+                std::cerr << "Failed to write " << args.filepathOutput.u8string() << "\n";
+                return EXIT_FAILURE;
+            }
+        }
+
+        if (benchmark.abortLatencyExceeded())
+            return EXIT_FAILURE;
+    } catch (const std::exception& err) {
+        std::cerr << "Error: " << err.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -19,7 +19,6 @@
 #include <cassert>
 #include <fmt/format.h>
 #include <QtCore/QtDebug>
-#include <QtCore/QElapsedTimer>
 #include <QtCore/QMimeData>
 #include <QtGui/QDragEnterEvent>
 #include <QtGui/QDropEvent>
@@ -181,8 +180,7 @@ void FileCommandTools::openDocumentsFromList(IAppContext* context, gsl::span<con
             // task creation, so the document won't be destroyed
             const Document::Identifier newDocId = docPtr->identifier();
             const TaskId taskId = context->taskMgr()->newTask([=](TaskProgress* progress) {
-                QElapsedTimer chrono;
-                chrono.start();
+                IO::PerformanceReport report;
                 const bool okImport =
                     appModule->ioSystem()->importInDocument()
                         .targetDocument(app->findDocumentByIdentifier(newDocId))
@@ -195,9 +193,10 @@ void FileCommandTools::openDocumentsFromList(IAppContext* context, gsl::span<con
                         .withEntityPostProcessInfoProgress(20, Command::textIdTr("Mesh BRep shapes"))
                         .withMessenger(appModule)
                         .withTaskProgress(progress)
+                        .withPerformanceReport(&report)
                     .execute();
                 if (okImport)
-                    appModule->emitInfo(fmt::format(Command::textIdTr("Import time: {}ms"), chrono.elapsed()));
+                    appModule->emitInfo(fmt::format(Command::textIdTr("Import report:\n{}"), report.toText()));
             });
             context->taskMgr()->setTitle(taskId, fp.stem().u8string());
             context->taskMgr()->run(taskId);
@@ -236,9 +235,7 @@ void FileCommandTools::importInDocument(
     std::copy(listFilePaths.begin(), listFilePaths.end(), arrayFilePaths.begin());
 
     const TaskId taskId = context->taskMgr()->newTask([=](TaskProgress* progress) {
-        QElapsedTimer chrono;
-        chrono.start();
-
+        IO::PerformanceReport report;
         auto appModule = AppModule::get();
         auto doc = appModule->application()->findDocumentByIdentifier(targetDocId);
         const bool okImport =
@@ -251,11 +248,14 @@ void FileCommandTools::importInDocument(
                 })
                 .withEntityPostProcessRequiredIf(&IO::formatProvidesBRep)
                 .withEntityPostProcessInfoProgress(20, Command::textIdTr("Mesh BRep shapes"))
+                .withTransferInScratchDocuments(true)
+                .withProductDeduplication(true)
                 .withMessenger(appModule)
                 .withTaskProgress(progress)
+                .withPerformanceReport(&report)
             .execute();
         if (okImport)
-            appModule->emitInfo(fmt::format(Command::textIdTr("Import time: {}ms"), chrono.elapsed()));
+            appModule->emitInfo(fmt::format(Command::textIdTr("Import report:\n{}"), report.toText()));
     });
     const QString taskTitle =
         listFilePaths.size() > 1 ?
@@ -449,8 +449,7 @@ void CommandExportSelectedApplicationItems::execute()
     //     See issue https://github.com/fougue/mayo/issues/357
     const IO::Format format = appModule->ioSystem()->probeFormat(filepathFrom(strFilepath));
     const TaskId taskId = this->taskMgr()->newTask([=](TaskProgress* progress) {
-        QElapsedTimer chrono;
-        chrono.start();
+        IO::PerformanceReport report;
         const bool okExport =
             appModule->ioSystem()->exportApplicationItems()
                 .targetFile(filepathFrom(strFilepath))
@@ -459,9 +458,10 @@ void CommandExportSelectedApplicationItems::execute()
                 .withParameters(appModule->findWriterParameters(format))
                 .withMessenger(appModule)
                 .withTaskProgress(progress)
+                .withPerformanceReport(&report)
             .execute();
         if (okExport)
-            appModule->emitInfo(fmt::format(Command::textIdTr("Export time: {}ms"), chrono.elapsed()));
+            appModule->emitInfo(fmt::format(Command::textIdTr("Export report:\n{}"), report.toText()));
     });
     this->taskMgr()->setTitle(taskId, to_stdString(QFileInfo(strFilepath).fileName()));
     this->taskMgr()->run(taskId);
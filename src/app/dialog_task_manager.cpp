@@ -6,6 +6,7 @@
 #include "dialog_task_manager.h"
 
 #include "../base/task_manager.h"
+#include "../base/task_progress_dispatcher.h"
 #include "../base/math_utils.h"
 #include "../qtcommon/qstring_conv.h"
 #include "ui_dialog_task_manager.h"
@@ -105,7 +106,9 @@ void DialogTaskManager::TaskWidget::onUnboundedProgressTimeout()
 // -- DialogTaskManager
 // --
 
-DialogTaskManager::DialogTaskManager(TaskManager* taskMgr, QWidget* parent)
+DialogTaskManager::DialogTaskManager(
+        TaskManager* taskMgr, TaskProgressDispatcher* progressDispatcher, QWidget* parent
+    )
     : QDialog(parent),
       m_ui(new Ui_DialogTaskManager),
       m_taskMgr(taskMgr)
@@ -116,7 +119,7 @@ DialogTaskManager::DialogTaskManager(TaskManager* taskMgr, QWidget* parent)
 
     taskMgr->signalStarted.connectSlot(&DialogTaskManager::onTaskStarted, this);
     taskMgr->signalEnded.connectSlot(&DialogTaskManager::onTaskEnded, this);
-    taskMgr->signalProgressChanged.connectSlot(&DialogTaskManager::onTaskProgress, this);
+    progressDispatcher->signalProgressChanged.connectSlot(&DialogTaskManager::onTaskProgress, this);
     taskMgr->signalProgressStep.connectSlot(&DialogTaskManager::onTaskProgressStep, this);
 }
 
@@ -13,11 +13,16 @@
 namespace Mayo {
 
 class TaskManager;
+class TaskProgressDispatcher;
 
+// Shows the running tasks of a TaskManager object
+// Progress updates are received from 'progressDispatcher', which must be bound to 'taskMgr'
 class DialogTaskManager : public QDialog {
     Q_OBJECT
 public:
-    DialogTaskManager(TaskManager* taskMgr, QWidget* parent = nullptr);
+    DialogTaskManager(
+            TaskManager* taskMgr, TaskProgressDispatcher* progressDispatcher, QWidget* parent = nullptr
+    );
     ~DialogTaskManager();
 
 private:
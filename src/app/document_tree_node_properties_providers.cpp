@@ -9,6 +9,7 @@
 #include "../base/document.h"
 #include "../base/document_tree_node.h"
 #include "../base/label_data.h"
+#include "../base/libtree_parallel.h"
 #include "../base/mesh_access.h"
 #include "../base/mesh_utils.h"
 #include "../base/meta_enum.h"
@@ -20,12 +21,20 @@
 #include "../graphics/graphics_point_cloud_object_driver.h"
 #include "../graphics/graphics_shape_object_driver.h"
 
+#include <BRepGProp.hxx>
+#include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
+#include <GProp_GProps.hxx>
+#include <Standard_Failure.hxx>
 #include <TDataStd_Name.hxx>
+#include <TopoDS.hxx>
 
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include <mutex>
+#include <unordered_map>
+
 namespace Mayo {
 
 // NOTE
@@ -35,11 +44,89 @@ static constexpr uint64_t XCafSubGroup_Core = GeneralCoreSubGroup;
 static constexpr uint64_t XCafSubGroup_Validation = 2;
 static constexpr uint64_t XCafSubGroup_MetaData = 3;
 static constexpr uint64_t XCafSubGroup_ProductMetaData = 4;
+static constexpr uint64_t XCafSubGroup_MassProperties = 5;
+
+namespace {
+
+struct MassProperties {
+    double area = 0.;
+    double volume = 0.;
+};
+
+// Mass properties of a part, computed from its triangulation if it's a mesh
+MassProperties partMassProperties(const TDF_Label& partLabel)
+{
+    const TopoDS_Shape shape = XCaf::shape(partLabel);
+    const LabelDataFlags flags = findLabelDataFlags(partLabel);
+    if ((flags & LabelData_ShapeIsFace) && !(flags & LabelData_ShapeIsGeometricFace)) {
+        TopLoc_Location loc;
+        const OccHandle<Poly_Triangulation>& mesh = BRep_Tool::Triangulation(TopoDS::Face(shape), loc);
+        return { MeshUtils::triangulationArea(mesh), MeshUtils::triangulationVolume(mesh) };
+    }
+
+    GProp_GProps surfaceProps;
+    BRepGProp::SurfaceProperties(shape, surfaceProps);
+    GProp_GProps volumeProps;
+    BRepGProp::VolumeProperties(shape, volumeProps);
+    return { surfaceProps.Mass(), volumeProps.Mass() };
+}
+
+// Sums the mass properties of the parts(ie leaf nodes) below 'treeNode'
+// Instances of a product share the same shape, so each product is computed once. Locations are
+// assumed to be rigid transformations, leaving area and volume unchanged
+MassProperties assemblyMassProperties(const DocumentTreeNode& treeNode, TaskExecutor* executor)
+{
+    const Tree<TDF_Label>& modelTree = treeNode.document()->modelTree();
+    std::mutex mutexPart;
+    std::unordered_map<TDF_Label, MassProperties> mapPartMassProps;
+    auto fnNodeMassProperties = [&](TreeNodeId id) {
+        if (!modelTree.nodeIsLeaf(id))
+            return MassProperties{};
+
+        const TDF_Label& partLabel = modelTree.nodeData(id);
+        {
+            std::lock_guard<std::mutex> lock(mutexPart);
+            auto it = mapPartMassProps.find(partLabel);
+            if (it != mapPartMassProps.cend())
+                return it->second;
+        }
+
+        // Computed out of the lock, another thread might compute the same part meanwhile
+        MassProperties partMassProps;
+        try {
+            partMassProps = partMassProperties(partLabel);
+        }
+        catch (const Standard_Failure&) {
+            // Callback of parallel traversal must not throw, part is just ignored
+        }
+
+        std::lock_guard<std::mutex> lock(mutexPart);
+        mapPartMassProps.insert({ partLabel, partMassProps });
+        return partMassProps;
+    };
+    auto fnSum = [](const MassProperties& lhs, const MassProperties& rhs) {
+        return MassProperties{ lhs.area + rhs.area, lhs.volume + rhs.volume };
+    };
+
+    if (executor) {
+        return traverseTree_parallelReduce(
+            treeNode.id(), modelTree, MassProperties{}, fnNodeMassProperties, fnSum, *executor
+        );
+    }
+
+    MassProperties massProps;
+    traverseTree_preOrder(treeNode.id(), modelTree, [&](TreeNodeId id) {
+        massProps = fnSum(massProps, fnNodeMassProperties(id));
+    });
+    return massProps;
+}
+
+} // namespace
 
 class XCaf_DocumentTreeNodePropertiesProvider::Properties : public PropertyGroup {
     MAYO_DECLARE_TEXT_ID_FUNCTIONS(Mayo::XCaf_DocumentTreeNodeProperties)
 public:
-    explicit Properties(const DocumentTreeNode& treeNode);
+    Properties(const DocumentTreeNode& treeNode, TaskExecutor* executor);
 
     void onPropertyChanged(Property* prop) override;
     void addUdas(
@@ -73,6 +160,9 @@ public:
     PropertyArea m_propertyProductValidationArea{ this, textId("ProductArea") };
     PropertyVolume m_propertyProductValidationVolume{ this, textId("ProductVolume") };
 
+    PropertyArea m_propertyAssemblyArea{ this, textId("AssemblyArea") };
+    PropertyVolume m_propertyAssemblyVolume{ this, textId("AssemblyVolume") };
+
     std::vector<std::unique_ptr<Property>> m_vecPropertyUda;
     std::vector<std::unique_ptr<Property>> m_vecPropertyProductUda;
     std::vector<std::string> m_textIdStringStorage;
@@ -81,7 +171,9 @@ public:
     TDF_Label m_labelProduct;
 };
 
-XCaf_DocumentTreeNodePropertiesProvider::Properties::Properties(const DocumentTreeNode& treeNode)
+XCaf_DocumentTreeNodePropertiesProvider::Properties::Properties(
+        const DocumentTreeNode& treeNode, TaskExecutor* executor
+    )
     : m_label(treeNode.label())
 {
     const XCaf& xcaf = treeNode.document()->xcaf();
@@ -110,6 +202,8 @@ XCaf_DocumentTreeNodePropertiesProvider::Properties::Properties(const DocumentTr
     m_propertyProductValidationArea.setUserData(XCafSubGroup_Validation);
     m_propertyProductValidationVolume.setUserData(XCafSubGroup_Validation);
     m_propertyProductName.setUserData(XCafSubGroup_Core);
+    m_propertyAssemblyArea.setUserData(XCafSubGroup_MassProperties);
+    m_propertyAssemblyVolume.setUserData(XCafSubGroup_MassProperties);
 
     // Name
     m_propertyName.setValue(to_stdString(CafUtils::labelAttrStdName(label)));
@@ -185,6 +279,16 @@ XCaf_DocumentTreeNodePropertiesProvider::Properties::Properties(const DocumentTr
             m_propertyProductColor.setValue(xcaf.shapeColor(m_labelProduct));
     }
 
+    // Mass properties of the parts below assembly node
+    const bool isAssemblyNode = !treeNode.isLeaf();
+    fnRemovePropertyIf(m_propertyAssemblyArea, !isAssemblyNode);
+    fnRemovePropertyIf(m_propertyAssemblyVolume, !isAssemblyNode);
+    if (isAssemblyNode) {
+        const MassProperties massProps = assemblyMassProperties(treeNode, executor);
+        m_propertyAssemblyArea.setQuantity(massProps.area * Quantity_SquareMillimeter);
+        m_propertyAssemblyVolume.setQuantity(massProps.volume * Quantity_CubicMillimeter);
+    }
+
     // User-defined attributes
     OccHandle<TDataStd_NamedData> data = xcaf.shapeUserDefinedAttributes(label);
     OccHandle<TDataStd_NamedData> productData = xcaf.shapeUserDefinedAttributes(m_labelProduct);
@@ -339,6 +443,11 @@ std::string XCaf_DocumentTreeNodePropertiesProvider::Properties::strShapeLayers(
     return fmt::format("{}", fmt::join(listLayerName, ", "));
 }
 
+XCaf_DocumentTreeNodePropertiesProvider::XCaf_DocumentTreeNodePropertiesProvider(TaskExecutor* executor)
+    : m_executor(executor)
+{
+}
+
 bool XCaf_DocumentTreeNodePropertiesProvider::supports(const DocumentTreeNode& treeNode) const
 {
     return GraphicsShapeObjectDriver::shapeSupportStatus(treeNode.label()) == GraphicsObjectDriver::Support::Complete;
@@ -350,7 +459,7 @@ XCaf_DocumentTreeNodePropertiesProvider::properties(const DocumentTreeNode& tree
     if (!treeNode.isValid())
         return {};
 
-    return std::make_unique<Properties>(treeNode);
+    return std::make_unique<Properties>(treeNode, m_executor);
 }
 
 TextId XCaf_DocumentTreeNodePropertiesProvider::subGroupLabelFromId(uint64_t id) const
@@ -360,6 +469,7 @@ TextId XCaf_DocumentTreeNodePropertiesProvider::subGroupLabelFromId(uint64_t id)
     case XCafSubGroup_Validation: return Properties::textId("Validation");
     case XCafSubGroup_MetaData: return Properties::textId("MetaData");
     case XCafSubGroup_ProductMetaData: return Properties::textId("ProductMetaData");
+    case XCafSubGroup_MassProperties: return Properties::textId("MassProperties");
     }
     return {};
 }
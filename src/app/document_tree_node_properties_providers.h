@@ -13,6 +13,7 @@ namespace Mayo {
 
 class DocumentTreeNode;
 class PropertyGroup;
+class TaskExecutor;
 
 // Interface
 // Provides relevant properties for the data associated to a model tree node
@@ -27,12 +28,17 @@ public:
 // Provides relevant properties for tree node pointing to XCAF data
 class XCaf_DocumentTreeNodePropertiesProvider : public DocumentTreeNodePropertiesProvider {
 public:
+    // Mass properties of assembly nodes are computed concurrently by the threads of 'executor'
+    // Computation is sequential if 'executor' is null
+    explicit XCaf_DocumentTreeNodePropertiesProvider(TaskExecutor* executor = nullptr);
+
     bool supports(const DocumentTreeNode& treeNode) const override;
     std::unique_ptr<PropertyGroup> properties(const DocumentTreeNode& treeNode) const override;
     TextId subGroupLabelFromId(uint64_t id) const override;
 
 private:
     class Properties;
+    TaskExecutor* m_executor = nullptr;
 };
 
 // Provides relevant properties for tree node pointing to mesh data
@@ -7,6 +7,7 @@
 #include "../base/io_system.h"
 #include "../base/settings.h"
 #include "../base/tkernel_utils.h"
+#include "../base/tracing.h"
 #include "../io_assimp/io_assimp.h"
 #include "../io_dxf/io_dxf.h"
 #include "../io_gmio/io_gmio.h"
@@ -75,6 +76,7 @@ struct CommandLineArguments {
     QString themeName;
     FilePath filepathSettings;
     FilePath filepathLog;
+    FilePath filepathTrace;
     bool includeDebugLogs = true;
     std::vector<FilePath> listFilepathToOpen;
     bool showSystemInformation = false;
@@ -116,6 +118,13 @@ static CommandLineArguments processCommandLine()
     );
     cmdParser.addOption(cmdFileLog);
 
+    const QCommandLineOption cmdFileTrace(
+        QStringList{ "trace-file" },
+        Main::tr("Records profiling traces and writes them on exit into output file(Chrome trace-event JSON format)"),
+        Main::tr("filepath")
+    );
+    cmdParser.addOption(cmdFileTrace);
+
     const QCommandLineOption cmdDebugLogs(
         QStringList{ "debug-logs" },
         Main::tr("Don't filter out debug log messages in release build")
@@ -147,6 +156,9 @@ static CommandLineArguments processCommandLine()
     if (cmdParser.isSet(cmdFileLog))
         args.filepathLog = filepathFrom(cmdParser.value(cmdFileLog));
 
+    if (cmdParser.isSet(cmdFileTrace))
+        args.filepathTrace = filepathFrom(cmdParser.value(cmdFileTrace));
+
     for (const QString& posArg : cmdParser.positionalArguments())
         args.listFilepathToOpen.push_back(filepathFrom(posArg));
 
@@ -319,6 +331,16 @@ static int runApp(QCoreApplication* qtApp)
     LogMessageHandler::instance().enableDebugLogs(args.includeDebugLogs);
     LogMessageHandler::instance().setOutputFilePath(args.filepathLog);
 
+    // Profiling traces, written when application quits
+    Tracing::setEnabled(!args.filepathTrace.empty());
+    auto _ = gsl::finally([&]{
+        if (!args.filepathTrace.empty()) {
+            Tracing::setEnabled(false);
+            if (!Tracing::writeChromeTraceFile(args.filepathTrace))
+                qCritical().noquote() << Main::tr("Failed to write trace file [path=%1]").arg(filepathTo<QString>(args.filepathTrace));
+        }
+    });
+
     // Initialize AppModule
     auto appModule = AppModule::get();
     appModule->settings()->setStorage(std::make_unique<QSettingsStorage>());
@@ -356,7 +378,9 @@ static int runApp(QCoreApplication* qtApp)
     initGui(guiApp.get());
 
     // Register providers to query document tree node properties
-    appModule->addPropertiesProvider(std::make_unique<XCaf_DocumentTreeNodePropertiesProvider>());
+    appModule->addPropertiesProvider(
+        std::make_unique<XCaf_DocumentTreeNodePropertiesProvider>(&guiApp->taskExecutor())
+    );
     appModule->addPropertiesProvider(std::make_unique<Mesh_DocumentTreeNodePropertiesProvider>());
     appModule->addPropertiesProvider(std::make_unique<PointCloud_DocumentTreeNodePropertiesProvider>());
 
@@ -30,6 +30,7 @@
 #endif
 
 #include <QtDebug>
+#include <QtCore/QTimer>
 #include <QtGui/QFontMetrics>
 #include <QtWidgets/QDialogButtonBox>
 #include <QtWidgets/QLabel>
@@ -42,6 +43,15 @@ namespace Mayo {
 MainWindow::MainWindow(GuiApplication* guiApp, QWidget* parent)
     : QMainWindow(parent),
       m_guiApp(guiApp),
+      m_taskMgr(&guiApp->taskExecutor()),
+      m_taskProgressDispatcher(&m_taskMgr, [=]{
+          // Called from any thread, first get back to the thread of this object to start the timer
+          QTimer::singleShot(0, this, [=]{
+              QTimer::singleShot(TaskProgressDispatcher::FlushInterval_ms, this, [=]{
+                  m_taskProgressDispatcher.flush();
+              });
+          });
+      }),
       m_ui(new Ui_MainWindow)
 {
     m_ui->setupUi(this);
@@ -63,7 +73,7 @@ MainWindow::MainWindow(GuiApplication* guiApp, QWidget* parent)
     guiApp->signalGuiDocumentAdded.connectSlot(&MainWindow::onGuiDocumentAdded, this);
     guiApp->signalGuiDocumentErased.connectSlot(&MainWindow::onGuiDocumentErased, this);
 
-    new DialogTaskManager(&m_taskMgr, this);
+    new DialogTaskManager(&m_taskMgr, &m_taskProgressDispatcher, this);
 
     this->updateControlsActivation();
 }
@@ -80,7 +90,7 @@ void MainWindow::showEvent(QShowEvent* event)
     constexpr Qt::FindChildOption findMode = Qt::FindDirectChildrenOnly;
     auto winProgress = this->findChild<WinTaskbarGlobalProgress*>(QString{}, findMode);
     if (!winProgress)
-        winProgress = new WinTaskbarGlobalProgress(&m_taskMgr, this);
+        winProgress = new WinTaskbarGlobalProgress(&m_taskMgr, &m_taskProgressDispatcher, this);
 
     winProgress->setWindow(this->windowHandle());
 #endif
@@ -9,6 +9,7 @@
 #include "../base/filepath.h"
 #include "../base/messenger.h"
 #include "../base/task_manager.h"
+#include "../base/task_progress_dispatcher.h"
 #include "../base/text_id.h"
 
 #include <QtWidgets/QMainWindow>
@@ -86,6 +87,7 @@ private:
     GuiApplication* m_guiApp = nullptr;
     CommandContainer m_cmdContainer;
     TaskManager m_taskMgr;
+    TaskProgressDispatcher m_taskProgressDispatcher;
     class Ui_MainWindow* m_ui = nullptr;
     std::unordered_map<IAppContext::Page, IWidgetMainPage*> m_mapWidgetPage;
     std::vector<std::function<void()>> m_onCloseCallbacks;
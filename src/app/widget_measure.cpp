@@ -98,7 +98,7 @@ WidgetMeasure::WidgetMeasure(GuiDocument* guiDoc, QWidget* parent)
 WidgetMeasure::~WidgetMeasure()
 {
     m_connGraphicsSelectionChanged.disconnect();
-    m_connDocumentEntityAdded.disconnect();
+    m_connDocumentEntitiesAdded.disconnect();
     delete m_ui;
 }
 
@@ -111,8 +111,8 @@ void WidgetMeasure::setMeasureOn(bool on)
         m_connGraphicsSelectionChanged = gfxScene->signalSelectionChanged.connectSlot(
             &WidgetMeasure::onGraphicsSelectionChanged, this
         );
-        m_connDocumentEntityAdded = m_guiDoc->document()->signalEntityAdded.connectSlot(
-            &WidgetMeasure::onDocumentEntityAdded, this
+        m_connDocumentEntitiesAdded = m_guiDoc->document()->signalEntitiesAdded.connectSlot(
+            &WidgetMeasure::onDocumentEntitiesAdded, this
         );
     }
     else {
@@ -122,7 +122,7 @@ void WidgetMeasure::setMeasureOn(bool on)
         });
         gfxScene->clearSelection();
         m_connGraphicsSelectionChanged.disconnect();
-        m_connDocumentEntityAdded.disconnect();
+        m_connDocumentEntitiesAdded.disconnect();
     }
 }
 
@@ -379,7 +379,7 @@ void WidgetMeasure::onGraphicsSelectionChanged()
     this->updateMessagePanel();
 }
 
-void WidgetMeasure::onDocumentEntityAdded(TreeNodeId entityNodeId)
+void WidgetMeasure::onDocumentEntitiesAdded(gsl::span<const TreeNodeId> spanEntityNodeId)
 {
     if (!m_tool)
         return;
@@ -388,10 +388,12 @@ void WidgetMeasure::onDocumentEntityAdded(TreeNodeId entityNodeId)
     if (measureType == MeasureType::None)
         return;
 
-    m_guiDoc->foreachGraphicsObject(entityNodeId, [=](const GraphicsObjectPtr& gfxObject) {
-        for (GraphicsObjectSelectionMode mode : m_tool->selectionModes(measureType))
-            m_guiDoc->graphicsScene()->activateObjectSelection(gfxObject, mode);
-    });
+    for (TreeNodeId entityNodeId : spanEntityNodeId) {
+        m_guiDoc->foreachGraphicsObject(entityNodeId, [=](const GraphicsObjectPtr& gfxObject) {
+            for (GraphicsObjectSelectionMode mode : m_tool->selectionModes(measureType))
+                m_guiDoc->graphicsScene()->activateObjectSelection(gfxObject, mode);
+        });
+    }
 }
 
 void WidgetMeasure::updateMessagePanel()
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../base/fast_signal.h"
 #include "../base/signal.h"
 #include "../base/libtree.h"
 #include "../measure/measure_display.h"
@@ -46,7 +47,7 @@ private:
     MeasureDisplayConfig currentMeasureDisplayConfig() const;
 
     void onGraphicsSelectionChanged();
-    void onDocumentEntityAdded(TreeNodeId entityNodeId);
+    void onDocumentEntitiesAdded(gsl::span<const TreeNodeId> spanEntityNodeId);
 
     void updateMessagePanel();
 
@@ -70,8 +71,8 @@ private:
     std::vector<GraphicsOwner_MeasureDisplay> m_vecLinkGfxOwnerMeasure;
     IMeasureTool* m_tool = nullptr;
     QString m_errorMessage;
-    SignalConnectionHandle m_connGraphicsSelectionChanged;
-    SignalConnectionHandle m_connDocumentEntityAdded;
+    FastSignalConnection m_connGraphicsSelectionChanged;
+    SignalConnectionHandle m_connDocumentEntitiesAdded;
 };
 
 } // namespace Mayo
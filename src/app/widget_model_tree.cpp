@@ -71,7 +71,8 @@ namespace Mayo::Internal {
 enum TreeItemRole {
     TreeItemTypeRole = Qt::UserRole + 1,
     TreeItemDocumentRole,
-    TreeItemDocumentTreeNodeRole
+    TreeItemDocumentTreeNodeRole,
+    TreeItemChildrenPendingRole
 };
 
 enum TreeItemType {
@@ -170,6 +171,11 @@ WidgetModelTree::WidgetModelTree(QWidget* widget)
             }
     });
 
+    QObject::connect(
+        m_ui->treeWidget_Model, &QTreeWidget::itemExpanded,
+        this, &WidgetModelTree::loadTreeItemChildren
+    );
+
     this->connectTreeModelDataChanged(true);
 }
 
@@ -204,7 +210,7 @@ void WidgetModelTree::registerGuiApplication(GuiApplication* guiApp)
     app->signalDocumentAdded.connectSlot(&WidgetModelTree::onDocumentAdded, this);
     app->signalDocumentAboutToClose.connectSlot(&WidgetModelTree::onDocumentAboutToClose, this);
     app->signalDocumentNameChanged.connectSlot(&WidgetModelTree::onDocumentNameChanged, this);
-    app->signalDocumentEntityAdded.connectSlot(&WidgetModelTree::onDocumentEntityAdded, this);
+    app->signalDocumentEntitiesAdded.connectSlot(&WidgetModelTree::onDocumentEntitiesAdded, this);
     app->signalDocumentEntityAboutToBeDestroyed.connectSlot(&WidgetModelTree::onDocumentEntityAboutToBeDestroyed, this);
 
     m_guiApp->selectionModel()->signalChanged.connectSlot(&WidgetModelTree::onApplicationItemSelectionModelChanged, this);
@@ -267,6 +273,19 @@ bool WidgetModelTree::holdsDocumentTreeNode(const QTreeWidgetItem* treeItem)
     return Internal::treeItemType(treeItem) & Internal::TreeItemType_DocumentTreeNode;
 }
 
+void WidgetModelTree::setTreeItemChildrenPending(QTreeWidgetItem* treeItem, bool on)
+{
+    treeItem->setData(0, Internal::TreeItemChildrenPendingRole, on);
+    treeItem->setChildIndicatorPolicy(
+        on ? QTreeWidgetItem::ShowIndicator : QTreeWidgetItem::DontShowIndicatorWhenChildless
+    );
+}
+
+bool WidgetModelTree::isTreeItemChildrenPending(const QTreeWidgetItem* treeItem)
+{
+    return treeItem->data(0, Internal::TreeItemChildrenPendingRole).toBool();
+}
+
 void WidgetModelTree::onDocumentAdded(const DocumentPtr& doc)
 {
     auto treeItem = this->findSupportBuilder(doc)->createTreeItem(doc);
@@ -295,6 +314,77 @@ QTreeWidgetItem* WidgetModelTree::loadDocumentEntity(const DocumentTreeNode& nod
     return treeItem;
 }
 
+void WidgetModelTree::loadTreeItemChildren(QTreeWidgetItem* treeItem)
+{
+    if (!WidgetModelTree::isTreeItemChildrenPending(treeItem))
+        return;
+
+    // The builder of the owning entity is responsible of the whole entity sub-tree
+    const QTreeWidgetItem* treeItemEntity = treeItem;
+    while (treeItemEntity && Internal::treeItemType(treeItemEntity) != Internal::TreeItemType_DocumentEntity)
+        treeItemEntity = treeItemEntity->parent();
+
+    if (!treeItemEntity)
+        return;
+
+    this->connectTreeModelDataChanged(false);
+    auto _ = gsl::finally([=]{ this->connectTreeModelDataChanged(true); });
+    WidgetModelTree::setTreeItemChildrenPending(treeItem, false);
+    const DocumentTreeNode entityNode = Internal::treeItemDocumentTreeNode(treeItemEntity);
+    this->findSupportBuilder(entityNode)->loadTreeItemChildren(treeItem);
+
+    // Visible state of the nodes may have changed since the entity was loaded
+    const GuiDocument* guiDoc = m_guiApp ? m_guiApp->findGuiDocument(entityNode.document()) : nullptr;
+    if (!guiDoc)
+        return;
+
+    for (int i = 0; i < treeItem->childCount(); ++i) {
+        QTreeWidgetItem* childTreeItem = treeItem->child(i);
+        if (childTreeItem->flags().testFlag(Qt::ItemIsUserCheckable)) {
+            const DocumentTreeNode childNode = Internal::treeItemDocumentTreeNode(childTreeItem);
+            const CheckState state = guiDoc->nodeVisibleState(childNode.id());
+            childTreeItem->setCheckState(0, QtCoreUtils::toQtCheckState(state));
+        }
+    }
+}
+
+QTreeWidgetItem* WidgetModelTree::loadTreeItem(const DocumentTreeNode& node)
+{
+    if (!node.isValid())
+        return nullptr;
+
+    // Path in the model tree from the entity node(root) down to 'node'
+    const Tree<TDF_Label>& modelTree = node.document()->modelTree();
+    std::vector<TreeNodeId> vecPathNodeId;
+    for (TreeNodeId id = node.id(); id != 0; id = modelTree.nodeParent(id))
+        vecPathNodeId.push_back(id);
+
+    auto fnFindChildTreeItem = [](QTreeWidgetItem* parentTreeItem, TreeNodeId nodeId) -> QTreeWidgetItem* {
+        for (int i = 0; i < parentTreeItem->childCount(); ++i) {
+            QTreeWidgetItem* childTreeItem = parentTreeItem->child(i);
+            if (Internal::treeItemDocumentTreeNode(childTreeItem).id() == nodeId)
+                return childTreeItem;
+        }
+
+        return nullptr;
+    };
+
+    QTreeWidgetItem* treeItem = this->findTreeItem(node.document());
+    if (treeItem)
+        treeItem = fnFindChildTreeItem(treeItem, vecPathNodeId.back());
+
+    for (auto it = std::next(vecPathNodeId.crbegin()); treeItem && it != vecPathNodeId.crend(); ++it) {
+        this->loadTreeItemChildren(treeItem);
+        QTreeWidgetItem* childTreeItem = fnFindChildTreeItem(treeItem, *it);
+        // No child item means the node is displayed by 'treeItem' itself(eg XDE referred product
+        // merged with its reference), so just go on with next path node
+        if (childTreeItem)
+            treeItem = childTreeItem;
+    }
+
+    return treeItem && Internal::treeItemDocumentTreeNode(treeItem) == node ? treeItem : nullptr;
+}
+
 QTreeWidgetItem* WidgetModelTree::findTreeItem(const DocumentPtr& doc) const
 {
     for (int i = 0; i < m_ui->treeWidget_Model->topLevelItemCount(); ++i) {
@@ -340,14 +430,20 @@ WidgetModelTreeBuilder* WidgetModelTree::findSupportBuilder(const DocumentTreeNo
     return it != m_vecBuilder.cend() ? it->get() : m_vecBuilder.front().get();
 }
 
-void WidgetModelTree::onDocumentEntityAdded(const DocumentPtr& doc, TreeNodeId entityId)
+void WidgetModelTree::onDocumentEntitiesAdded(const DocumentPtr& doc, gsl::span<const TreeNodeId> spanEntityId)
 {
-    QTreeWidgetItem* treeDocEntity = this->loadDocumentEntity({ doc, entityId });
     QTreeWidgetItem* treeDoc = this->findTreeItem(doc);
-    if (treeDoc) {
-        treeDoc->addChild(treeDocEntity);
-        treeDoc->setExpanded(true);
-    }
+    if (!treeDoc)
+        return;
+
+    // Insert all the entity items as one block of rows
+    QList<QTreeWidgetItem*> listTreeDocEntity;
+    listTreeDocEntity.reserve(int(spanEntityId.size()));
+    for (TreeNodeId entityId : spanEntityId)
+        listTreeDocEntity.push_back(this->loadDocumentEntity({ doc, entityId }));
+
+    treeDoc->addChildren(listTreeDocEntity);
+    treeDoc->setExpanded(true);
 }
 
 void WidgetModelTree::onDocumentEntityAboutToBeDestroyed(const DocumentPtr& doc, TreeNodeId entityId)
@@ -387,23 +483,53 @@ void WidgetModelTree::onApplicationItemSelectionModelChanged(
     this->connectTreeWidgetDocumentSelectionChanged(false);
     auto _ = gsl::finally([=] { this->connectTreeWidgetDocumentSelectionChanged(true); });
 
-    auto fnSetSelected = [=](gsl::span<const ApplicationItem> spanAppItem, bool on) {
+    // For batches of items, tree items are indexed once instead of being searched for each
+    // application item(which would be quadratic)
+    const bool useTreeItemIndex = (selected.size() + deselected.size()) > 1;
+    std::unordered_map<ApplicationItem, QTreeWidgetItem*> mapAppItemTreeItem;
+    if (useTreeItemIndex) {
+        for (QTreeWidgetItemIterator it(m_ui->treeWidget_Model); *it; ++it) {
+            if (Internal::treeItemType(*it) & Internal::TreeItemType_DocumentTreeNode)
+                mapAppItemTreeItem.insert({ Internal::toApplicationItem(*it), *it });
+        }
+    }
+
+    auto fnFindTreeItem = [&](const ApplicationItem& appItem, bool loadIfMissing) -> QTreeWidgetItem* {
+        if (useTreeItemIndex) {
+            auto it = mapAppItemTreeItem.find(appItem);
+            if (it != mapAppItemTreeItem.cend())
+                return it->second;
+        }
+        else {
+            QTreeWidgetItem* treeItem = this->findTreeItem(appItem.documentTreeNode());
+            if (treeItem)
+                return treeItem;
+        }
+
+        // Tree items are created lazily, so the one of a selected node may not exist yet
+        return loadIfMissing ? this->loadTreeItem(appItem.documentTreeNode()) : nullptr;
+    };
+
+    QTreeWidgetItem* lastSelectedTreeItem = nullptr;
+    auto fnSetSelected = [&](gsl::span<const ApplicationItem> spanAppItem, bool on) {
         for (const ApplicationItem& appItem : spanAppItem) {
             if (!appItem.isDocumentTreeNode())
                 continue;
 
-            QTreeWidgetItem* treeItem = this->findTreeItem(appItem.documentTreeNode());
+            QTreeWidgetItem* treeItem = fnFindTreeItem(appItem, on);
             if (!treeItem)
                 continue;
 
             treeItem->setSelected(on);
             if (on)
-                m_ui->treeWidget_Model->scrollToItem(treeItem);
+                lastSelectedTreeItem = treeItem;
         }
     };
 
     fnSetSelected(selected, true);
     fnSetSelected(deselected, false);
+    if (lastSelectedTreeItem)
+        m_ui->treeWidget_Model->scrollToItem(lastSelectedTreeItem);
 }
 
 void WidgetModelTree::connectTreeModelDataChanged(bool on)
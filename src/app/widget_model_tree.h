@@ -52,11 +52,16 @@ public:
     static bool holdsDocument(const QTreeWidgetItem* treeItem);
     static bool holdsDocumentTreeNode(const QTreeWidgetItem* treeItem);
 
+    // Flags 'treeItem' so its child items get created only when it's expanded for the first time
+    // (see WidgetModelTreeBuilder::loadTreeItemChildren())
+    static void setTreeItemChildrenPending(QTreeWidgetItem* treeItem, bool on);
+    static bool isTreeItemChildrenPending(const QTreeWidgetItem* treeItem);
+
 private:
     void onDocumentAdded(const DocumentPtr& doc);
     void onDocumentAboutToClose(const DocumentPtr& doc);
     void onDocumentNameChanged(const DocumentPtr& doc, const std::string& name);
-    void onDocumentEntityAdded(const DocumentPtr& doc, TreeNodeId entityId);
+    void onDocumentEntitiesAdded(const DocumentPtr& doc, gsl::span<const TreeNodeId> spanEntityId);
     void onDocumentEntityAboutToBeDestroyed(const DocumentPtr& doc, TreeNodeId entityId);
 
     void onTreeWidgetDocumentSelectionChanged(
@@ -77,6 +82,8 @@ private:
     );
 
     QTreeWidgetItem* loadDocumentEntity(const DocumentTreeNode& entityNode);
+    void loadTreeItemChildren(QTreeWidgetItem* treeItem);
+    QTreeWidgetItem* loadTreeItem(const DocumentTreeNode& node);
 
     QTreeWidgetItem* findTreeItem(const DocumentPtr& doc) const;
     QTreeWidgetItem* findTreeItem(const DocumentTreeNode& node) const;
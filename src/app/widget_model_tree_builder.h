@@ -31,6 +31,11 @@ public:
     virtual QTreeWidgetItem* createTreeItem(const DocumentPtr& doc);
     virtual QTreeWidgetItem* createTreeItem(const DocumentTreeNode& node);
 
+    // Creates the child items of 'treeItem' previously flagged with
+    // WidgetModelTree::setTreeItemChildrenPending()
+    // Called at most once for a tree item, by default it does nothing
+    virtual void loadTreeItemChildren(QTreeWidgetItem* /*treeItem*/) {}
+
     QTreeWidget* treeWidget() const { return m_treeWidget; }
     void setTreeWidget(QTreeWidget* tree) { m_treeWidget = tree; }
 
@@ -22,8 +22,6 @@
 #include <QtWidgets/QTreeWidgetItemIterator>
 
 #include <fmt/format.h>
-#include <unordered_map>
-#include <unordered_set>
 
 namespace Mayo {
 
@@ -116,7 +114,8 @@ void WidgetModelTreeBuilder_Xde::refreshTextTreeItem(
 QTreeWidgetItem* WidgetModelTreeBuilder_Xde::createTreeItem(const DocumentTreeNode& node)
 {
     Expects(this->supportsDocumentTreeNode(node));
-    return this->buildXdeTree(nullptr, node);
+    Expects(node.isEntity());
+    return this->createXdeTreeItem(node);
 }
 
 WidgetModelTree_UserActions WidgetModelTreeBuilder_Xde::createUserActions(QObject *parent)
@@ -147,72 +146,64 @@ WidgetModelTree_UserActions WidgetModelTreeBuilder_Xde::createUserActions(QObjec
     return userActions;
 }
 
-QTreeWidgetItem* WidgetModelTreeBuilder_Xde::guiCreateXdeTreeNode(
-        QTreeWidgetItem* guiParentNode, const DocumentTreeNode& node
-    )
+void WidgetModelTreeBuilder_Xde::loadTreeItemChildren(QTreeWidgetItem* treeItem)
 {
-    auto guiNode = new QTreeWidgetItem(guiParentNode);
-    const QString stdName = to_QString(CafUtils::labelAttrStdName(node.label()));
-    guiNode->setText(0, stdName);
-    WidgetModelTree::setDocumentTreeNode(guiNode, node);
-    const QIcon icon = Module::shapeIcon(node.label());
-    if (!icon.isNull())
-        guiNode->setIcon(0, icon);
+    const DocumentTreeNode node = WidgetModelTree::documentTreeNode(treeItem);
+    if (!node.isValid())
+        return;
 
-    return guiNode;
+    const DocumentPtr doc = node.document();
+    const Tree<TDF_Label>& modelTree = doc->modelTree();
+    QList<QTreeWidgetItem*> listChildTreeItem;
+    visitDirectChildren(this->xdeContentsNode(modelTree, node.id()), modelTree, [&](TreeNodeId childId) {
+        listChildTreeItem.push_back(this->createXdeTreeItem({ doc, childId }));
+    });
+
+    // Insert all the child items as one block of rows
+    treeItem->addChildren(listChildTreeItem);
 }
 
-QTreeWidgetItem* WidgetModelTreeBuilder_Xde::buildXdeTree(
-        QTreeWidgetItem* treeItem, const DocumentTreeNode& node
-    )
+TreeNodeId WidgetModelTreeBuilder_Xde::xdeContentsNode(
+        const Tree<TDF_Label>& modelTree, TreeNodeId nodeId
+    ) const
 {
-    Expects(node.isEntity());
+    if (m_isMergeXdeReferredShapeOn && XCaf::isShapeReference(modelTree.nodeData(nodeId))) {
+        const TreeNodeId referredNodeId = modelTree.nodeChildFirst(nodeId);
+        if (referredNodeId != 0)
+            return referredNodeId;
+    }
 
-    std::unordered_map<TreeNodeId, QTreeWidgetItem*> mapNodeIdToTreeItem;
-    std::unordered_set<TreeNodeId> setReferenceNodeId;
-    const DocumentPtr doc = node.document();
-    const Tree<TDF_Label>& modelTree = doc->modelTree();
-    traverseTree(node.id(), modelTree, [&](TreeNodeId itNodeId) {
-        const TreeNodeId nodeParentId = modelTree.nodeParent(itNodeId);
-        auto itParentFound = mapNodeIdToTreeItem.find(nodeParentId);
-        QTreeWidgetItem* guiParentNode =
-                itParentFound != mapNodeIdToTreeItem.end() ? itParentFound->second : treeItem;
-        if (m_isMergeXdeReferredShapeOn) {
-            const TDF_Label& nodeLabel = modelTree.nodeData(itNodeId);
-            if (XCaf::isShapeReference(nodeLabel)) {
-                mapNodeIdToTreeItem[itNodeId] = guiParentNode;
-                setReferenceNodeId.insert(itNodeId);
-            }
-            else {
-                auto guiNode = new QTreeWidgetItem(guiParentNode);
-                QString guiNodeText = to_QString(CafUtils::labelAttrStdName(nodeLabel));
-                TreeNodeId guiNodeId = itNodeId;
-                if (setReferenceNodeId.find(nodeParentId) != setReferenceNodeId.cend()) {
-                    const TDF_Label& refLabel = modelTree.nodeData(nodeParentId);
-                    guiNodeText = this->referenceItemText(refLabel, nodeLabel);
-                    guiNodeId = nodeParentId;
-                    if (!guiParentNode)
-                        mapNodeIdToTreeItem[nodeParentId] = guiNode;
-                }
-
-                guiNode->setText(0, guiNodeText);
-                WidgetModelTree::setDocumentTreeNode(guiNode, DocumentTreeNode(doc, guiNodeId));
-                const QIcon icon = Module::shapeIcon(nodeLabel);
-                if (!icon.isNull())
-                    guiNode->setIcon(0, icon);
-
-                guiNode->setFlags(guiNode->flags() | Qt::ItemIsUserCheckable);
-                guiNode->setCheckState(0, Qt::Checked);
-                mapNodeIdToTreeItem[itNodeId] = guiNode;
-            }
-        }
-        else {
-            auto guiNode = ThisType::guiCreateXdeTreeNode(guiParentNode, { doc, itNodeId });
-            mapNodeIdToTreeItem[itNodeId] = guiNode;
-        }
-    });
+    return nodeId;
+}
+
+QTreeWidgetItem* WidgetModelTreeBuilder_Xde::createXdeTreeItem(const DocumentTreeNode& node) const
+{
+    const Tree<TDF_Label>& modelTree = node.document()->modelTree();
+    const TDF_Label& nodeLabel = node.label();
+    const TreeNodeId contentsNodeId = this->xdeContentsNode(modelTree, node.id());
+    const TDF_Label& contentsLabel = modelTree.nodeData(contentsNodeId);
+
+    auto treeItem = new QTreeWidgetItem;
+    if (contentsNodeId != node.id())
+        treeItem->setText(0, this->referenceItemText(nodeLabel, contentsLabel));
+    else
+        treeItem->setText(0, to_QString(CafUtils::labelAttrStdName(nodeLabel)));
+
+    WidgetModelTree::setDocumentTreeNode(treeItem, node);
+    const QIcon icon = Module::shapeIcon(contentsLabel);
+    if (!icon.isNull())
+        treeItem->setIcon(0, icon);
+
+    if (m_isMergeXdeReferredShapeOn) {
+        treeItem->setFlags(treeItem->flags() | Qt::ItemIsUserCheckable);
+        treeItem->setCheckState(0, Qt::Checked);
+    }
+
+    // Child items are created on demand, when the item gets expanded for the first time
+    if (!modelTree.nodeIsLeaf(contentsNodeId))
+        WidgetModelTree::setTreeItemChildrenPending(treeItem, true);
 
-    return mapNodeIdToTreeItem.find(node.id())->second;
+    return treeItem;
 }
 
 QByteArray WidgetModelTreeBuilder_Xde::instanceNameFormat() const
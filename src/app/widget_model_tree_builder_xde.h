@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../base/libtree.h"
 #include "widget_model_tree_builder.h"
 class TDF_Label;
 
@@ -16,6 +17,7 @@ public:
     bool supportsDocumentTreeNode(const DocumentTreeNode& node) const override;
     void refreshTextTreeItem(const DocumentTreeNode& node, QTreeWidgetItem* treeItem) override;
     QTreeWidgetItem* createTreeItem(const DocumentTreeNode& node) override;
+    void loadTreeItemChildren(QTreeWidgetItem* treeItem) override;
 
     WidgetModelTree_UserActions createUserActions(QObject* parent) override;
 
@@ -26,11 +28,12 @@ private:
 
     using ThisType = WidgetModelTreeBuilder_Xde;
 
-    static QTreeWidgetItem* guiCreateXdeTreeNode(
-        QTreeWidgetItem* guiParentNode, const DocumentTreeNode& node
-    );
+    // Returns the node whose children are displayed below the tree item of node 'nodeId'
+    // When XDE referred shapes are merged, a reference node and its referred product node are
+    // displayed as a single tree item, children being then the ones of the product node
+    TreeNodeId xdeContentsNode(const Tree<TDF_Label>& modelTree, TreeNodeId nodeId) const;
 
-    QTreeWidgetItem* buildXdeTree(QTreeWidgetItem* treeItem, const DocumentTreeNode& node);
+    QTreeWidgetItem* createXdeTreeItem(const DocumentTreeNode& node) const;
     void refreshXdeAssemblyNodeItemText(QTreeWidgetItem* item);
     QString referenceItemText(const TDF_Label& instanceLabel, const TDF_Label& productLabel) const;
     QTreeWidgetItem* findTreeItem(QTreeWidgetItem* parentTreeItem, const TDF_Label& label) const;
@@ -9,6 +9,7 @@
 #endif
 
 #include "../base/occ_handle.h"
+#include "../base/tracing.h"
 #include "../graphics/graphics_utils.h"
 #include "occt_window.h"
 #include "qtopengl_utils.h"
@@ -135,7 +136,10 @@ void QOpenGLWidgetOccView::paintGL()
     //Handle(V3d_View) aView = !myFocusView.IsNull() ? myFocusView : myView;
     //aView->InvalidateImmediate();
     //AIS_ViewController::FlushViewEvents(myContext, aView, true);
-    this->v3dView()->Redraw();
+    {
+        MAYO_TRACE_SCOPE("graphics", "V3d_View::Redraw");
+        this->v3dView()->Redraw();
+    }
 
     // Reset global GL state after OCCT before redrawing Qt
     QtOpenGlUtils::resetGlStateAfterOcct(this->v3dView());
@@ -166,6 +170,7 @@ OccHandle<Graphic3d_GraphicDriver> QWidgetOccView::createCompatibleGraphicsDrive
 
 void QWidgetOccView::redraw()
 {
+    MAYO_TRACE_SCOPE("graphics", "V3d_View::Redraw");
     this->v3dView()->Redraw();
 }
 
@@ -189,6 +194,7 @@ void QWidgetOccView::showEvent(QShowEvent*)
 
 void QWidgetOccView::paintEvent(QPaintEvent*)
 {
+    MAYO_TRACE_SCOPE("graphics", "V3d_View::Redraw");
     this->v3dView()->Redraw();
 }
 
@@ -7,6 +7,7 @@
 
 #include "../base/math_utils.h"
 #include "../base/task_manager.h"
+#include "../base/task_progress_dispatcher.h"
 
 #include <QtWinExtras/QWinTaskbarButton>
 #include <QtWinExtras/QWinTaskbarProgress>
@@ -14,12 +15,17 @@
 
 namespace Mayo {
 
-WinTaskbarGlobalProgress::WinTaskbarGlobalProgress(TaskManager* taskMgr, QObject* parent)
+WinTaskbarGlobalProgress::WinTaskbarGlobalProgress(
+        TaskManager* taskMgr, TaskProgressDispatcher* progressDispatcher, QObject* parent
+    )
     : QObject(parent),
       m_taskbarBtn(new QWinTaskbarButton(this))
 {
-    taskMgr->signalStarted.connectSlot([=](TaskId taskId) { this->onTaskProgress(taskId, 0.); });
-    taskMgr->signalProgressChanged.connectSlot(&WinTaskbarGlobalProgress::onTaskProgress, this);
+    taskMgr->signalStarted.connectSlot([=](TaskId taskId) {
+        m_mapTaskIdProgress.insert({ taskId, 0. });
+        this->updateTaskbar();
+    });
+    progressDispatcher->signalProgressChanged.connectSlot(&WinTaskbarGlobalProgress::onTaskProgress, this);
     taskMgr->signalEnded.connectSlot(&WinTaskbarGlobalProgress::onTaskEnded, this);
 }
 
@@ -30,13 +36,13 @@ void WinTaskbarGlobalProgress::setWindow(QWindow* window)
 
 void WinTaskbarGlobalProgress::onTaskProgress(TaskId taskId, double percent)
 {
+    // Progress updates are delivered independently of signalStarted/signalEnded, so ignore the ones
+    // of tasks not(or no more) running
     auto it = m_mapTaskIdProgress.find(taskId);
-    if (it != m_mapTaskIdProgress.end())
+    if (it != m_mapTaskIdProgress.end()) {
         it->second = percent;
-    else
-        m_mapTaskIdProgress.insert({ taskId, percent });
-
-    this->updateTaskbar();
+        this->updateTaskbar();
+    }
 }
 
 void WinTaskbarGlobalProgress::onTaskEnded(TaskId taskId)
@@ -17,11 +17,14 @@ class QWinTaskbarButton;
 namespace Mayo {
 
 class TaskManager;
+class TaskProgressDispatcher;
 
 class WinTaskbarGlobalProgress : public QObject {
     Q_OBJECT
 public:
-    WinTaskbarGlobalProgress(TaskManager* taskMgr, QObject* parent = nullptr);
+    WinTaskbarGlobalProgress(
+            TaskManager* taskMgr, TaskProgressDispatcher* progressDispatcher, QObject* parent = nullptr
+    );
 
     void setWindow(QWindow* window);
 
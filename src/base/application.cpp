@@ -142,6 +142,7 @@ void Application::closeDocument(const DocumentPtr& doc)
     doc->signalNameChanged.disconnectAll();
     doc->signalFilePathChanged.disconnectAll();
     doc->signalEntityAdded.disconnectAll();
+    doc->signalEntitiesAdded.disconnectAll();
     doc->signalEntityAboutToBeDestroyed.disconnectAll();
     this->signalDocumentClosed.send(doc);
     //doc->Main().ForgetAllAttributes(true/*clearChildren*/);
@@ -261,6 +262,9 @@ void Application::addDocument(const DocumentPtr& doc)
         doc->signalEntityAdded.connectSlot([=](TreeNodeId entityId) {
             this->signalDocumentEntityAdded.send(doc, entityId);
         });
+        doc->signalEntitiesAdded.connectSlot([=](const std::vector<TreeNodeId>& vecEntityId) {
+            this->signalDocumentEntitiesAdded.send(doc, vecEntityId);
+        });
         doc->signalEntityAboutToBeDestroyed.connectSlot([=](TreeNodeId entityId) {
             this->signalDocumentEntityAboutToBeDestroyed.send(doc, entityId);
         });
@@ -64,6 +64,7 @@ public:
     Signal<const DocumentPtr&, const std::string&> signalDocumentNameChanged;
     Signal<const DocumentPtr&, const FilePath&> signalDocumentFilePathChanged;
     Signal<const DocumentPtr&, TreeNodeId> signalDocumentEntityAdded;
+    Signal<const DocumentPtr&, const std::vector<TreeNodeId>&> signalDocumentEntitiesAdded;
     Signal<const DocumentPtr&, TreeNodeId> signalDocumentEntityAboutToBeDestroyed;
 
 public: // -- from TDocStd_Application
@@ -5,88 +5,84 @@
 
 #include "application_item_selection_model.h"
 
-namespace Mayo {
-
-namespace Internal {
-
-static bool hasApplicationItem(gsl::span<ApplicationItem> vec, const ApplicationItem& item)
-{
-    auto itFound = std::find(vec.begin(), vec.end(), item);
-    return itFound != vec.end();
-}
-
-static std::vector<ApplicationItem>::iterator findApplicationItem(
-        std::vector<ApplicationItem>& vec, const ApplicationItem& item)
-{
-    return std::find(vec.begin(), vec.end(), item);
-}
+#include <algorithm>
 
-} // namespace Internal
+namespace Mayo {
 
 gsl::span<const ApplicationItem> ApplicationItemSelectionModel::selectedItems() const
 {
     return m_vecSelectedItem;
 }
 
-bool ApplicationItemSelectionModel::isSelected(const ApplicationItem& item)
+bool ApplicationItemSelectionModel::isSelected(const ApplicationItem& item) const
 {
-    return Internal::hasApplicationItem(m_vecSelectedItem, item);
+    return m_mapItemIndex.find(item) != m_mapItemIndex.cend();
 }
 
 void ApplicationItemSelectionModel::add(const ApplicationItem& item)
 {
-    if (!Internal::hasApplicationItem(m_vecSelectedItem, item)) {
-        m_vecSelectedItem.push_back(item);
-        std::vector<ApplicationItem> vecItem = { item };
-        this->signalChanged.send(vecItem, {});
-    }
+    this->add(gsl::span<const ApplicationItem>(&item, 1));
 }
 
-void ApplicationItemSelectionModel::add(gsl::span<ApplicationItem> vecItem)
+void ApplicationItemSelectionModel::add(gsl::span<const ApplicationItem> vecItem)
 {
-    std::vector<ApplicationItem> signalVecItem;
+    const size_t oldSelectedCount = m_vecSelectedItem.size();
     for (const ApplicationItem& item : vecItem) {
-        if (!Internal::hasApplicationItem(m_vecSelectedItem, item)) {
+        if (m_mapItemIndex.insert({ item, m_vecSelectedItem.size() }).second)
             m_vecSelectedItem.push_back(item);
-            signalVecItem.push_back(item);
-        }
     }
 
-    if (!signalVecItem.empty())
-        this->signalChanged.send(signalVecItem, {});
+    if (m_vecSelectedItem.size() != oldSelectedCount) {
+        // Warning: slots connected to changed() signal may indirectly access m_vecSelectedItem
+        const std::vector<ApplicationItem> vecAddedItem(
+            m_vecSelectedItem.begin() + oldSelectedCount, m_vecSelectedItem.end()
+        );
+        this->signalChanged.send(vecAddedItem, {});
+    }
 }
 
 void ApplicationItemSelectionModel::remove(const ApplicationItem& item)
 {
-    auto itFound = Internal::findApplicationItem(m_vecSelectedItem, item);
-    if (itFound != m_vecSelectedItem.end()) {
-        m_vecSelectedItem.erase(itFound);
-        std::vector<ApplicationItem> vecItem = { item };
-        this->signalChanged.send({}, vecItem);
-    }
+    this->remove(gsl::span<const ApplicationItem>(&item, 1));
 }
 
-void ApplicationItemSelectionModel::remove(gsl::span<ApplicationItem> vecItem)
+void ApplicationItemSelectionModel::remove(gsl::span<const ApplicationItem> vecItem)
 {
-    std::vector<ApplicationItem> signalVecItem;
+    std::vector<ApplicationItem> vecRemovedItem;
+    size_t firstRemovedIndex = m_vecSelectedItem.size();
     for (const ApplicationItem& item : vecItem) {
-        auto itFound = Internal::findApplicationItem(m_vecSelectedItem, item);
-        if (itFound != m_vecSelectedItem.end()) {
-            m_vecSelectedItem.erase(itFound);
-            signalVecItem.push_back(item);
+        auto it = m_mapItemIndex.find(item);
+        if (it != m_mapItemIndex.end()) {
+            firstRemovedIndex = std::min(firstRemovedIndex, it->second);
+            vecRemovedItem.push_back(item);
+            m_mapItemIndex.erase(it);
         }
     }
 
-    if (!signalVecItem.empty())
-        this->signalChanged.send({}, signalVecItem);
+    if (vecRemovedItem.empty())
+        return;
+
+    // Erase removed items in one pass keeping order of the remaining ones
+    // Items before the first removed one are left untouched, only the shifted items get their index
+    // updated, once for the whole batch. So removing the last selected items is O(1) per item
+    auto itFirstRemoved = m_vecSelectedItem.begin() + firstRemovedIndex;
+    auto itNewEnd = std::remove_if(itFirstRemoved, m_vecSelectedItem.end(), [=](const ApplicationItem& item) {
+        return m_mapItemIndex.find(item) == m_mapItemIndex.cend();
+    });
+    m_vecSelectedItem.erase(itNewEnd, m_vecSelectedItem.end());
+    for (size_t i = firstRemovedIndex; i < m_vecSelectedItem.size(); ++i)
+        m_mapItemIndex.at(m_vecSelectedItem[i]) = i;
+
+    this->signalChanged.send({}, vecRemovedItem);
 }
 
 void ApplicationItemSelectionModel::clear()
 {
     if (!m_vecSelectedItem.empty()) {
         // Warning: slots connected to changed() signal may indirectly access m_vecSelectedItem
-        const auto vecDeselectedItem = m_vecSelectedItem;
+        const auto vecDeselectedItem = std::move(m_vecSelectedItem);
         m_vecSelectedItem.clear();
+        m_mapItemIndex.clear();
         this->signalChanged.send({}, vecDeselectedItem);
     }
 }
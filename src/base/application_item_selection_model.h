@@ -9,29 +9,38 @@
 #include "signal.h"
 
 #include <gsl/span>
+#include <unordered_map>
+#include <vector>
 
 namespace Mayo {
 
 // Keeps track of the items selected in an Application object
+// Selected items are kept in insertion order, and indexed by hash so that lookup, add and remove
+// operations have O(1) average complexity per item
 class ApplicationItemSelectionModel {
 public:
     gsl::span<const ApplicationItem> selectedItems() const;
 
-    bool isSelected(const ApplicationItem& item);
+    bool isSelected(const ApplicationItem& item) const;
 
+    // Adds items to the selection, signalChanged is emitted once with the items actually added
     void add(const ApplicationItem& item);
-    void add(gsl::span<ApplicationItem> vecItem);
+    void add(gsl::span<const ApplicationItem> vecItem);
+
+    // Removes items from the selection, signalChanged is emitted once with the items actually removed
     void remove(const ApplicationItem& item);
-    void remove(gsl::span<ApplicationItem> vecItem);
+    void remove(gsl::span<const ApplicationItem> vecItem);
 //    void toggle(const ApplicationItem& item);
 //    void toggle(gsl::span<ApplicationItem> item);
 
     void clear();
 
+    // Signal emitted with arguments (selected items, deselected items)
     Signal<gsl::span<const ApplicationItem>, gsl::span<const ApplicationItem>> signalChanged;
 
 private:
     std::vector<ApplicationItem> m_vecSelectedItem;
+    std::unordered_map<ApplicationItem, size_t> m_mapItemIndex; // Item -> index in m_vecSelectedItem
 };
 
 } // namespace Mayo
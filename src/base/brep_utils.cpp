@@ -6,6 +6,7 @@
 #include "brep_utils.h"
 
 #include "tkernel_utils.h"
+#include "tracing.h"
 #if OCC_VERSION_HEX >= OCC_VERSION_CHECK(7, 5, 0)
 #  include "occ_progress_indicator.h"
 #endif
@@ -112,6 +113,7 @@ void BRepUtils::computeMesh(
         [[maybe_unused]]TaskProgress* progress
     )
 {
+    MAYO_TRACE_SCOPE("mesh", "BRepUtils::computeMesh");
 #if OCC_VERSION_HEX >= OCC_VERSION_CHECK(7, 5, 0)
     auto indicator = makeOccHandle<OccProgressIndicator>(progress);
     [[maybe_unused]]BRepMesh_IncrementalMesh mesher(shape, params, TKernelUtils::start(indicator));
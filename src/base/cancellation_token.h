@@ -0,0 +1,31 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+
+namespace Mayo {
+
+// Read-only view on the abort state of a task, obtained with TaskProgress::cancellationToken()
+// All the TaskProgress objects of a task(root and children) share the same state, so a token
+// reflects TaskManager::requestAbort() whatever the depth of the TaskProgress it comes from
+// Checking a token costs a single relaxed atomic load, it's meant to be polled within hot loops
+// A token is valid as long as the root TaskProgress of the task exists. A default-constructed
+// token is never cancelled
+class CancellationToken {
+public:
+    CancellationToken() = default;
+    explicit CancellationToken(const std::atomic<bool>* state) : m_state(state) {}
+
+    bool isCancelled() const {
+        return m_state ? m_state->load(std::memory_order_relaxed) : false;
+    }
+
+private:
+    const std::atomic<bool>* m_state = nullptr;
+};
+
+} // namespace Mayo
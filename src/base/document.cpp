@@ -8,8 +8,12 @@
 #include "application.h"
 #include "caf_utils.h"
 #include "cpp_utils.h"
+#include "label_data.h"
+#include "tkernel_utils.h"
 
+#include <TDataStd_Name.hxx>
 #include <TDF_ChildIterator.hxx>
+#include <TDF_CopyLabel.hxx>
 #include <TDF_TagSource.hxx>
 #include <TopExp_Explorer.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
@@ -35,6 +39,8 @@ void Document::initXCaf()
 {
     m_xcaf.setLabelMain(this->Main());
     m_xcaf.setModelTree(m_modelTree);
+    m_xcaf.setModelTreeIndex(m_modelTreeIndex);
+    m_xcaf.setLabelDataFlagsCache(m_labelDataFlagsCache);
 }
 
 const std::string& Document::name() const
@@ -117,6 +123,8 @@ TDF_Label Document::modelTreeNodeLabel(TreeNodeId nodeId) const
 void Document::rebuildModelTree()
 {
     m_modelTree.clear();
+    m_modelTreeIndex.clear();
+    m_labelDataFlagsCache.clear();
     const bool xcafIsNull = m_xcaf.isNull();
     if (!xcafIsNull) {
         for (const TDF_Label& label : m_xcaf.topLevelFreeShapes())
@@ -129,11 +137,32 @@ void Document::rebuildModelTree()
         if (!CafUtils::isNullOrEmpty(childLabel)
                 && (xcafIsNull || childLabel != this->Main())) // Not XCAF Main label
         {
-            m_modelTree.appendChild(0, childLabel);
+            m_xcaf.appendModelTreeNode(0, childLabel);
         }
     }
 }
 
+std::vector<TreeNodeId> Document::findTreeNodes(const TDF_Label& label) const
+{
+    std::vector<TreeNodeId> vecNodeId;
+    auto [itBegin, itEnd] = m_modelTreeIndex.equal_range(label);
+    for (auto it = itBegin; it != itEnd; ++it)
+        vecNodeId.push_back(it->second);
+
+    return vecNodeId;
+}
+
+LabelDataFlags Document::labelDataFlags(const TDF_Label& label) const
+{
+    auto it = m_labelDataFlagsCache.find(label);
+    return it != m_labelDataFlagsCache.end() ? it->second : computeLabelDataFlags(label);
+}
+
+void Document::invalidateLabelDataFlags(const TDF_Label& label)
+{
+    m_labelDataFlagsCache.erase(label);
+}
+
 DocumentPtr Document::findFrom(const TDF_Label& label)
 {
     return DocumentPtr::DownCast(TDocStd_Document::Get(label));
@@ -154,11 +183,59 @@ TDF_Label Document::newEntityShapeLabel()
     return m_xcaf.shapeTool()->NewShape();
 }
 
+DocumentPtr Document::newScratch()
+{
+    DocumentPtr doc = new Document(ApplicationPtr());
+    XCAFDoc_DocumentTool::Set(doc->Main(), false);
+    doc->initXCaf();
+    return doc;
+}
+
+NCollection_Sequence<TDF_Label> Document::copyEntities(const NCollection_Sequence<TDF_Label>& seqSrcLabel)
+{
+    NCollection_Sequence<TDF_Label> seqNewLabel;
+    const OccHandle<XCAFDoc_ShapeTool> dstShapeTool = m_xcaf.shapeTool();
+#if OCC_VERSION_HEX >= OCC_VERSION_CHECK(7, 6, 0)
+    // Mapping source labels -> copied labels, shared across entities so a shape referred by
+    // several assemblies is copied once
+    TDF_LabelDataMap mapLabel;
+    NCollection_DataMap<OccHandle<XCAFDoc_VisMaterial>, OccHandle<XCAFDoc_VisMaterial>> mapVisMaterial;
+#endif
+    for (const TDF_Label& srcLabel : seqSrcLabel) {
+        TDF_Label newLabel;
+        if (XCaf::isShape(srcLabel)) {
+#if OCC_VERSION_HEX >= OCC_VERSION_CHECK(7, 6, 0)
+            const OccHandle<XCAFDoc_ShapeTool> srcShapeTool = XCAFDoc_DocumentTool::ShapeTool(srcLabel);
+            newLabel = XCAFDoc_Editor::CloneShapeLabel(srcLabel, srcShapeTool, dstShapeTool, mapLabel);
+#else
+            newLabel = dstShapeTool->AddShape(XCaf::shape(srcLabel), false/*!makeAssembly*/);
+            TDataStd_Name::Set(newLabel, CafUtils::labelAttrStdName(srcLabel));
+#endif
+        }
+        else {
+            newLabel = this->newEntityLabel();
+            TDF_CopyLabel copy(srcLabel, newLabel);
+            copy.Perform();
+        }
+
+        if (!newLabel.IsNull())
+            seqNewLabel.Append(newLabel);
+    }
+
+#if OCC_VERSION_HEX >= OCC_VERSION_CHECK(7, 6, 0)
+    for (TDF_LabelDataMap::Iterator it(mapLabel); it.More(); it.Next())
+        XCAFDoc_Editor::CloneMetaData(it.Key(), it.Value(), &mapVisMaterial);
+#endif
+
+    return seqNewLabel;
+}
+
 TreeNodeId Document::findEntity(const TDF_Label& label) const
 {
-    for (TreeNodeId nodeId : this->allEntityNodeIds()) {
-        if (this->modelTreeNodeLabel(nodeId) == label)
-            return nodeId;
+    auto [itBegin, itEnd] = m_modelTreeIndex.equal_range(label);
+    for (auto it = itBegin; it != itEnd; ++it) {
+        if (m_modelTree.nodeIsRoot(it->second))
+            return it->second;
     }
 
     return 0;
@@ -187,8 +264,10 @@ void Document::deepExpandCompounds(const TDF_Label& label)
         // Only expand compound|compsolid shapes containing at least one solid
         if (shape.ShapeType() == TopAbs_COMPOUND || shape.ShapeType() == TopAbs_COMPSOLID) {
             TopExp_Explorer explorer(shape, TopAbs_SOLID);
-            if (explorer.More())
+            if (explorer.More()) {
                 XCAFDoc_Editor::Expand(this->Main(), label, false/*!recursive*/);
+                this->invalidateLabelDataFlags(label);
+            }
         }
     }
 }
@@ -199,6 +278,7 @@ void Document::addEntityTreeNode(const TDF_Label& label)
     if (this->containsLabel(label) && this->findEntity(label) == 0) {
         this->deepExpandCompounds(label);
         const TreeNodeId nodeId = m_xcaf.deepBuildAssemblyTree(0, label);
+        this->signalEntitiesAdded.send(std::vector<TreeNodeId>{ nodeId });
         this->signalEntityAdded.send(nodeId);
     }
 }
@@ -215,6 +295,9 @@ void Document::addEntityTreeNodeSequence(const NCollection_Sequence<TDF_Label>&
         }
     }
 
+    if (!vecTreeNodeId.empty())
+        this->signalEntitiesAdded.send(vecTreeNodeId);
+
     for (TreeNodeId treeNodeId : vecTreeNodeId)
         this->signalEntityAdded.send(treeNodeId);
 }
@@ -232,6 +315,8 @@ void Document::destroyEntity(TreeNodeId entityTreeNodeId)
     std::unordered_set<TDF_Label> setSimpleShapeLabel;
     traverseTree_postOrder(entityTreeNodeId, m_modelTree, [&](TreeNodeId nodeId) {
         TDF_Label nodeLabel = m_modelTree.nodeData(nodeId);
+        this->eraseModelTreeIndex(nodeId);
+        m_labelDataFlagsCache.erase(nodeLabel);
         if (XCaf::isShapeSimple(nodeLabel))
             setSimpleShapeLabel.insert(nodeLabel);
         else if (XCaf::isShapeComponent(nodeLabel))
@@ -252,6 +337,17 @@ void Document::destroyEntity(TreeNodeId entityTreeNodeId)
     m_modelTree.removeRoot(entityTreeNodeId);
 }
 
+void Document::eraseModelTreeIndex(TreeNodeId nodeId)
+{
+    auto [itBegin, itEnd] = m_modelTreeIndex.equal_range(m_modelTree.nodeData(nodeId));
+    for (auto it = itBegin; it != itEnd; ++it) {
+        if (it->second == nodeId) {
+            m_modelTreeIndex.erase(it);
+            return;
+        }
+    }
+}
+
 void Document::BeforeClose()
 {
     TDocStd_Document::BeforeClose();
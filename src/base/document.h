@@ -15,6 +15,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace Mayo {
 
@@ -57,22 +58,49 @@ public:
     TDF_Label modelTreeNodeLabel(TreeNodeId nodeId) const;
     void rebuildModelTree();
 
+    // Returns the identifiers of all the model tree nodes associated to 'label'
+    // Complexity is O(1) on average, the model tree being indexed by label
+    std::vector<TreeNodeId> findTreeNodes(const TDF_Label& label) const;
+
+    // Data flags of 'label', read from the cache filled when the model tree is built. Flags are
+    // computed on the fly for labels not in the cache. Cache is never modified by this function
+    LabelDataFlags labelDataFlags(const TDF_Label& label) const;
+    // Removes the cached data flags of 'label', they'll be computed again when requested
+    void invalidateLabelDataFlags(const TDF_Label& label);
+
     static DocumentPtr findFrom(const TDF_Label& label);
 
+    // Creates a standalone XCAF document not bound to any Application: it has no identifier and
+    // its signals aren't forwarded. Meant to be temporary storage, eg to transfer a file in a
+    // separate thread before copying the result into some target document with copyEntities()
+    static DocumentPtr newScratch();
+
+    // Copies entities 'seqSrcLabel' of another document into this document
+    // Shapes shared within 'seqSrcLabel' are still shared after the copy, XCAF meta-data(names,
+    // colors, layers, materials) are copied along(requires OpenCascade >= 7.6)
+    // Returns the labels of the new entities, they are not added to the model tree
+    NCollection_Sequence<TDF_Label> copyEntities(const NCollection_Sequence<TDF_Label>& seqSrcLabel);
+
     // Creates general-purpose entity, not bound to a specific type
     TDF_Label newEntityLabel();
 
     // Creates entity bound to a BRep shape and registered as top-level into XCAFDoc_ShapeTool
     TDF_Label newEntityShapeLabel();
 
+    // Adds entity 'label' to the model tree, then signalEntitiesAdded and signalEntityAdded are emitted
     void addEntityTreeNode(const TDF_Label& label);
+    // Adds all entities of 'seqLabel' to the model tree, then signalEntitiesAdded is emitted once
+    // followed by signalEntityAdded for each new entity
     void addEntityTreeNodeSequence(const NCollection_Sequence<TDF_Label>& seqLabel);
     void destroyEntity(TreeNodeId entityTreeNodeId);
 
     // Signals
     Signal<const std::string&> signalNameChanged;
     Signal<const FilePath&> signalFilePathChanged;
+    // Any addition of entities emits both signals: signalEntitiesAdded once with all the new entities,
+    // then signalEntityAdded for each of them. Listeners are expected to connect to only one of them
     Signal<TreeNodeId> signalEntityAdded;
+    Signal<const std::vector<TreeNodeId>&> signalEntitiesAdded;
     Signal<TreeNodeId> signalEntityAboutToBeDestroyed;
 
 public: // -- from TDocStd_Document
@@ -94,6 +122,7 @@ private:
     TreeNodeId findEntity(const TDF_Label& label) const;
     bool containsLabel(const TDF_Label& label) const;
     void deepExpandCompounds(const TDF_Label& label);
+    void eraseModelTreeIndex(TreeNodeId nodeId);
 
     ApplicationPtr m_app;
     Identifier m_identifier = -1;
@@ -101,6 +130,8 @@ private:
     FilePath m_filePath;
     XCaf m_xcaf;
     Tree<TDF_Label> m_modelTree;
+    LabelTreeNodeIndex m_modelTreeIndex;
+    LabelDataFlagsCache m_labelDataFlagsCache;
 };
 
 } // namespace Mayo
@@ -0,0 +1,68 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "fast_signal.h"
+
+namespace Mayo {
+
+std::shared_ptr<SignalDeliveryQueue> SignalDeliveryQueue::forCurrentThread()
+{
+    ISignalThreadHelper* helper = getGlobalSignalThreadHelper();
+    if (!helper)
+        return {};
+
+    // Note: thread_local implies "static"
+    thread_local std::shared_ptr<SignalDeliveryQueue> queue;
+    if (!queue) {
+        queue = std::make_shared<SignalDeliveryQueue>();
+        queue->m_threadContext = helper->getCurrentThreadContext();
+    }
+
+    return queue;
+}
+
+void SignalDeliveryQueue::post(Call&& call)
+{
+    bool isFlushToBeScheduled = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_vecPendingCall.push_back(std::move(call));
+        isFlushToBeScheduled = !m_isFlushScheduled;
+        m_isFlushScheduled = true;
+    }
+
+    ISignalThreadHelper* helper = getGlobalSignalThreadHelper();
+    if (isFlushToBeScheduled && helper) {
+        ++m_scheduledFlushCount;
+        std::weak_ptr<SignalDeliveryQueue> weakQueue = this->weak_from_this();
+        helper->execInThread(m_threadContext, [=]{
+            if (auto queue = weakQueue.lock())
+                queue->flush();
+        });
+    }
+}
+
+void SignalDeliveryQueue::flush()
+{
+    std::vector<Call> vecCall;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        vecCall.swap(m_vecPendingCall);
+        m_isFlushScheduled = false;
+    }
+
+    // Slot functions might run an event loop, hence recursive calls to flush(): the calls to
+    // execute are moved out of the queue first
+    for (const Call& call : vecCall)
+        call();
+
+    // Give back the memory buffer, so next emissions don't have to reallocate
+    vecCall.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_vecPendingCall.empty())
+        m_vecPendingCall.swap(vecCall);
+}
+
+} // namespace Mayo
@@ -0,0 +1,198 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "signal.h"
+#include "small_function.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Mayo {
+
+// Queue of slot calls to be executed in a receiver thread, filled by emitting threads
+// A single function is enqueued with ISignalThreadHelper::execInThread() for all the calls pending
+// in the queue, whatever their count. Calls are executed in the order they were posted
+class SignalDeliveryQueue : public std::enable_shared_from_this<SignalDeliveryQueue> {
+public:
+    using Call = SmallFunction<void()>;
+
+    // Queue of the current thread, created on first call
+    // Returns null if there is no global ISignalThreadHelper object
+    static std::shared_ptr<SignalDeliveryQueue> forCurrentThread();
+
+    // Thread-safe
+    void post(Call&& call);
+
+    // Executes the pending calls, must be called from the receiver thread
+    void flush();
+
+    // Count of functions enqueued with ISignalThreadHelper::execInThread() so far
+    uint64_t scheduledFlushCount() const { return m_scheduledFlushCount; }
+
+private:
+    std::any m_threadContext;
+    std::mutex m_mutex;
+    std::vector<Call> m_vecPendingCall;
+    bool m_isFlushScheduled = false;
+    std::atomic<uint64_t> m_scheduledFlushCount = 0;
+};
+
+// Shared state of a FastSignal connection
+struct FastSignalConnectionState {
+    std::atomic<bool> isConnected = true;
+};
+
+// Handle to a connection between a FastSignal and a slot function
+class FastSignalConnection {
+public:
+    FastSignalConnection() = default;
+    explicit FastSignalConnection(std::shared_ptr<FastSignalConnectionState> state)
+        : m_state(std::move(state))
+    {}
+
+    bool isActive() const { return m_state && m_state->isConnected; }
+
+    // Once disconnected the slot function isn't called anymore, even if some call to that slot
+    // was pending in a SignalDeliveryQueue
+    void disconnect() {
+        if (m_state)
+            m_state->isConnected = false;
+    }
+
+private:
+    std::shared_ptr<FastSignalConnectionState> m_state;
+};
+
+// Signal variant for high-frequency emissions, API is a subset of Signal
+//
+// Slot functions are stored without heap allocation(see SmallFunction) and emission doesn't
+// allocate memory for slots called in the emitting thread
+// Slot functions connected with connectSlot() from a thread different than the emitting one are
+// delivered through the SignalDeliveryQueue of the connecting thread: calls emitted meanwhile are
+// batched and executed with a single queued function per receiver thread
+// NOTE Calls delivered through a SignalDeliveryQueue might be executed before calls previously
+//      queued by Signal::connectSlot()
+// NOTE Like Signal, connection and disconnection must not happen concurrently with emission
+template<typename... Args>
+class FastSignal {
+public:
+    using Slot = SmallFunction<void(Args...)>;
+
+    FastSignal() = default;
+    ~FastSignal() { this->disconnectAll(); }
+
+    // Disable copy
+    FastSignal(const FastSignal&) = delete;
+    FastSignal& operator=(const FastSignal&) = delete;
+
+    // Calls all the connected slots with the arguments provided
+    // Arguments are copied when a slot call is queued in a SignalDeliveryQueue
+    void send(Args... args) const
+    {
+        for (const std::shared_ptr<Entry>& entry : m_vecEntry) {
+            if (!entry->isConnected.load(std::memory_order_relaxed))
+                continue;
+
+            if (!entry->queue || entry->threadId == std::this_thread::get_id()) {
+                entry->slot(args...);
+            }
+            else {
+                entry->queue->post([entry, tupleArgs = std::make_tuple(args...)]{
+                    if (entry->isConnected.load(std::memory_order_relaxed))
+                        std::apply(entry->slot, tupleArgs);
+                });
+            }
+        }
+    }
+
+    // Connects 'fnSlot' to the signal, it will be called in the thread emitting the signal
+    template<typename Function>
+    FastSignalConnection connect(Function&& fnSlot)
+    {
+        return this->addEntry(Slot(std::forward<Function>(fnSlot)), nullptr);
+    }
+
+    // Overload binding the first arguments of 'fnSlot', see connectSlot()
+    template<typename Function, typename BoundArg, typename... BoundArgs>
+    FastSignalConnection connect(Function&& fnSlot, BoundArg&& arg, BoundArgs&&... args)
+    {
+        return this->connect(KDBindings::Private::bind_first(
+            std::forward<Function>(fnSlot), std::forward<BoundArg>(arg), std::forward<BoundArgs>(args)...
+        ));
+    }
+
+    // Connects 'fnSlot' to the signal, it will be called in the current(connecting) thread
+    // Same as connect() if there is no global ISignalThreadHelper object
+    template<typename Function>
+    FastSignalConnection connectSlot(Function&& fnSlot)
+    {
+        return this->addEntry(Slot(std::forward<Function>(fnSlot)), SignalDeliveryQueue::forCurrentThread());
+    }
+
+    // Overload binding the first arguments of 'fnSlot', especially useful for member functions
+    // Example: signal.connectSlot(&Foo::onEvent, this)
+    template<typename Function, typename BoundArg, typename... BoundArgs>
+    FastSignalConnection connectSlot(Function&& fnSlot, BoundArg&& arg, BoundArgs&&... args)
+    {
+        return this->connectSlot(KDBindings::Private::bind_first(
+            std::forward<Function>(fnSlot), std::forward<BoundArg>(arg), std::forward<BoundArgs>(args)...
+        ));
+    }
+
+    void disconnectAll()
+    {
+        for (const std::shared_ptr<Entry>& entry : m_vecEntry)
+            entry->isConnected = false;
+
+        m_vecEntry.clear();
+    }
+
+    // Count of active connections
+    size_t slotCount() const
+    {
+        return std::count_if(m_vecEntry.cbegin(), m_vecEntry.cend(), [](const auto& entry) {
+            return entry->isConnected.load();
+        });
+    }
+
+private:
+    struct Entry : public FastSignalConnectionState {
+        Slot slot;
+        std::thread::id threadId;
+        std::shared_ptr<SignalDeliveryQueue> queue; // Null for direct connections
+    };
+
+    FastSignalConnection addEntry(Slot&& slot, std::shared_ptr<SignalDeliveryQueue> queue)
+    {
+        // Erase entries disconnected meanwhile
+        m_vecEntry.erase(
+            std::remove_if(m_vecEntry.begin(), m_vecEntry.end(), [](const auto& entry) {
+                return !entry->isConnected.load();
+            }),
+            m_vecEntry.end()
+        );
+
+        auto entry = std::make_shared<Entry>();
+        entry->slot = std::move(slot);
+        entry->threadId = std::this_thread::get_id();
+        entry->queue = std::move(queue);
+        m_vecEntry.push_back(entry);
+        return FastSignalConnection(std::move(entry));
+    }
+
+    std::vector<std::shared_ptr<Entry>> m_vecEntry;
+};
+
+} // namespace Mayo
@@ -0,0 +1,122 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "io_performance_report.h"
+
+#include "xcaf.h"
+
+#include <BRep_Tool.hxx>
+#include <OSD_MemInfo.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <fmt/format.h>
+
+namespace Mayo::IO {
+
+namespace {
+
+std::string jsonEscaped(std::string_view str)
+{
+    std::string strEscaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            strEscaped += '\\';
+
+        if (static_cast<unsigned char>(c) >= 0x20)
+            strEscaped += c;
+    }
+
+    return strEscaped;
+}
+
+} // namespace
+
+std::string PerformanceReport::toText() const
+{
+    std::string str;
+    for (const FileEntry& entry : this->files) {
+        str += fmt::format(
+            "{} [{}{}]\n"
+            "    probe {:.1f}ms, read {:.1f}ms, transfer {:.1f}ms, post-process {:.1f}ms, "
+            "model tree {:.1f}ms, write {:.1f}ms\n"
+            "    {} bytes, {} entities, {} faces, {} triangles, peak memory +{} KB\n",
+            entry.filepath.filename().u8string(),
+            formatIdentifier(entry.format),
+            entry.success ? "" : ", failed",
+            entry.probeTime_ms, entry.readTime_ms, entry.transferTime_ms,
+            entry.postProcessTime_ms, entry.modelTreeTime_ms, entry.writeTime_ms,
+            entry.fileSize, entry.entityCount, entry.faceCount, entry.triangleCount,
+            entry.peakMemoryDelta / 1024
+        );
+    }
+
+    if (this->deduplicationTime_ms > 0.)
+        str += fmt::format("Product deduplication: {:.1f}ms\n", this->deduplicationTime_ms);
+
+    str += fmt::format(
+        "Total: {:.1f}ms, peak memory +{} KB\n", this->totalTime_ms, this->peakMemoryDelta / 1024
+    );
+    return str;
+}
+
+std::string PerformanceReport::toJson() const
+{
+    std::string str = "{\n  \"files\": [";
+    for (const FileEntry& entry : this->files) {
+        if (&entry != &this->files.front())
+            str += ",";
+
+        str += fmt::format(
+            "\n    {{\"filepath\": \"{}\", \"format\": \"{}\", \"success\": {}, "
+            "\"probeTime_ms\": {:.3f}, \"readTime_ms\": {:.3f}, \"transferTime_ms\": {:.3f}, "
+            "\"postProcessTime_ms\": {:.3f}, \"modelTreeTime_ms\": {:.3f}, \"writeTime_ms\": {:.3f}, "
+            "\"fileSize\": {}, \"entityCount\": {}, \"faceCount\": {}, \"triangleCount\": {}, "
+            "\"peakMemoryDelta\": {}}}",
+            jsonEscaped(entry.filepath.u8string()),
+            formatIdentifier(entry.format),
+            entry.success ? "true" : "false",
+            entry.probeTime_ms, entry.readTime_ms, entry.transferTime_ms,
+            entry.postProcessTime_ms, entry.modelTreeTime_ms, entry.writeTime_ms,
+            entry.fileSize, entry.entityCount, entry.faceCount, entry.triangleCount,
+            entry.peakMemoryDelta
+        );
+    }
+
+    str += fmt::format(
+        "\n  ],\n  \"totalTime_ms\": {:.3f},\n  \"deduplicationTime_ms\": {:.3f},\n"
+        "  \"peakMemoryDelta\": {}\n}}\n",
+        this->totalTime_ms, this->deduplicationTime_ms, this->peakMemoryDelta
+    );
+    return str;
+}
+
+uint64_t PerformanceReport::processPeakMemory()
+{
+    const OSD_MemInfo memInfo;
+    const Standard_Size peak = memInfo.Value(OSD_MemInfo::MemWorkingSetPeak);
+    return peak != Standard_Size(-1) ? peak : 0;
+}
+
+void PerformanceReport::countShapeElements(const NCollection_Sequence<TDF_Label>& seqEntity, FileEntry* entry)
+{
+    TopTools_IndexedMapOfShape mapFace;
+    for (const TDF_Label& labelEntity : seqEntity) {
+        if (XCaf::isShape(labelEntity))
+            TopExp::MapShapes(XCaf::shape(labelEntity), TopAbs_FACE, mapFace);
+    }
+
+    entry->faceCount += mapFace.Extent();
+    for (const TopoDS_Shape& shape : mapFace) {
+        TopLoc_Location loc;
+        const OccHandle<Poly_Triangulation>& triangulation = BRep_Tool::Triangulation(TopoDS::Face(shape), loc);
+        if (!triangulation.IsNull())
+            entry->triangleCount += triangulation->NbTriangles();
+    }
+}
+
+} // namespace Mayo::IO
@@ -0,0 +1,71 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "filepath.h"
+#include "io_format.h"
+
+#include <NCollection_Sequence.hxx>
+#include <TDF_Label.hxx>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Mayo::IO {
+
+// Performance figures of an import/export operation(see IO::System), meant to track regressions
+// across versions on a corpus of files
+struct PerformanceReport {
+    // Figures of a single file
+    struct FileEntry {
+        FilePath filepath;
+        Format format = Format_Unknown;
+        bool success = false;
+
+        // Stage durations in milliseconds, 0 for stages not applicable to the operation
+        // Stages shared by all the files of an import(eg model tree update) are apportioned by
+        // entity count
+        double probeTime_ms = 0.;
+        double readTime_ms = 0.;
+        double transferTime_ms = 0.;
+        double postProcessTime_ms = 0.;
+        double modelTreeTime_ms = 0.;
+        double writeTime_ms = 0.;
+
+        // Size in bytes of the file read(import) or written(export)
+        uint64_t fileSize = 0;
+
+        int entityCount = 0;
+        int faceCount = 0;
+        uint64_t triangleCount = 0;
+
+        // Increase in bytes of the process peak memory while the file was processed
+        // NOTE Peak memory is process-wide, for files processed concurrently it includes the
+        //      memory allocated for the other files
+        int64_t peakMemoryDelta = 0;
+    };
+
+    std::vector<FileEntry> files;
+    double totalTime_ms = 0.;
+    double deduplicationTime_ms = 0.;
+    int64_t peakMemoryDelta = 0;
+
+    // Human readable report, one line per file
+    std::string toText() const;
+
+    // Report in JSON format
+    std::string toJson() const;
+
+    // Peak resident memory(ie peak working set) in bytes of the current process, 0 if not available
+    static uint64_t processPeakMemory();
+
+    // Adds to 'entry' the faces and triangles of shapes 'seqEntity'(faces shared by several
+    // instances are counted once)
+    static void countShapeElements(const NCollection_Sequence<TDF_Label>& seqEntity, FileEntry* entry);
+};
+
+} // namespace Mayo::IO
@@ -11,19 +11,25 @@
 #include "io_reader.h"
 #include "io_writer.h"
 #include "messenger.h"
+#include "task_executor.h"
 #include "task_manager.h"
 #include "task_progress.h"
 #include "tkernel_utils.h"
+#include "tracing.h"
 
 #include <fmt/format.h>
 #include <gsl/util>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <functional>
 #include <locale>
 #include <mutex>
 #include <regex>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -37,20 +43,123 @@ bool containsFormat(gsl::span<const Format> spanFormat, Format format)
     return itFormat != spanFormat.end();
 }
 
-void dispatchErrors(std::string_view headerMsg, const MessageCollecter& msgCollect, Messenger* target)
+// Whether files of 'format' can be transferred concurrently, each one in its own scratch document
+// Readers of such formats write only into the target document and don't depend on global state
+// Other readers are not safe: OpenCascade STEP/IGES readers apply their parameters to the global
+// Interface_Static variables(see OccStaticVariablesRollback) and share the XSControl controllers,
+// mesh-based readers(OBJ, glTF, VRML, Assimp, ...) aren't documented as re-entrant
+bool isConcurrentTransferSafe(Format format)
+{
+    switch (format) {
+    case Format_OCCBREP:
+    case Format_OFF:
+    case Format_PLY:
+    case Format_STL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Mutex serializing the transfers of files whose format isn't safe for concurrent transfers
+// It's shared by all formats, as unrelated readers can rely on the same global state(eg
+// Interface_Static for STEP and IGES). Transfers never wait for other tasks, so holding this mutex
+// in a worker thread can't dead-lock the executor
+std::mutex& unsafeTransferMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Splits entities 'vecEntity' into groups so that entities of different groups don't share any
+// product(simple shape referred by assemblies)
+// Returns the groups as indexes into 'vecEntity', groups and their indexes are sorted
+std::vector<std::vector<size_t>> groupEntitiesSharingProducts(const std::vector<TDF_Label>& vecEntity)
+{
+    // Union-find over entity indexes
+    std::vector<size_t> vecParent(vecEntity.size());
+    for (size_t i = 0; i < vecParent.size(); ++i)
+        vecParent.at(i) = i;
+
+    auto fnFindRoot = [&](size_t index) {
+        while (vecParent.at(index) != index) {
+            vecParent.at(index) = vecParent.at(vecParent.at(index));
+            index = vecParent.at(index);
+        }
+
+        return index;
+    };
+
+    // Map each product to the first entity found referring to it
+    std::unordered_map<TDF_Label, size_t> mapProductEntity;
+    std::function<void(const TDF_Label&, size_t)> fnVisit = [&](const TDF_Label& label, size_t index) {
+        if (XCaf::isShapeAssembly(label)) {
+            for (const TDF_Label& labelComponent : XCaf::shapeComponents(label))
+                fnVisit(XCaf::shapeReferred(labelComponent), index);
+
+            return;
+        }
+
+        auto [it, isNew] = mapProductEntity.insert({ label, index });
+        if (!isNew) {
+            const size_t root = fnFindRoot(index);
+            const size_t otherRoot = fnFindRoot(it->second);
+            vecParent.at(std::max(root, otherRoot)) = std::min(root, otherRoot);
+        }
+    };
+    for (size_t i = 0; i < vecEntity.size(); ++i)
+        fnVisit(vecEntity.at(i), i);
+
+    std::vector<std::vector<size_t>> vecGroup;
+    std::unordered_map<size_t, size_t> mapRootGroup;
+    for (size_t i = 0; i < vecEntity.size(); ++i) {
+        auto [it, isNew] = mapRootGroup.insert({ fnFindRoot(i), vecGroup.size() });
+        if (isNew)
+            vecGroup.emplace_back();
+
+        vecGroup.at(it->second).push_back(i);
+    }
+
+    return vecGroup;
+}
+
+// 'MessageCollecterType' is either MessageCollecter or ConcurrentMessageCollecter
+template<typename MessageCollecterType>
+void dispatchErrors(std::string_view headerMsg, const MessageCollecterType& msgCollect, Messenger* target)
 {
     const std::string strErrors = msgCollect.asString("\n    ", MessageType::Error);
     if (!strErrors.empty())
         target->error() << fmt::format("{}\n    {}", headerMsg, strErrors);
 }
 
-void dispatchWarnings(std::string_view headerMsg, const MessageCollecter& msgCollect, Messenger* target)
+template<typename MessageCollecterType>
+void dispatchWarnings(std::string_view headerMsg, const MessageCollecterType& msgCollect, Messenger* target)
 {
     const std::string strWarnings = msgCollect.asString("\n    ", MessageType::Warning);
     if (!strWarnings.empty())
         target->warning() << fmt::format("{}\n    {}", headerMsg, strWarnings);
 }
 
+// Adds to `*duration_ms` the time elapsed between construction and destruction
+class ScopedDuration {
+public:
+    explicit ScopedDuration(double* duration_ms)
+        : m_duration_ms(duration_ms), m_start(std::chrono::steady_clock::now())
+    {}
+
+    ~ScopedDuration() {
+        const auto duration = std::chrono::steady_clock::now() - m_start;
+        *m_duration_ms += std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    ScopedDuration(const ScopedDuration&) = delete;
+    ScopedDuration& operator=(const ScopedDuration&) = delete;
+
+private:
+    double* m_duration_ms;
+    std::chrono::steady_clock::time_point m_start;
+};
+
 } // namespace
 
 void System::addFormatProbe(const FormatProbe& probe)
@@ -186,12 +295,23 @@ std::unique_ptr<Writer> System::createWriter(Format format) const
 
 bool System::importInDocument(const Args_ImportInDocument& args) const
 {
+    MAYO_TRACE_SCOPE("io", "IO::System::importInDocument");
     DocumentPtr doc = args.targetDocument;
     const auto listFilepath = args.filepaths;
     TaskProgress* rootProgress = args.progress ? args.progress : &TaskProgress::null();
     Messenger* messenger = args.messenger ? args.messenger : &Messenger::null();
+    PerformanceReport report;
+    const uint64_t processPeakMemoryAtStart = args.report ? PerformanceReport::processPeakMemory() : 0;
+    auto _ = gsl::finally([&]{
+        if (args.report) {
+            report.peakMemoryDelta = PerformanceReport::processPeakMemory() - processPeakMemoryAtStart;
+            *args.report = std::move(report);
+        }
+    });
+    const ScopedDuration totalDuration(&report.totalTime_ms);
 
-    bool ok = true;
+    // Written concurrently by read/transfer tasks
+    std::atomic<bool> ok = true;
 
     using ReaderPtr = std::unique_ptr<Reader>;
     struct TaskData {
@@ -200,10 +320,12 @@ bool System::importInDocument(const Args_ImportInDocument& args) const
         Format fileFormat = Format_Unknown;
         TaskProgress* progress = nullptr;
         TaskId taskId = 0;
+        DocumentPtr transferDocument;
         NCollection_Sequence<TDF_Label> seqTransferredEntity;
         bool readSuccess = false;
-        bool transferred = false;
-        MessageCollecter messenger;
+        // Readers may emit many messages(eg per entity), possibly from parallel tasks
+        ConcurrentMessageCollecter messenger;
+        PerformanceReport::FileEntry report;
     };
 
     auto fnEntityPostProcessRequired = [&](Format format) {
@@ -223,7 +345,11 @@ bool System::importInDocument(const Args_ImportInDocument& args) const
         return false;
     };
     auto fnReadFile = [&](TaskData& taskData) {
-        taskData.fileFormat = this->probeFormat(taskData.filepath);
+        {
+            const ScopedDuration duration(&taskData.report.probeTime_ms);
+            taskData.fileFormat = this->probeFormat(taskData.filepath);
+        }
+
         if (taskData.fileFormat == Format_Unknown)
             return fnReadFileError(taskData, textIdTr("Unknown format"));
 
@@ -236,6 +362,7 @@ bool System::importInDocument(const Args_ImportInDocument& args) const
         if (!taskData.reader)
             return fnReadFileError(taskData, textIdTr("No supporting reader"));
 
+        MAYO_TRACE_SCOPE("io", "Reader::readFile");
         taskData.reader->setMessenger(&taskData.messenger);
         if (args.parametersProvider) {
             taskData.reader->applyProperties(
@@ -243,6 +370,7 @@ bool System::importInDocument(const Args_ImportInDocument& args) const
             );
         }
 
+        const ScopedDuration duration(&taskData.report.readTime_ms);
         if (!taskData.reader->readFile(taskData.filepath, &progress))
             return fnReadFileError(taskData, textIdTr("File read problem"));
 
@@ -255,27 +383,35 @@ bool System::importInDocument(const Args_ImportInDocument& args) const
 
         TaskProgress progress(taskData.progress, portionSize, textIdTr("Transferring file"));
         if (taskData.reader && !TaskProgress::isAbortRequested(&progress)) {
-            taskData.seqTransferredEntity = taskData.reader->transfer(doc, &progress);
+            MAYO_TRACE_SCOPE("io", "Reader::transfer");
+            const ScopedDuration duration(&taskData.report.transferTime_ms);
+            const DocumentPtr transferDoc = taskData.transferDocument ? taskData.transferDocument : doc;
+            taskData.seqTransferredEntity = taskData.reader->transfer(transferDoc, &progress);
             if (taskData.seqTransferredEntity.IsEmpty())
                 fnAddError(taskData, textIdTr("File transfer problem"));
         }
-
-        taskData.transferred = true;
     };
     auto fnPostProcess = [&](TaskData& taskData) {
         if (!fnEntityPostProcessRequired(taskData.fileFormat))
             return;
 
+        MAYO_TRACE_SCOPE("io", "IO::System::importInDocument/postProcess");
+        const ScopedDuration duration(&taskData.report.postProcessTime_ms);
         TaskProgress progress(
             taskData.progress, args.entityPostProcessProgressSize, args.entityPostProcessProgressStep
         );
         const double subPortionSize = 100. / double(taskData.seqTransferredEntity.Size());
         for (const TDF_Label& labelEntity : taskData.seqTransferredEntity) {
+            if (progress.isAbortRequested())
+                break;
+
             TaskProgress subProgress(&progress, subPortionSize);
             args.entityPostProcess(labelEntity, &subProgress);
         }
     };
-    auto fnAddModelTreeEntities = [&](const TaskData& taskData) {
+    auto fnAddModelTreeEntities = [&](TaskData& taskData) {
+        MAYO_TRACE_SCOPE("io", "IO::System::importInDocument/addModelTreeEntities");
+        const ScopedDuration duration(&taskData.report.modelTreeTime_ms);
         // Need to call Document::addEntityTreeNodeSequence() instead of addEntityTreeNode() in
         // for() loop. The former function doesn't interleave update of the model tree and emission
         // of "entity added" signal for each entity. This prevents data race to happen on the
@@ -294,62 +430,215 @@ bool System::importInDocument(const Args_ImportInDocument& args) const
         );
         taskData.messenger.clear();
     };
+    // Peak memory of the process is queried only if a report is requested, as it might be costly
+    auto fnPeakMemory = [&]() -> uint64_t {
+        return args.report ? PerformanceReport::processPeakMemory() : 0;
+    };
+    auto fnAddReportEntry = [&](TaskData& taskData) {
+        if (!args.report)
+            return;
+
+        PerformanceReport::FileEntry& entry = taskData.report;
+        entry.filepath = taskData.filepath;
+        entry.format = taskData.fileFormat;
+        entry.success = taskData.readSuccess && !taskData.seqTransferredEntity.IsEmpty();
+        entry.fileSize = filepathFileSize(taskData.filepath);
+        entry.entityCount = taskData.seqTransferredEntity.Size();
+        PerformanceReport::countShapeElements(taskData.seqTransferredEntity, &entry);
+        report.files.push_back(entry);
+    };
 
     if (listFilepath.size() == 1) { // Single file case
         TaskData taskData;
         taskData.filepath = listFilepath.front();
         taskData.progress = rootProgress;
+        const uint64_t peakMemoryAtStart = fnPeakMemory();
         ok = fnReadFile(taskData);
-        if (ok) {
+        taskData.readSuccess = ok.load();
+        if (ok.load()) {
             fnTransfer(taskData);
             fnPostProcess(taskData);
             fnAddModelTreeEntities(taskData);
         }
 
+        taskData.report.peakMemoryDelta = fnPeakMemory() - peakMemoryAtStart;
         fnDispatchMessages(taskData);
+        fnAddReportEntry(taskData);
     }
     else { // Many files case
-        std::vector<TaskData> vecTaskData;
-        vecTaskData.resize(listFilepath.size());
-
-        TaskManager childTaskManager;
-        childTaskManager.signalProgressChanged.connectSlot([&](TaskId, double) {
-            rootProgress->setValue(childTaskManager.globalProgress());
+        // TaskData isn't movable(see ConcurrentMessageCollecter), elements are constructed in place
+        std::vector<TaskData> vecTaskData(listFilepath.size());
+
+        // Child tasks share the executor of the parent task if any, so import of many files doesn't
+        // create additional threads
+        TaskManager* parentTaskManager = rootProgress->taskManager();
+        TaskManager childTaskManager(parentTaskManager ? &parentTaskManager->executor() : nullptr);
+        childTaskManager.setAbortSource(rootProgress);
+        // Report the progress of read tasks only, merge tasks are comparatively short
+        // Direct connection: current thread might be a worker thread without event loop, so slot
+        // calls queued by connectSlot() would never be delivered. TaskProgress is thread-safe
+        childTaskManager.signalProgressChanged.connect([&](TaskId, double) {
+            double sumProgress = 0.;
+            for (const TaskData& taskData : vecTaskData)
+                sumProgress += childTaskManager.progress(taskData.taskId);
+
+            rootProgress->setValue(sumProgress / double(vecTaskData.size()));
         });
 
-        // Read files
+#if OCC_VERSION_HEX >= OCC_VERSION_CHECK(7, 6, 0)
+        const bool useScratchDocuments = args.transferInScratchDocuments;
+#else
+        constexpr bool useScratchDocuments = false; // Document::copyEntities() would lose meta-data
+#endif
+        // Post-process(eg BRep meshing) has to be done after deduplication of products
+        const bool deferPostProcess = args.deduplicateProducts;
+
+        // Transfer to document, or merge the scratch document
+        // Entities are added to the model tree in one batch once all files are transferred, this
+        // avoids per-entity construction of graphics and model tree items by slots connected to
+        // Document signals
+        NCollection_Sequence<TDF_Label> seqTransferredEntity;
+        auto fnMerge = [&](TaskData& taskData) {
+            MAYO_TRACE_SCOPE("io", "IO::System::importInDocument/merge");
+            if (taskData.readSuccess && !rootProgress->isAbortRequested()) {
+                if (taskData.transferDocument) {
+                    const ScopedDuration duration(&taskData.report.transferTime_ms);
+                    taskData.seqTransferredEntity = doc->copyEntities(taskData.seqTransferredEntity);
+                }
+                else {
+                    fnTransfer(taskData);
+                    if (!deferPostProcess)
+                        fnPostProcess(taskData);
+                }
+
+                for (const TDF_Label& labelEntity : taskData.seqTransferredEntity)
+                    seqTransferredEntity.Append(labelEntity);
+            }
+
+            taskData.transferDocument.Nullify(); // Release scratch document
+            fnDispatchMessages(taskData);
+        };
+
+        // Read files, also transfer them in scratch documents if enabled
+        // Each read task is followed by a merge task, merge tasks are chained as they all write
+        // into the target document. This way a file is merged as soon as it's read and merged files
+        // don't wait for the ones still being read
+        TaskId lastMergeTaskId = TaskId_null;
+        std::vector<TaskId> vecTaskId;
         for (TaskData& taskData : vecTaskData) {
             taskData.filepath = listFilepath[&taskData - &vecTaskData.front()];
+            if (useScratchDocuments)
+                taskData.transferDocument = Document::newScratch();
+
             taskData.taskId = childTaskManager.newTask([&](TaskProgress* progressChild) {
                 taskData.progress = progressChild;
+                const uint64_t peakMemoryAtStart = fnPeakMemory();
                 taskData.readSuccess = fnReadFile(taskData);
+                if (taskData.readSuccess && taskData.transferDocument) {
+                    {
+                        std::unique_lock<std::mutex> lock(unsafeTransferMutex(), std::defer_lock);
+                        if (!isConcurrentTransferSafe(taskData.fileFormat))
+                            lock.lock();
+
+                        fnTransfer(taskData);
+                    }
+
+                    if (!deferPostProcess)
+                        fnPostProcess(taskData);
+                }
+
+                taskData.report.peakMemoryDelta = fnPeakMemory() - peakMemoryAtStart;
             });
+            lastMergeTaskId = childTaskManager.newTask(
+                [&](TaskProgress*) { fnMerge(taskData); }, { taskData.taskId, lastMergeTaskId }
+            );
+            vecTaskId.push_back(taskData.taskId);
+            vecTaskId.push_back(lastMergeTaskId);
         }
 
-        for (const TaskData& taskData : vecTaskData)
-            childTaskManager.run(taskData.taskId, TaskAutoDestroy::Off);
+        for (TaskId taskId : vecTaskId)
+            childTaskManager.run(taskId, TaskAutoDestroy::Off);
 
-        // Transfer to document
-        auto taskDataCount = static_cast<int>(vecTaskData.size());
-        while (taskDataCount > 0 && !rootProgress->isAbortRequested()) {
-            auto it = std::find_if(vecTaskData.begin(), vecTaskData.end(), [&](const TaskData& taskData) {
-                return !taskData.transferred && childTaskManager.waitForDone(taskData.taskId, 25);
-            });
+        childTaskManager.waitForDone(lastMergeTaskId);
+
+        if (args.deduplicateProducts && !rootProgress->isAbortRequested()) {
+            MAYO_TRACE_SCOPE("io", "IO::System::importInDocument/deduplicateProducts");
+            XCaf::DeduplicateProductsResult dedup;
+            {
+                const ScopedDuration duration(&report.deduplicationTime_ms);
+                dedup = doc->xcaf().deduplicateProducts(seqTransferredEntity);
+            }
+
+            if (dedup.duplicateCount > 0) {
+                messenger->info() << fmt::format(
+                    textIdTr("{} duplicated product(s) out of {} now shared, about {} KB of BRep data saved"),
+                    dedup.duplicateCount, dedup.productCount, dedup.savedMemorySize / 1024
+                );
+            }
 
-            if (it != vecTaskData.end()) {
-                if (it->readSuccess) {
-                    fnTransfer(*it);
-                    fnPostProcess(*it);
-                    fnAddModelTreeEntities(*it);
+            // Entities may share products now, so post-process(eg meshing) is done once for them
+            // Entities sharing products are post-processed one after another in the same task, so
+            // shared shapes are never post-processed concurrently
+            std::vector<TDF_Label> vecPostProcessEntity;
+            std::vector<TaskData*> vecPostProcessTaskData; // Indexed by post-processed entity
+            for (TaskData& taskData : vecTaskData) {
+                if (!fnEntityPostProcessRequired(taskData.fileFormat))
+                    continue;
+
+                for (const TDF_Label& labelEntity : taskData.seqTransferredEntity) {
+                    vecPostProcessEntity.push_back(labelEntity);
+                    vecPostProcessTaskData.push_back(&taskData);
                 }
+            }
 
-                fnDispatchMessages(*it);
-                --taskDataCount;
+            TaskProgress progress(
+                rootProgress, args.entityPostProcessProgressSize, args.entityPostProcessProgressStep
+            );
+            const double subPortionSize = 100. / double(std::max<size_t>(vecPostProcessEntity.size(), 1));
+            // Durations are accumulated by entity, TaskData objects are then updated sequentially
+            std::vector<double> vecPostProcessTime_ms(vecPostProcessEntity.size(), 0.);
+            std::vector<TaskId> vecPostProcessTaskId;
+            for (std::vector<size_t>& vecIndex : groupEntitiesSharingProducts(vecPostProcessEntity)) {
+                const TaskId taskId = childTaskManager.newTask([&, vecIndex = std::move(vecIndex)](TaskProgress*) {
+                    for (size_t index : vecIndex) {
+                        if (progress.isAbortRequested())
+                            break;
+
+                        const ScopedDuration duration(&vecPostProcessTime_ms.at(index));
+                        TaskProgress subProgress(&progress, subPortionSize);
+                        args.entityPostProcess(vecPostProcessEntity.at(index), &subProgress);
+                    }
+                });
+                vecPostProcessTaskId.push_back(taskId);
             }
-        } // endwhile
+
+            const TaskId postProcessTaskId = childTaskManager.newTaskWhenAll(vecPostProcessTaskId);
+            for (TaskId taskId : vecPostProcessTaskId)
+                childTaskManager.run(taskId, TaskAutoDestroy::Off);
+
+            childTaskManager.run(postProcessTaskId, TaskAutoDestroy::Off);
+            childTaskManager.waitForDone(postProcessTaskId);
+            for (size_t i = 0; i < vecPostProcessTime_ms.size(); ++i)
+                vecPostProcessTaskData.at(i)->report.postProcessTime_ms += vecPostProcessTime_ms.at(i);
+        }
+
+        double modelTreeTime_ms = 0.;
+        {
+            MAYO_TRACE_SCOPE("io", "IO::System::importInDocument/addModelTreeEntities");
+            const ScopedDuration duration(&modelTreeTime_ms);
+            doc->addEntityTreeNodeSequence(seqTransferredEntity);
+        }
+
+        // Model tree is updated in one batch, its duration is apportioned by entity count
+        for (TaskData& taskData : vecTaskData) {
+            const double entityRatio =
+                double(taskData.seqTransferredEntity.Size()) / double(std::max(seqTransferredEntity.Size(), 1));
+            taskData.report.modelTreeTime_ms = modelTreeTime_ms * entityRatio;
+            fnAddReportEntry(taskData);
+        }
     }
 
-    return ok;
+    return ok.load();
 }
 
 System::Operation_ImportInDocument System::importInDocument() const
@@ -361,16 +650,45 @@ bool System::exportApplicationItems(const Args_ExportApplicationItems& args) con
 {
     TaskProgress* progress = args.progress ? args.progress : &TaskProgress::null();
     MessageCollecter msgCollect;
+    PerformanceReport::FileEntry reportEntry;
+    reportEntry.filepath = args.targetFilepath;
+    reportEntry.format = args.targetFormat;
     auto fnError = [&](std::string_view errorMsg) {
         msgCollect.error() << errorMsg;
         return false;
     };
 
+    const uint64_t peakMemoryAtStart = args.report ? PerformanceReport::processPeakMemory() : 0;
+    const auto timeAtStart = std::chrono::steady_clock::now();
     auto _ = gsl::finally([&]{
         Messenger* messenger = args.messenger ? args.messenger : &Messenger::null();
         const std::string strFilepath = args.targetFilepath.u8string();
         dispatchWarnings(fmt::format("Warning(s) during export to '{}'", strFilepath), msgCollect, messenger);
         dispatchErrors(fmt::format("Errors(s) during export to '{}'", strFilepath), msgCollect, messenger);
+        if (args.report) {
+            System::visitUniqueItems(args.applicationItems, [&](const ApplicationItem& item) {
+                NCollection_Sequence<TDF_Label> seqEntity;
+                if (item.isDocument()) {
+                    for (TreeNodeId entityNodeId : item.document()->allEntityNodeIds())
+                        seqEntity.Append(item.document()->modelTreeNodeLabel(entityNodeId));
+                }
+                else if (item.isDocumentTreeNode()) {
+                    seqEntity.Append(item.documentTreeNode().label());
+                }
+
+                reportEntry.entityCount += seqEntity.Size();
+                PerformanceReport::countShapeElements(seqEntity, &reportEntry);
+            });
+            reportEntry.fileSize = reportEntry.success ? filepathFileSize(args.targetFilepath) : 0;
+            reportEntry.peakMemoryDelta = PerformanceReport::processPeakMemory() - peakMemoryAtStart;
+            PerformanceReport report;
+            report.files.push_back(reportEntry);
+            report.totalTime_ms = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - timeAtStart
+            ).count();
+            report.peakMemoryDelta = reportEntry.peakMemoryDelta;
+            *args.report = std::move(report);
+        }
     });
 
     std::unique_ptr<Writer> writer = this->createWriter(args.targetFormat);
@@ -380,19 +698,27 @@ bool System::exportApplicationItems(const Args_ExportApplicationItems& args) con
     writer->setMessenger(&msgCollect);
     writer->applyProperties(args.parameters);
     {
+        MAYO_TRACE_SCOPE("io", "Writer::transfer");
+        const ScopedDuration duration(&reportEntry.transferTime_ms);
         TaskProgress transferProgress(progress, 40, textIdTr("Transfer"));
         const bool okTransfer = writer->transfer(args.applicationItems, &transferProgress);
         if (!okTransfer)
             return fnError(textIdTr("File transfer problem"));
     }
 
+    if (progress->isAbortRequested())
+        return false;
+
     {
+        MAYO_TRACE_SCOPE("io", "Writer::writeFile");
+        const ScopedDuration duration(&reportEntry.writeTime_ms);
         TaskProgress writeProgress(progress, 60, textIdTr("Write"));
         const bool okWriteFile = writer->writeFile(args.targetFilepath, &writeProgress);
         if (!okWriteFile)
             return fnError(textIdTr("File write problem"));
     }
 
+    reportEntry.success = true;
     return true;
 }
 
@@ -446,6 +772,13 @@ System::Operation_ExportApplicationItems::withTaskProgress(TaskProgress* progres
     return *this;
 }
 
+System::Operation_ExportApplicationItems&
+System::Operation_ExportApplicationItems::withPerformanceReport(PerformanceReport* report)
+{
+    m_args.report = report;
+    return *this;
+}
+
 bool System::Operation_ExportApplicationItems::execute()
 {
     return m_system.exportApplicationItems(m_args);
@@ -507,6 +840,21 @@ void System::traverseUniqueItems(
     });
 }
 
+void System::traverseUniqueItemsWithLocation(
+        gsl::span<const ApplicationItem> spanItem,
+        std::function<void(const DocumentTreeNode&, const TopLoc_Location&)> fnCallback
+    )
+{
+    System::visitUniqueItems(spanItem, [=](const ApplicationItem& item) {
+        const DocumentPtr doc = item.document();
+        auto fnNodeCallback = [&](TreeNodeId id, const TopLoc_Location& loc) { fnCallback({ doc, id }, loc); };
+        if (item.isDocument())
+            XCaf::traverseTreeWithLocation(doc->modelTree(), fnNodeCallback);
+        else if (item.isDocumentTreeNode())
+            XCaf::traverseTreeWithLocation(doc->modelTree(), item.documentTreeNode().id(), fnNodeCallback);
+    });
+}
+
 System::Operation_ImportInDocument&
 System::Operation_ImportInDocument::targetDocument(const DocumentPtr& document)
 {
@@ -570,6 +918,27 @@ System::Operation_ImportInDocument::withEntityPostProcessInfoProgress(int progre
     return *this;
 }
 
+System::Operation_ImportInDocument::Operation&
+System::Operation_ImportInDocument::withTransferInScratchDocuments(bool on)
+{
+    m_args.transferInScratchDocuments = on;
+    return *this;
+}
+
+System::Operation_ImportInDocument::Operation&
+System::Operation_ImportInDocument::withProductDeduplication(bool on)
+{
+    m_args.deduplicateProducts = on;
+    return *this;
+}
+
+System::Operation_ImportInDocument::Operation&
+System::Operation_ImportInDocument::withPerformanceReport(PerformanceReport* report)
+{
+    m_args.report = report;
+    return *this;
+}
+
 bool System::Operation_ImportInDocument::execute()
 {
     return m_system.importInDocument(m_args);
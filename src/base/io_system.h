@@ -8,9 +8,11 @@
 #include "application_item.h"
 #include "filepath.h"
 #include "io_format.h"
+#include "io_performance_report.h"
 #include "io_reader.h"
 #include "io_writer.h"
 #include "libtree.h"
+#include "libtree_parallel.h"
 #include "property.h"
 #include "text_id.h"
 
@@ -89,11 +91,28 @@ public:
         // Optional: title of the whole post-process operation
         std::string entityPostProcessProgressStep;
 
+        // Optional: when importing many files, transfer each file in its own scratch document(see
+        //           Document::newScratch()) so that transfers run concurrently. Scratch documents
+        //           are then merged into target document, which is the only serialized step
+        //           Only BRep, OFF, PLY and STL files are transferred concurrently, readers of other
+        //           formats depend on OpenCascade global state so their transfers are serialized
+        //           Requires OpenCascade >= 7.6, otherwise files are transferred one after another
+        bool transferInScratchDocuments = false;
+
+        // Optional: when importing many files, products duplicated across files(eg standard parts)
+        //           are turned into references to a single product(see XCaf::deduplicateProducts())
+        //           Entity post-process is then done after deduplication
+        bool deduplicateProducts = false;
+
         // Optional: the messenger object used to report any additional infos, warnings and errors
         Messenger* messenger = nullptr;
 
         // Optional: the indicator object used to report progress of the import operation
         TaskProgress* progress = nullptr;
+
+        // Optional: receives stage timings and memory figures of the import operation, one entry
+        //           per file in `filepaths`
+        PerformanceReport* report = nullptr;
     };
     bool importInDocument(const Args_ImportInDocument& args) const;
 
@@ -120,6 +139,10 @@ public:
 
         // Optional: the indicator object used to report progress of the import operation
         TaskProgress* progress = nullptr;
+
+        // Optional: receives stage timings and memory figures of the export operation, a single
+        //           entry for `targetFilepath`
+        PerformanceReport* report = nullptr;
     };
     bool exportApplicationItems(const Args_ExportApplicationItems& args) const;
 
@@ -139,9 +162,12 @@ public:
         Operation& withEntityPostProcess(std::function<void(TDF_Label, TaskProgress*)> fn);
         Operation& withEntityPostProcessRequiredIf(std::function<bool(Format)> fn);
         Operation& withEntityPostProcessInfoProgress(int progressSize, std::string_view progressStep);
+        Operation& withTransferInScratchDocuments(bool on);
+        Operation& withProductDeduplication(bool on);
 
         Operation& withMessenger(Messenger* messenger);
         Operation& withTaskProgress(TaskProgress* progress);
+        Operation& withPerformanceReport(PerformanceReport* report);
         bool execute(); // Runs System::importInDocument() function
 
     private:
@@ -167,6 +193,7 @@ public:
         Operation& withParameters(const PropertyGroup* parameters);
         Operation& withMessenger(Messenger* messenger);
         Operation& withTaskProgress(TaskProgress* progress);
+        Operation& withPerformanceReport(PerformanceReport* report);
         bool execute(); // Runs System::exportApplicationItems() function
 
     private:
@@ -194,6 +221,27 @@ public:
             TreeTraversal mode = TreeTraversal::PreOrder
     );
 
+    // Same as traverseUniqueItems() with pre-order traversal, but `fnCallback` also receives the
+    // absolute location of the tree node shape(see XCaf::traverseTreeWithLocation())
+    static void traverseUniqueItemsWithLocation(
+            gsl::span<const ApplicationItem> spanItem,
+            std::function<void(const DocumentTreeNode&, const TopLoc_Location&)> fnCallback
+    );
+
+    // Same as traverseUniqueItems() but tree nodes are visited concurrently by the threads of
+    // `executor` and reduced to a single value(see traverseTree_parallelReduce())
+    // `fnMap` returns the value associated to a DocumentTreeNode, `fnReduce` combines two values.
+    // Both must be thread-safe, `fnReduce` must also be associative and commutative
+    // Tree nodes are visited sequentially in pre-order if `executor` is null
+    template<typename R, typename MapFn, typename ReduceFn>
+    static R reduceUniqueItemsParallel(
+            gsl::span<const ApplicationItem> spanItem,
+            const R& identity,
+            const MapFn& fnMap,
+            const ReduceFn& fnReduce,
+            TaskExecutor* executor
+    );
+
     // Implementation
 private:
     std::vector<FormatProbe> m_vecFormatProbe;
@@ -213,5 +261,43 @@ Format probeFormat_PLY(const System::FormatProbeInput& input);
 Format probeFormat_OFF(const System::FormatProbeInput& input);
 void addPredefinedFormatProbes(System* system);
 
+// --
+// -- Implementation
+// --
+
+template<typename R, typename MapFn, typename ReduceFn>
+R System::reduceUniqueItemsParallel(
+        gsl::span<const ApplicationItem> spanItem,
+        const R& identity,
+        const MapFn& fnMap,
+        const ReduceFn& fnReduce,
+        TaskExecutor* executor)
+{
+    R result = identity;
+    System::visitUniqueItems(spanItem, [&](const ApplicationItem& item) {
+        const DocumentPtr doc = item.document();
+        const Tree<TDF_Label>& modelTree = doc->modelTree();
+        auto fnNodeMap = [&](TreeNodeId id) { return fnMap(DocumentTreeNode(doc, id)); };
+        if (executor) {
+            R itemResult =
+                item.isDocument() ?
+                    traverseTree_parallelReduce(modelTree, identity, fnNodeMap, fnReduce, *executor) :
+                    traverseTree_parallelReduce(
+                        item.documentTreeNode().id(), modelTree, identity, fnNodeMap, fnReduce, *executor
+                    );
+            result = fnReduce(std::move(result), std::move(itemResult));
+        }
+        else {
+            auto fnNodeReduce = [&](TreeNodeId id) { result = fnReduce(std::move(result), fnNodeMap(id)); };
+            if (item.isDocument())
+                traverseTree_preOrder(modelTree, fnNodeReduce);
+            else
+                traverseTree_preOrder(item.documentTreeNode().id(), modelTree, fnNodeReduce);
+        }
+    });
+
+    return result;
+}
+
 } // namespace IO
 } // namespace Mayo
@@ -7,6 +7,7 @@
 
 #include "caf_utils.h"
 #include "brep_utils.h"
+#include "document.h"
 #include "triangulation_annex_data.h"
 #include "point_cloud_data.h"
 #include "xcaf.h"
@@ -14,6 +15,15 @@
 namespace Mayo {
 
 LabelDataFlags findLabelDataFlags(const TDF_Label& label)
+{
+    if (label.IsNull())
+        return LabelData_None;
+
+    const DocumentPtr doc = Document::findFrom(label);
+    return doc ? doc->labelDataFlags(label) : computeLabelDataFlags(label);
+}
+
+LabelDataFlags computeLabelDataFlags(const TDF_Label& label)
 {
     LabelDataFlags flags = LabelData_None;
 
@@ -36,4 +46,14 @@ LabelDataFlags findLabelDataFlags(const TDF_Label& label)
     return flags;
 }
 
+void invalidateLabelDataFlags(const TDF_Label& label)
+{
+    if (label.IsNull())
+        return;
+
+    const DocumentPtr doc = Document::findFrom(label);
+    if (doc)
+        doc->invalidateLabelDataFlags(label);
+}
+
 } // namespace Mayo
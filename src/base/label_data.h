@@ -24,6 +24,18 @@ enum LabelData {
 };
 using LabelDataFlags = unsigned;
 
+// Returns the data flags of 'label'
+// Flags are read from the cache of the Document owning 'label'(see Document::labelDataFlags()) if
+// any, otherwise they are computed on the fly
+// This function modifies neither 'label' nor the cache, so it can be called concurrently as long as
+// the document isn't modified meanwhile
 LabelDataFlags findLabelDataFlags(const TDF_Label& label);
 
+// Computes the data flags of 'label', cache is ignored
+LabelDataFlags computeLabelDataFlags(const TDF_Label& label);
+
+// Removes the cached data flags of 'label' from the Document owning 'label'
+// Must be called when the shape or the data attributes(eg PointCloudData) of 'label' are changed
+void invalidateLabelDataFlags(const TDF_Label& label);
+
 } // namespace Mayo
@@ -8,13 +8,26 @@
 #include <gsl/span>
 #include <algorithm>
 #include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace Mayo {
 
 // Tree node identifier type
+// The low bits hold the index(one-based) of the node slot in the tree, the high bits hold the
+// generation of that slot(see Tree)
 using TreeNodeId = uint32_t;
 
+// Memory layout of the nodes of a Tree object
+enum class TreeLayout {
+    // Links(parent, children, siblings), data and state of a node are stored together
+    ArrayOfStructs,
+    // Each link field is stored in its own array, separately from node data
+    // Preferable for big trees being traversed often : pre-order traversal then only loads the
+    // compact "first child" and "next sibling" arrays instead of whole nodes with their data
+    StructOfArrays
+};
+
 // Provides tree-like organization of data
 //
 // A tree node satisfies the following properties:
@@ -24,12 +37,19 @@ using TreeNodeId = uint32_t;
 //     * has 0..N child tree nodes. A tree node is a leaf in case it has no child
 //     * owns data of any type, though data type is the same for all nodes of the same tree
 //
-// Storage of nodes and associated data is memory efficient : all nodes are stored in a single array
+// Storage of nodes and associated data is memory efficient : all nodes are stored in contiguous
+// arrays(see TreeLayout). Slots of removed nodes are reused by nodes appended afterwards, so the
+// storage doesn't grow along add/remove cycles. Each slot has a generation counter incremented when
+// its node is removed and which is part of the node identifier : a TreeNodeId kept outside of the
+// tree can't silently refer to another node, it's just reported as deleted(see isNodeDeleted())
+// A slot whose generation reached the maximum value is never reused
+// compact() can be called to release the slots of removed nodes, but it renumbers the remaining
+// nodes
 // Use the traverseTree_() family of functions to visit nodes of a Tree object
 //
 // Data type 'T' must be default-constructible(see https://www.cplusplus.com/reference/type_traits/is_default_constructible/)
 //
-template<typename T> class Tree {
+template<typename T, TreeLayout Layout = TreeLayout::ArrayOfStructs> class Tree {
 public:
     Tree();
 
@@ -60,10 +80,14 @@ public:
     // Is node of identifier 'id' a leaf? Note: a leaf as no child nodes
     bool nodeIsLeaf(TreeNodeId id) const;
 
+    // Is node of identifier 'id' invalid or removed from the tree?
+    bool isNodeDeleted(TreeNodeId id) const;
+
     // Read-only array of all the roots
     gsl::span<const TreeNodeId> roots() const;
 
     // Removes all nodes, tree will become empty
+    // Slots are kept for reuse, so identifiers of the removed nodes remain invalid
     void clear();
 
     // Appends child to node identified by 'parentId'. That new node will contain 'data'
@@ -71,43 +95,82 @@ public:
     TreeNodeId appendChild(TreeNodeId parentId, T&& data);
 
     // Remove root node identified by 'id'
+    // Data of the removed nodes is released, their slots are kept as "deleted" until reused by
+    // appendChild() or released by compact()
     void removeRoot(TreeNodeId id);
 
-    // Total count of nodes in the tree, this includes also nodes marked as "deleted" but not yet
-    // destroyed from the tree
+    // Releases the slots of removed nodes, remaining nodes are renumbered keeping their relative order
+    // Returns the mapping from old to new identifiers of the remaining nodes. Any code keeping
+    // TreeNodeId values of this tree must be remapped, so it's meant for trees whose identifiers
+    // aren't shared
+    std::unordered_map<TreeNodeId, TreeNodeId> compact();
+
+    // Total count of node slots in the tree, this includes also the slots of nodes marked as
+    // "deleted" not yet reused
     size_t nodeCount() const;
 
+    // Count of slots of nodes marked as "deleted" not yet reused
+    size_t deletedNodeCount() const;
+
 private:
+    enum Link {
+        Link_SiblingPrevious, Link_SiblingNext, Link_ChildFirst, Link_ChildLast, Link_Parent, Link_Count
+    };
+
     struct TreeNode {
-        TreeNodeId siblingPrevious;
-        TreeNodeId siblingNext;
-        TreeNodeId childFirst;
-        TreeNodeId childLast;
-        TreeNodeId parent;
+        TreeNodeId links[Link_Count];
         T data;
         bool isDeleted;
+        uint8_t generation;
     };
 
-    template<typename U, typename FN>
-    friend void traverseTree_unorder(const Tree<U>& tree, const FN& callback);
+    // Layout of TreeNodeId: slot index in low bits, generation in high bits
+    static constexpr unsigned SlotIndexBits = 26;
+    static constexpr TreeNodeId SlotIndexMask = (TreeNodeId(1) << SlotIndexBits) - 1;
+    static constexpr uint8_t MaxGeneration = (1 << (32 - SlotIndexBits)) - 1;
+    static size_t slotIndex(TreeNodeId id) { return (id & SlotIndexMask) - 1; }
+    static uint8_t idGeneration(TreeNodeId id) { return uint8_t(id >> SlotIndexBits); }
 
-    template<typename U, typename FN>
-    friend void traverseTree_preOrder(TreeNodeId node, const Tree<U>& tree, const FN& callback);
+    template<typename U, TreeLayout L, typename FN>
+    friend void traverseTree_unorder(const Tree<U, L>& tree, const FN& callback);
 
-    template<typename U, typename FN>
-    friend void traverseTree_postOrder(TreeNodeId node, const Tree<U>& tree, const FN& callback);
+    template<typename U, TreeLayout L, typename FN>
+    friend void traverseTree_preOrder(TreeNodeId node, const Tree<U, L>& tree, const FN& callback);
 
-    template<typename U, typename FN>
-    friend void visitDirectChildren(TreeNodeId id, const Tree<U>& tree, const FN& callback);
+    template<typename U, TreeLayout L, typename FN>
+    friend void traverseTree_postOrder(TreeNodeId node, const Tree<U, L>& tree, const FN& callback);
 
-    TreeNodeId lastNodeId() const;
-    TreeNode* ptrNode(TreeNodeId id);
-    const TreeNode* ptrNode(TreeNodeId id) const;
-    TreeNode* appendChild(TreeNodeId parentId);
-    bool isNodeDeleted(TreeNodeId id) const;
+    template<typename U, TreeLayout L, typename FN>
+    friend void visitDirectChildren(TreeNodeId id, const Tree<U, L>& tree, const FN& callback);
+
+    bool isValidNodeId(TreeNodeId id) const;
+    void setNodeDeleted(TreeNodeId id, bool on);
+    bool isSlotDeleted(size_t index) const;
+    uint8_t slotGeneration(size_t index) const;
+    void setSlotGeneration(size_t index, uint8_t generation);
+    TreeNodeId slotNodeId(size_t index) const;
+
+    // Access to the link fields and data of node 'id', which must be valid
+    TreeNodeId link(TreeNodeId id, Link which) const;
+    void setLink(TreeNodeId id, Link which, TreeNodeId value);
+    T& dataRef(TreeNodeId id);
 
+    TreeNodeId allocateNode();
+    void linkNode(TreeNodeId id, TreeNodeId parentId);
+    void moveNode(TreeNodeId fromId, TreeNodeId toId);
+    void resizeNodes(size_t count);
+
+    // TreeLayout::ArrayOfStructs storage
     std::vector<TreeNode> m_vecNode;
+    // TreeLayout::StructOfArrays storage
+    std::vector<TreeNodeId> m_vecLink[Link_Count];
+    std::vector<T> m_vecData;
+    std::vector<uint8_t> m_vecDeleted;
+    std::vector<uint8_t> m_vecGeneration;
+
     std::vector<TreeNodeId> m_vecRoot;
+    std::vector<size_t> m_vecFreeSlotIndex; // Slots of removed nodes that can be reused
+    size_t m_deletedNodeCount = 0;
 };
 
 enum class TreeTraversal {
@@ -115,67 +178,62 @@ enum class TreeTraversal {
 };
 
 // Fastest tree traversal, but nodes are visited unordered
-template<typename T, typename FN>
-void traverseTree_unorder(const Tree<T>& tree, const FN& callback);
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_unorder(const Tree<T, L>& tree, const FN& callback);
 
-template<typename T, typename FN>
-void traverseTree_preOrder(const Tree<T>& tree, const FN& callback);
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_preOrder(const Tree<T, L>& tree, const FN& callback);
 
-template<typename T, typename FN>
-void traverseTree_preOrder(TreeNodeId id, const Tree<T>& tree, const FN& callback);
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_preOrder(TreeNodeId id, const Tree<T, L>& tree, const FN& callback);
 
-template<typename T, typename FN>
-void traverseTree_postOrder(const Tree<T>& tree, const FN& callback);
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_postOrder(const Tree<T, L>& tree, const FN& callback);
 
-template<typename T, typename FN>
-void traverseTree_postOrder(TreeNodeId id, const Tree<T>& tree, const FN& callback);
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_postOrder(TreeNodeId id, const Tree<T, L>& tree, const FN& callback);
 
-template<typename T, typename FN>
-void traverseTree(const Tree<T>& tree, const FN& callback, TreeTraversal mode = TreeTraversal::PreOrder);
+template<typename T, TreeLayout L, typename FN>
+void traverseTree(const Tree<T, L>& tree, const FN& callback, TreeTraversal mode = TreeTraversal::PreOrder);
 
-template<typename T, typename FN>
-void traverseTree(TreeNodeId id, const Tree<T>& tree, const FN& callback, TreeTraversal mode = TreeTraversal::PreOrder);
+template<typename T, TreeLayout L, typename FN>
+void traverseTree(TreeNodeId id, const Tree<T, L>& tree, const FN& callback, TreeTraversal mode = TreeTraversal::PreOrder);
 
-template<typename U, typename FN>
-void visitDirectChildren(TreeNodeId id, const Tree<U>& tree, const FN& callback);
+template<typename U, TreeLayout L, typename FN>
+void visitDirectChildren(TreeNodeId id, const Tree<U, L>& tree, const FN& callback);
 
 // --
 // -- Implementation
 // --
 
-template<typename T> Tree<T>::Tree() = default;
+template<typename T, TreeLayout L> Tree<T, L>::Tree() = default;
 
-template<typename T> TreeNodeId Tree<T>::nodeSiblingPrevious(TreeNodeId id) const
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::nodeSiblingPrevious(TreeNodeId id) const
 {
-    const TreeNode* node = this->ptrNode(id);
-    return node ? node->siblingPrevious : 0;
+    return this->isValidNodeId(id) ? this->link(id, Link_SiblingPrevious) : 0;
 }
 
-template<typename T> TreeNodeId Tree<T>::nodeSiblingNext(TreeNodeId id) const
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::nodeSiblingNext(TreeNodeId id) const
 {
-    const TreeNode* node = this->ptrNode(id);
-    return node ? node->siblingNext : 0;
+    return this->isValidNodeId(id) ? this->link(id, Link_SiblingNext) : 0;
 }
 
-template<typename T> TreeNodeId Tree<T>::nodeChildFirst(TreeNodeId id) const
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::nodeChildFirst(TreeNodeId id) const
 {
-    const TreeNode* node = this->ptrNode(id);
-    return node ? node->childFirst : 0;
+    return this->isValidNodeId(id) ? this->link(id, Link_ChildFirst) : 0;
 }
 
-template<typename T> TreeNodeId Tree<T>::nodeChildLast(TreeNodeId id) const
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::nodeChildLast(TreeNodeId id) const
 {
-    const TreeNode* node = this->ptrNode(id);
-    return node ? node->childLast : 0;
+    return this->isValidNodeId(id) ? this->link(id, Link_ChildLast) : 0;
 }
 
-template<typename T> TreeNodeId Tree<T>::nodeParent(TreeNodeId id) const
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::nodeParent(TreeNodeId id) const
 {
-    const TreeNode* node = this->ptrNode(id);
-    return node ? node->parent : 0;
+    return this->isValidNodeId(id) ? this->link(id, Link_Parent) : 0;
 }
 
-template<typename T> TreeNodeId Tree<T>::nodeRoot(TreeNodeId id) const
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::nodeRoot(TreeNodeId id) const
 {
     if (id == 0)
         return 0;
@@ -186,125 +244,296 @@ template<typename T> TreeNodeId Tree<T>::nodeRoot(TreeNodeId id) const
     return id;
 }
 
-template<typename T> const T& Tree<T>::nodeData(TreeNodeId id) const
+template<typename T, TreeLayout L> const T& Tree<T, L>::nodeData(TreeNodeId id) const
 {
     static const T nullObject = {};
-    const TreeNode* node = this->ptrNode(id);
-    return node ? node->data : nullObject;
+    if (!this->isValidNodeId(id))
+        return nullObject;
+
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        return m_vecNode[slotIndex(id)].data;
+    else
+        return m_vecData[slotIndex(id)];
 }
 
-template<typename T> bool Tree<T>::nodeIsRoot(TreeNodeId id) const
+template<typename T, TreeLayout L> bool Tree<T, L>::nodeIsRoot(TreeNodeId id) const
 {
-    const TreeNode* node = this->ptrNode(id);
-    return node ? node->parent == 0 : false;
+    return this->isValidNodeId(id) ? this->link(id, Link_Parent) == 0 : false;
 }
 
-template<typename T> bool Tree<T>::nodeIsLeaf(TreeNodeId id) const
+template<typename T, TreeLayout L> bool Tree<T, L>::nodeIsLeaf(TreeNodeId id) const
 {
     return this->nodeChildFirst(id) == 0;
 }
 
-template<typename T> void Tree<T>::clear()
+template<typename T, TreeLayout L> void Tree<T, L>::clear()
 {
-    m_vecNode.clear();
-    m_vecRoot.clear();
+    while (!m_vecRoot.empty())
+        this->removeRoot(m_vecRoot.back());
 }
 
-template<typename T>
-TreeNodeId Tree<T>::appendChild(TreeNodeId parentId, const T& data)
+template<typename T, TreeLayout L>
+TreeNodeId Tree<T, L>::appendChild(TreeNodeId parentId, const T& data)
 {
-    TreeNode* node = this->appendChild(parentId);
-    node->data = data;
-    return this->lastNodeId();
+    const TreeNodeId nodeId = this->allocateNode();
+    this->dataRef(nodeId) = data;
+    this->linkNode(nodeId, parentId);
+    return nodeId;
 }
 
-template<typename T>
-TreeNodeId Tree<T>::appendChild(TreeNodeId parentId, T&& data)
+template<typename T, TreeLayout L>
+TreeNodeId Tree<T, L>::appendChild(TreeNodeId parentId, T&& data)
 {
-    TreeNode* node = this->appendChild(parentId);
-    node->data = std::move(data);
-    return this->lastNodeId();
+    const TreeNodeId nodeId = this->allocateNode();
+    this->dataRef(nodeId) = std::move(data);
+    this->linkNode(nodeId, parentId);
+    return nodeId;
 }
 
-template<typename T>
-typename Tree<T>::TreeNode* Tree<T>::appendChild(TreeNodeId parentId)
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::allocateNode()
 {
-    m_vecNode.push_back({});
-    const TreeNodeId nodeId = this->lastNodeId();
-    TreeNode* node = &m_vecNode.back();
-    node->parent = parentId;
-    node->siblingPrevious = this->nodeChildLast(parentId);
-    if (parentId != 0) {
-        TreeNode* parentNode = this->ptrNode(parentId);
-        if (parentNode->childFirst == 0)
-            parentNode->childFirst = nodeId;
+    if (m_vecFreeSlotIndex.empty()) {
+        Expects(this->nodeCount() < SlotIndexMask);
+        this->resizeNodes(this->nodeCount() + 1);
+        return static_cast<TreeNodeId>(this->nodeCount());
+    }
 
-        if (parentNode->childLast != 0)
-            this->ptrNode(parentNode->childLast)->siblingNext = nodeId;
+    // Reuse slot of a removed node, generation was already incremented by removeRoot()
+    const size_t index = m_vecFreeSlotIndex.back();
+    m_vecFreeSlotIndex.pop_back();
+    --m_deletedNodeCount;
+    const TreeNodeId id = this->slotNodeId(index);
+    for (int i = 0; i < Link_Count; ++i)
+        this->setLink(id, Link(i), 0);
 
-        parentNode->childLast = nodeId;
+    this->setNodeDeleted(id, false);
+    return id;
+}
+
+template<typename T, TreeLayout L> void Tree<T, L>::linkNode(TreeNodeId id, TreeNodeId parentId)
+{
+    this->setLink(id, Link_Parent, parentId);
+    if (parentId != 0) {
+        const TreeNodeId lastChildId = this->link(parentId, Link_ChildLast);
+        this->setLink(id, Link_SiblingPrevious, lastChildId);
+        if (lastChildId != 0)
+            this->setLink(lastChildId, Link_SiblingNext, id);
+        else
+            this->setLink(parentId, Link_ChildFirst, id);
+
+        this->setLink(parentId, Link_ChildLast, id);
     }
     else {
-        m_vecRoot.push_back(nodeId);
+        m_vecRoot.push_back(id);
     }
+}
 
-    return node;
+template<typename T, TreeLayout L> bool Tree<T, L>::isValidNodeId(TreeNodeId id) const
+{
+    const size_t index = slotIndex(id);
+    return (id & SlotIndexMask) != 0
+           && index < this->nodeCount()
+           && idGeneration(id) == this->slotGeneration(index);
 }
 
-template<typename T> bool Tree<T>::isNodeDeleted(TreeNodeId id) const
+template<typename T, TreeLayout L> bool Tree<T, L>::isNodeDeleted(TreeNodeId id) const
 {
-    const auto node = this->ptrNode(id);
-    return !node || node->isDeleted;
+    return !this->isValidNodeId(id) || this->isSlotDeleted(slotIndex(id));
 }
 
-template<typename T> void Tree<T>::removeRoot(TreeNodeId id)
+template<typename T, TreeLayout L> void Tree<T, L>::setNodeDeleted(TreeNodeId id, bool on)
 {
-    Expects(this->nodeIsRoot(id));
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        m_vecNode[slotIndex(id)].isDeleted = on;
+    else
+        m_vecDeleted[slotIndex(id)] = on ? 1 : 0;
+}
 
-    traverseTree_postOrder(id, *this, [=](TreeNodeId visitId) {
-        TreeNode* visitNode = this->ptrNode(visitId);
-        if (visitNode)
-            visitNode->isDeleted = true;
-    });
-    Expects(this->isNodeDeleted(id));
+template<typename T, TreeLayout L> bool Tree<T, L>::isSlotDeleted(size_t index) const
+{
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        return m_vecNode[index].isDeleted;
+    else
+        return m_vecDeleted[index] != 0;
+}
+
+template<typename T, TreeLayout L> uint8_t Tree<T, L>::slotGeneration(size_t index) const
+{
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        return m_vecNode[index].generation;
+    else
+        return m_vecGeneration[index];
+}
+
+template<typename T, TreeLayout L> void Tree<T, L>::setSlotGeneration(size_t index, uint8_t generation)
+{
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        m_vecNode[index].generation = generation;
+    else
+        m_vecGeneration[index] = generation;
+}
+
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::slotNodeId(size_t index) const
+{
+    return (TreeNodeId(this->slotGeneration(index)) << SlotIndexBits) | static_cast<TreeNodeId>(index + 1);
+}
+
+template<typename T, TreeLayout L> TreeNodeId Tree<T, L>::link(TreeNodeId id, Link which) const
+{
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        return m_vecNode[slotIndex(id)].links[which];
+    else
+        return m_vecLink[which][slotIndex(id)];
+}
+
+template<typename T, TreeLayout L> void Tree<T, L>::setLink(TreeNodeId id, Link which, TreeNodeId value)
+{
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        m_vecNode[slotIndex(id)].links[which] = value;
+    else
+        m_vecLink[which][slotIndex(id)] = value;
+}
+
+template<typename T, TreeLayout L> T& Tree<T, L>::dataRef(TreeNodeId id)
+{
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        return m_vecNode[slotIndex(id)].data;
+    else
+        return m_vecData[slotIndex(id)];
+}
+
+template<typename T, TreeLayout L> void Tree<T, L>::moveNode(TreeNodeId fromId, TreeNodeId toId)
+{
+    const size_t fromIndex = slotIndex(fromId);
+    const size_t toIndex = slotIndex(toId);
+    if constexpr(L == TreeLayout::ArrayOfStructs) {
+        m_vecNode[toIndex] = std::move(m_vecNode[fromIndex]);
+    }
+    else {
+        for (std::vector<TreeNodeId>& vecLink : m_vecLink)
+            vecLink[toIndex] = vecLink[fromIndex];
+
+        m_vecData[toIndex] = std::move(m_vecData[fromIndex]);
+        m_vecDeleted[toIndex] = m_vecDeleted[fromIndex];
+        m_vecGeneration[toIndex] = m_vecGeneration[fromIndex];
+    }
+}
+
+template<typename T, TreeLayout L> void Tree<T, L>::resizeNodes(size_t count)
+{
+    if constexpr(L == TreeLayout::ArrayOfStructs) {
+        m_vecNode.resize(count);
+    }
+    else {
+        for (std::vector<TreeNodeId>& vecLink : m_vecLink)
+            vecLink.resize(count, 0);
+
+        m_vecData.resize(count);
+        m_vecDeleted.resize(count, 0);
+        m_vecGeneration.resize(count, 0);
+    }
+}
+
+template<typename T, TreeLayout L> void Tree<T, L>::removeRoot(TreeNodeId id)
+{
+    Expects(this->nodeIsRoot(id));
 
     auto it = std::find(m_vecRoot.begin(), m_vecRoot.end(), id);
     if (it != m_vecRoot.end())
         m_vecRoot.erase(it);
 
-    if (m_vecRoot.empty())
-        this->clear();
+    traverseTree_postOrder(id, *this, [this](TreeNodeId visitId) {
+        this->setNodeDeleted(visitId, true);
+        this->dataRef(visitId) = T{};
+        ++m_deletedNodeCount;
+        // Invalidate identifier 'visitId', slot can then be reused unless its generation reached
+        // the maximum value
+        const size_t index = slotIndex(visitId);
+        const uint8_t generation = this->slotGeneration(index);
+        if (generation < MaxGeneration) {
+            this->setSlotGeneration(index, uint8_t(generation + 1));
+            m_vecFreeSlotIndex.push_back(index);
+        }
+    });
 }
 
-template<typename T> size_t Tree<T>::nodeCount() const
+template<typename T, TreeLayout L> std::unordered_map<TreeNodeId, TreeNodeId> Tree<T, L>::compact()
 {
-    return m_vecNode.size();
-}
+    // Identifiers(current and new one) of each alive node, indexed by slot
+    const size_t oldNodeCount = this->nodeCount();
+    std::vector<TreeNodeId> vecOldId(oldNodeCount, 0);
+    std::vector<TreeNodeId> vecNewId(oldNodeCount, 0);
+    std::unordered_map<TreeNodeId, TreeNodeId> mapNewId;
+    TreeNodeId newNodeCount = 0;
+    for (size_t index = 0; index < oldNodeCount; ++index) {
+        if (!this->isSlotDeleted(index)) {
+            vecOldId[index] = this->slotNodeId(index);
+            vecNewId[index] = ++newNodeCount;
+            mapNewId.insert({ vecOldId[index], vecNewId[index] });
+        }
+    }
 
-template<typename T> gsl::span<const TreeNodeId> Tree<T>::roots() const
-{
-    return m_vecRoot;
+    auto fnNewId = [&](TreeNodeId oldId) { return oldId != 0 ? vecNewId[slotIndex(oldId)] : 0; };
+
+    // Links of alive nodes only refer to alive nodes as removal is done per root sub-tree
+    // New slot indexes are never greater than old ones, so nodes can be moved in place
+    for (size_t index = 0; index < oldNodeCount; ++index) {
+        const TreeNodeId oldId = vecOldId[index];
+        if (oldId == 0)
+            continue;
+
+        for (int i = 0; i < Link_Count; ++i)
+            this->setLink(oldId, Link(i), fnNewId(this->link(oldId, Link(i))));
+
+        if (slotIndex(vecNewId[index]) != index)
+            this->moveNode(oldId, vecNewId[index]);
+    }
+
+    // Nodes are renumbered, generations restart from zero
+    this->resizeNodes(newNodeCount);
+    for (size_t index = 0; index < newNodeCount; ++index)
+        this->setSlotGeneration(index, 0);
+
+    if constexpr(L == TreeLayout::ArrayOfStructs) {
+        m_vecNode.shrink_to_fit();
+    }
+    else {
+        for (std::vector<TreeNodeId>& vecLink : m_vecLink)
+            vecLink.shrink_to_fit();
+
+        m_vecData.shrink_to_fit();
+        m_vecDeleted.shrink_to_fit();
+        m_vecGeneration.shrink_to_fit();
+    }
+
+    for (TreeNodeId& rootId : m_vecRoot)
+        rootId = fnNewId(rootId);
+
+    m_vecFreeSlotIndex.clear();
+    m_deletedNodeCount = 0;
+    return mapNewId;
 }
 
-template<typename T> TreeNodeId Tree<T>::lastNodeId() const
+template<typename T, TreeLayout L> size_t Tree<T, L>::nodeCount() const
 {
-    return static_cast<TreeNodeId>(m_vecNode.size());
+    if constexpr(L == TreeLayout::ArrayOfStructs)
+        return m_vecNode.size();
+    else
+        return m_vecData.size();
 }
 
-template<typename T>
-typename Tree<T>::TreeNode* Tree<T>::ptrNode(TreeNodeId id)
+template<typename T, TreeLayout L> size_t Tree<T, L>::deletedNodeCount() const
 {
-    return id != 0 && id <= m_vecNode.size() ? &m_vecNode.at(id - 1) : nullptr;
+    return m_deletedNodeCount;
 }
 
-template<typename T>
-const typename Tree<T>::TreeNode* Tree<T>::ptrNode(TreeNodeId id) const
+template<typename T, TreeLayout L> gsl::span<const TreeNodeId> Tree<T, L>::roots() const
 {
-    return id != 0 && id <= m_vecNode.size() ? &m_vecNode.at(id - 1) : nullptr;
+    return m_vecRoot;
 }
 
-template<typename T, typename FN>
-void traverseTree(const Tree<T>& tree, const FN& callback, TreeTraversal mode)
+template<typename T, TreeLayout L, typename FN>
+void traverseTree(const Tree<T, L>& tree, const FN& callback, TreeTraversal mode)
 {
     switch (mode) {
     case TreeTraversal::Unorder:
@@ -316,8 +545,8 @@ void traverseTree(const Tree<T>& tree, const FN& callback, TreeTraversal mode)
     }
 }
 
-template<typename T, typename FN>
-void traverseTree(TreeNodeId id, const Tree<T>& tree, const FN& callback, TreeTraversal mode)
+template<typename T, TreeLayout L, typename FN>
+void traverseTree(TreeNodeId id, const Tree<T, L>& tree, const FN& callback, TreeTraversal mode)
 {
     switch (mode) {
     case TreeTraversal::Unorder:
@@ -328,53 +557,55 @@ void traverseTree(TreeNodeId id, const Tree<T>& tree, const FN& callback, TreeTr
     }
 }
 
-template<typename T, typename FN>
-void traverseTree_unorder(const Tree<T>& tree, const FN& callback)
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_unorder(const Tree<T, L>& tree, const FN& callback)
 {
-    for (const typename Tree<T>::TreeNode& node : tree.m_vecNode) {
-        const auto id = static_cast<TreeNodeId>((&node - &tree.m_vecNode.front()) + 1);
-        if (!tree.isNodeDeleted(id))
-            callback(id);
+    const size_t nodeCount = tree.nodeCount();
+    for (size_t index = 0; index < nodeCount; ++index) {
+        if (!tree.isSlotDeleted(index))
+            callback(tree.slotNodeId(index));
     }
 }
 
-template<typename T, typename FN>
-void traverseTree_preOrder(const Tree<T>& tree, const FN& callback)
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_preOrder(const Tree<T, L>& tree, const FN& callback)
 {
     for (TreeNodeId id : tree.roots())
         traverseTree_preOrder(id, tree, callback);
 }
 
-template<typename T, typename FN>
-void traverseTree_preOrder(TreeNodeId id, const Tree<T>& tree, const FN& callback)
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_preOrder(TreeNodeId id, const Tree<T, L>& tree, const FN& callback)
 {
+    using TreeType = Tree<T, L>;
     if (!tree.isNodeDeleted(id)) {
         callback(id);
-        for (auto it = tree.nodeChildFirst(id); it != 0; it = tree.nodeSiblingNext(it))
+        for (auto it = tree.link(id, TreeType::Link_ChildFirst); it != 0; it = tree.link(it, TreeType::Link_SiblingNext))
             traverseTree_preOrder(it, tree, callback);
     }
 }
 
-template<typename T, typename FN>
-void traverseTree_postOrder(const Tree<T>& tree, const FN& callback)
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_postOrder(const Tree<T, L>& tree, const FN& callback)
 {
     for (TreeNodeId id : tree.roots())
         traverseTree_postOrder(id, tree, callback);
 }
 
-template<typename T, typename FN>
-void traverseTree_postOrder(TreeNodeId id, const Tree<T>& tree, const FN& callback)
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_postOrder(TreeNodeId id, const Tree<T, L>& tree, const FN& callback)
 {
+    using TreeType = Tree<T, L>;
     if (!tree.isNodeDeleted(id)) {
-        for (auto it = tree.nodeChildFirst(id); it != 0; it = tree.nodeSiblingNext(it))
+        for (auto it = tree.link(id, TreeType::Link_ChildFirst); it != 0; it = tree.link(it, TreeType::Link_SiblingNext))
             traverseTree_postOrder(it, tree, callback);
 
         callback(id);
     }
 }
 
-template<typename U, typename FN>
-void visitDirectChildren(TreeNodeId id, const Tree<U>& tree, const FN& callback)
+template<typename U, TreeLayout L, typename FN>
+void visitDirectChildren(TreeNodeId id, const Tree<U, L>& tree, const FN& callback)
 {
     if (tree.isNodeDeleted(id))
         return;
@@ -0,0 +1,252 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "libtree.h"
+#include "task_executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Mayo {
+
+// Parallel variants of the traverseTree_() functions
+//
+// The tree is split at sub-tree boundaries : nodes near the roots are visited by the calling thread
+// (breadth-first) until there are enough sub-trees to feed all the threads. Then the remaining
+// sub-trees are traversed concurrently by the calling thread and by jobs posted to a TaskExecutor
+// (typically the one of the TaskManager running the current task, see TaskManager::executor()),
+// each sub-tree being traversed in pre-order by one single thread. The function returns once all
+// the sub-trees were traversed
+// The calling thread never waits for a job that didn't start yet: sub-trees are claimed one by one
+// by the threads taking part in the traversal, so it can't dead-lock even if called from a worker
+// thread of the executor or if all the worker threads are busy
+//
+// Requirements on the callback functions:
+//     * they are called concurrently from several threads, so any state they modify(apart from
+//       the data they solely own for the node being visited) must be protected by the caller
+//     * they must not modify the Tree object being traversed
+//     * they should not throw
+//
+// Guarantees:
+//     * each alive node is visited exactly once, but visiting order is unspecified
+//     * visit of a node "happens-before" the visit of any of its children, so callback can safely
+//       read data written by the visit of the parent node
+//
+
+// Calls 'callback' for each node of 'tree'
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_parallel(const Tree<T, L>& tree, const FN& callback, TaskExecutor& executor);
+
+// Calls 'callback' for the node 'id' and all its descendants
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_parallel(TreeNodeId id, const Tree<T, L>& tree, const FN& callback, TaskExecutor& executor);
+
+// Reduces all the nodes of 'tree' to a single value
+// 'fnMap' is called for each node and returns the value associated to that node(type 'R')
+// 'fnReduce' combines two values, it must be associative and commutative as partial values of the
+// sub-trees are combined in unspecified order. Values are passed as rvalues, so 'fnReduce' can take
+// them by value and recycle them(eg concatenation of containers)
+// 'identity' must be the neutral element of 'fnReduce', eg 0 for an addition
+template<typename R, typename T, TreeLayout L, typename MAP_FN, typename REDUCE_FN>
+R traverseTree_parallelReduce(
+        const Tree<T, L>& tree,
+        const R& identity,
+        const MAP_FN& fnMap,
+        const REDUCE_FN& fnReduce,
+        TaskExecutor& executor
+);
+
+// Same as above but only for the node 'id' and all its descendants
+template<typename R, typename T, TreeLayout L, typename MAP_FN, typename REDUCE_FN>
+R traverseTree_parallelReduce(
+        TreeNodeId id,
+        const Tree<T, L>& tree,
+        const R& identity,
+        const MAP_FN& fnMap,
+        const REDUCE_FN& fnReduce,
+        TaskExecutor& executor
+);
+
+// --
+// -- Implementation
+// --
+
+namespace Internal {
+
+// Visits with 'callback' the nodes near the roots 'spanRootId' until there are at least
+// 'targetSubTreeCount' sub-trees to be processed concurrently. Returns the roots of these sub-trees,
+// not yet visited
+template<typename T, TreeLayout L, typename FN>
+std::vector<TreeNodeId> splitTreeForParallelTraversal(
+        gsl::span<const TreeNodeId> spanRootId,
+        const Tree<T, L>& tree,
+        const FN& callback,
+        size_t targetSubTreeCount)
+{
+    std::vector<TreeNodeId> vecSubTreeId(spanRootId.begin(), spanRootId.end());
+    std::vector<TreeNodeId> vecNextSubTreeId;
+    while (vecSubTreeId.size() < targetSubTreeCount) {
+        bool hasExpandedNode = false;
+        vecNextSubTreeId.clear();
+        for (TreeNodeId id : vecSubTreeId) {
+            if (!tree.nodeIsLeaf(id)) {
+                callback(id);
+                visitDirectChildren(id, tree, [&](TreeNodeId childId) { vecNextSubTreeId.push_back(childId); });
+                hasExpandedNode = true;
+            }
+            else {
+                vecNextSubTreeId.push_back(id);
+            }
+        }
+
+        vecSubTreeId.swap(vecNextSubTreeId);
+        if (!hasExpandedNode)
+            break;
+    }
+
+    return vecSubTreeId;
+}
+
+// A few sub-trees per thread, so that unbalanced sub-trees can be compensated
+inline size_t targetSubTreeCount(const TaskExecutor& executor)
+{
+    return 4 * size_t(std::max(executor.threadCount(), 1));
+}
+
+// Calls 'fnJob(i)' for each index 'i' in [0, count[ concurrently, with the calling thread and jobs
+// posted to 'executor'
+// Indexes are claimed one by one, so the posted jobs that start once all the indexes were claimed
+// just return. That's why the calling thread only has to wait for the jobs actually running
+template<typename FN>
+void runConcurrentJobs(size_t count, const FN& fnJob, TaskExecutor& executor)
+{
+    // State is shared with the posted jobs as they can start after this function returned
+    struct SharedState {
+        std::atomic<size_t> nextIndex = 0;
+        size_t count = 0;
+        size_t doneCount = 0; // Guarded by 'mutexDone'
+        std::mutex mutexDone;
+        std::condition_variable condDone;
+    };
+
+    auto state = std::make_shared<SharedState>();
+    state->count = count;
+    // 'fnJob' is called only for indexes claimed before all jobs are done, so it's still alive then
+    auto fnRunJobs = [=, ptrFnJob = &fnJob]{
+        for (size_t i = state->nextIndex++; i < state->count; i = state->nextIndex++) {
+            (*ptrFnJob)(i);
+            std::lock_guard<std::mutex> lock(state->mutexDone);
+            if (++state->doneCount == state->count)
+                state->condDone.notify_all();
+        }
+    };
+
+    const size_t postedJobCount = std::min(count, size_t(executor.threadCount()));
+    for (size_t i = 1; i < postedJobCount; ++i)
+        executor.post(fnRunJobs);
+
+    fnRunJobs();
+    // Remaining jobs are being run by other threads, they don't depend on this thread to finish
+    std::unique_lock<std::mutex> lock(state->mutexDone);
+    state->condDone.wait(lock, [&]{ return state->doneCount == state->count; });
+}
+
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_parallel(
+        gsl::span<const TreeNodeId> spanRootId,
+        const Tree<T, L>& tree,
+        const FN& callback,
+        TaskExecutor& executor)
+{
+    const std::vector<TreeNodeId> vecSubTreeId =
+        splitTreeForParallelTraversal(spanRootId, tree, callback, targetSubTreeCount(executor));
+    runConcurrentJobs(vecSubTreeId.size(), [&](size_t i) {
+        traverseTree_preOrder(vecSubTreeId[i], tree, callback);
+    }, executor);
+}
+
+template<typename R, typename T, TreeLayout L, typename MAP_FN, typename REDUCE_FN>
+R traverseTree_parallelReduce(
+        gsl::span<const TreeNodeId> spanRootId,
+        const Tree<T, L>& tree,
+        const R& identity,
+        const MAP_FN& fnMap,
+        const REDUCE_FN& fnReduce,
+        TaskExecutor& executor)
+{
+    // Nodes visited by the calling thread while splitting the tree are accumulated in 'result'
+    R result = identity;
+    auto fnReduceNode = [&](TreeNodeId id) { result = fnReduce(std::move(result), fnMap(id)); };
+    const std::vector<TreeNodeId> vecSubTreeId =
+        splitTreeForParallelTraversal(spanRootId, tree, fnReduceNode, targetSubTreeCount(executor));
+
+    // One partial result per sub-tree, so no synchronization is needed
+    // Wrapped in a struct so std::vector<bool> specialization can't pack concurrently written values
+    struct SubTreeResult { R value; };
+    std::vector<SubTreeResult> vecSubTreeResult(vecSubTreeId.size(), SubTreeResult{ identity });
+    runConcurrentJobs(vecSubTreeId.size(), [&](size_t i) {
+        R& subTreeResult = vecSubTreeResult[i].value;
+        traverseTree_preOrder(vecSubTreeId[i], tree, [&](TreeNodeId id) {
+            subTreeResult = fnReduce(std::move(subTreeResult), fnMap(id));
+        });
+    }, executor);
+
+    for (SubTreeResult& subTreeResult : vecSubTreeResult)
+        result = fnReduce(std::move(result), std::move(subTreeResult.value));
+
+    return result;
+}
+
+} // namespace Internal
+
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_parallel(const Tree<T, L>& tree, const FN& callback, TaskExecutor& executor)
+{
+    Internal::traverseTree_parallel(tree.roots(), tree, callback, executor);
+}
+
+template<typename T, TreeLayout L, typename FN>
+void traverseTree_parallel(TreeNodeId id, const Tree<T, L>& tree, const FN& callback, TaskExecutor& executor)
+{
+    if (!tree.isNodeDeleted(id))
+        Internal::traverseTree_parallel(gsl::span<const TreeNodeId>(&id, 1), tree, callback, executor);
+}
+
+template<typename R, typename T, TreeLayout L, typename MAP_FN, typename REDUCE_FN>
+R traverseTree_parallelReduce(
+        const Tree<T, L>& tree,
+        const R& identity,
+        const MAP_FN& fnMap,
+        const REDUCE_FN& fnReduce,
+        TaskExecutor& executor)
+{
+    return Internal::traverseTree_parallelReduce(tree.roots(), tree, identity, fnMap, fnReduce, executor);
+}
+
+template<typename R, typename T, TreeLayout L, typename MAP_FN, typename REDUCE_FN>
+R traverseTree_parallelReduce(
+        TreeNodeId id,
+        const Tree<T, L>& tree,
+        const R& identity,
+        const MAP_FN& fnMap,
+        const REDUCE_FN& fnReduce,
+        TaskExecutor& executor)
+{
+    if (tree.isNodeDeleted(id))
+        return identity;
+
+    return Internal::traverseTree_parallelReduce(
+        gsl::span<const TreeNodeId>(&id, 1), tree, identity, fnMap, fnReduce, executor
+    );
+}
+
+} // namespace Mayo
@@ -26,7 +26,7 @@ namespace Mayo {
 // Provides mesh access to a TopoDS_Face object stored within XCAF document
 class XCafFace_MeshAccess : public IMeshAccess {
 public:
-    XCafFace_MeshAccess(const DocumentTreeNode& treeNode, const TopoDS_Face& face)
+    XCafFace_MeshAccess(const DocumentTreeNode& treeNode, const TopLoc_Location& locShape, const TopoDS_Face& face)
     {
         const DocumentPtr& doc = treeNode.document();
         const TDF_Label labelNode = treeNode.label();
@@ -45,7 +45,6 @@ public:
                 m_nodeColors = annexData->nodeColors();
         }
 
-        const TopLoc_Location locShape = XCaf::shapeAbsoluteLocation(doc->modelTree(), treeNode.id());
         TopLoc_Location locFace;
         m_triangulation = BRep_Tool::Triangulation(face, locFace);
         m_location = locShape * locFace;
@@ -99,13 +98,26 @@ void IMeshAccess_visitMeshes(
     if (!fnCallback || !treeNode.isValid())
         return;
 
+    const TopLoc_Location locShape = XCaf::shapeAbsoluteLocation(treeNode.document()->modelTree(), treeNode.id());
+    IMeshAccess_visitMeshes(treeNode, locShape, std::move(fnCallback));
+}
+
+void IMeshAccess_visitMeshes(
+        const DocumentTreeNode& treeNode,
+        const TopLoc_Location& absoluteLocation,
+        std::function<void(const IMeshAccess&)> fnCallback
+    )
+{
+    if (!fnCallback || !treeNode.isValid())
+        return;
+
     auto fnProxyCallback = [&](const IMeshAccess& mesh) {
         if (mesh.triangulation())
             fnCallback(mesh);
     };
     if (XCaf::isShape(treeNode.label())) {
         BRepUtils::forEachSubFace(XCaf::shape(treeNode.label()), [&](const TopoDS_Face& face) {
-            fnProxyCallback(XCafFace_MeshAccess(treeNode, face));
+            fnProxyCallback(XCafFace_MeshAccess(treeNode, absoluteLocation, face));
         });
     }
 }
@@ -35,4 +35,12 @@ void IMeshAccess_visitMeshes(
     std::function<void(const IMeshAccess&)> fnCallback
 );
 
+// Same as above but the absolute location of `treeNode` shape is already known by the caller
+// (eg provided by XCaf::traverseTreeWithLocation())
+void IMeshAccess_visitMeshes(
+    const DocumentTreeNode& treeNode,
+    const TopLoc_Location& absoluteLocation,
+    std::function<void(const IMeshAccess&)> fnCallback
+);
+
 } // namespace Mayo
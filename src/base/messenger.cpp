@@ -5,8 +5,15 @@
 
 #include "messenger.h"
 
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <deque>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 namespace Mayo {
 
@@ -184,4 +191,185 @@ void MessageCollecter::clear()
     m_vecMessage.clear();
 }
 
+// Messages emitted by a single thread, only that thread appends entries
+struct ConcurrentMessageCollecter::ThreadBuffer {
+    std::thread::id threadId;
+    // std::deque so entries have stable addresses, texts being referenced by the index maps
+    std::deque<Entry> entries;
+    std::array<std::unordered_map<std::string_view, Entry*>, 4> arrayMapEntry; // One per MessageType
+    std::array<int, 4> arraySuppressedCount = {}; // One per MessageType
+};
+
+namespace {
+
+// Identifies ConcurrentMessageCollecter objects, unlike addresses identifiers are never reused
+std::atomic<uint64_t> nextConcurrentMessageCollecterId = 1;
+
+} // namespace
+
+ConcurrentMessageCollecter::ConcurrentMessageCollecter(int maxEntryCount)
+    : m_instanceId(nextConcurrentMessageCollecterId++),
+      m_maxEntryCount(maxEntryCount)
+{
+}
+
+ConcurrentMessageCollecter::~ConcurrentMessageCollecter() = default;
+
+unsigned ConcurrentMessageCollecter::toFlag(MessageType msgType)
+{
+    return 1 << static_cast<unsigned>(msgType);
+}
+
+void ConcurrentMessageCollecter::only(MessageType msgType)
+{
+    m_ignoredTypes = ~(toFlag(msgType));
+}
+
+void ConcurrentMessageCollecter::ignore(MessageType msgType)
+{
+    m_ignoredTypes |= toFlag(msgType);
+}
+
+bool ConcurrentMessageCollecter::isIgnored(MessageType msgType) const
+{
+    return (m_ignoredTypes & toFlag(msgType)) != 0;
+}
+
+void ConcurrentMessageCollecter::emitMessage(MessageType msgType, std::string_view text)
+{
+    if (this->isIgnored(msgType))
+        return;
+
+    ThreadBuffer* buffer = this->currentThreadBuffer();
+    auto& mapEntry = buffer->arrayMapEntry.at(static_cast<size_t>(msgType));
+    auto itEntry = mapEntry.find(text);
+    if (itEntry != mapEntry.end()) {
+        ++(itEntry->second->occurrenceCount);
+        return;
+    }
+
+    if (int(mapEntry.size()) >= m_maxEntryCount) {
+        ++(buffer->arraySuppressedCount.at(static_cast<size_t>(msgType)));
+        return;
+    }
+
+    Entry& entry = buffer->entries.emplace_back(Entry{ msgType, std::string{text}, 1 });
+    mapEntry.insert({ entry.text, &entry });
+}
+
+std::vector<ConcurrentMessageCollecter::Entry> ConcurrentMessageCollecter::entries() const
+{
+    return this->mergedEntries(nullptr);
+}
+
+int ConcurrentMessageCollecter::suppressedCount(MessageType msgType) const
+{
+    std::array<int, 4> arraySuppressedCount = {};
+    this->mergedEntries(&arraySuppressedCount);
+    return arraySuppressedCount.at(static_cast<size_t>(msgType));
+}
+
+std::string ConcurrentMessageCollecter::asString(std::string_view separator, MessageType msgType) const
+{
+    std::array<int, 4> arraySuppressedCount = {};
+    std::vector<std::string> vecText;
+    for (const Entry& entry : this->mergedEntries(&arraySuppressedCount)) {
+        if (entry.type != msgType)
+            continue;
+
+        if (entry.occurrenceCount > 1)
+            vecText.push_back(fmt::format("{} (x{})", entry.text, entry.occurrenceCount));
+        else
+            vecText.push_back(entry.text);
+    }
+
+    const int suppressedCount = arraySuppressedCount.at(static_cast<size_t>(msgType));
+    if (suppressedCount > 0)
+        vecText.push_back(fmt::format("{} more message(s) suppressed", suppressedCount));
+
+    return fmt::format("{}", fmt::join(vecText, separator));
+}
+
+void ConcurrentMessageCollecter::clear()
+{
+    // Buffers are kept as they are still referenced by the threads that created them
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (std::unique_ptr<ThreadBuffer>& buffer : m_vecThreadBuffer) {
+        for (auto& mapEntry : buffer->arrayMapEntry)
+            mapEntry.clear();
+
+        buffer->entries.clear();
+        buffer->arraySuppressedCount = {};
+    }
+}
+
+std::vector<ConcurrentMessageCollecter::Entry>
+ConcurrentMessageCollecter::mergedEntries(std::array<int, 4>* ptrArraySuppressedCount) const
+{
+    std::vector<Entry> vecEntry;
+    std::array<std::unordered_map<std::string_view, size_t>, 4> arrayMapEntryIndex;
+    std::array<int, 4> arraySuppressedCount = {};
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : m_vecThreadBuffer) {
+        for (const Entry& entry : buffer->entries) {
+            auto& mapEntryIndex = arrayMapEntryIndex.at(static_cast<size_t>(entry.type));
+            auto [it, isNew] = mapEntryIndex.insert({ entry.text, vecEntry.size() });
+            if (isNew)
+                vecEntry.push_back(entry);
+            else
+                vecEntry.at(it->second).occurrenceCount += entry.occurrenceCount;
+        }
+
+        for (size_t i = 0; i < arraySuppressedCount.size(); ++i)
+            arraySuppressedCount.at(i) += buffer->arraySuppressedCount.at(i);
+    }
+
+    // Each thread collects up to 'm_maxEntryCount' messages per type, apply the limit to merged
+    // messages
+    std::array<int, 4> arrayEntryCount = {};
+    auto itEntryEnd = std::remove_if(vecEntry.begin(), vecEntry.end(), [&](const Entry& entry) {
+        const auto typeIndex = static_cast<size_t>(entry.type);
+        if (arrayEntryCount.at(typeIndex) < m_maxEntryCount) {
+            ++arrayEntryCount.at(typeIndex);
+            return false;
+        }
+
+        arraySuppressedCount.at(typeIndex) += entry.occurrenceCount;
+        return true;
+    });
+    vecEntry.erase(itEntryEnd, vecEntry.end());
+
+    if (ptrArraySuppressedCount)
+        *ptrArraySuppressedCount = arraySuppressedCount;
+
+    return vecEntry;
+}
+
+ConcurrentMessageCollecter::ThreadBuffer* ConcurrentMessageCollecter::currentThreadBuffer()
+{
+    // Cache of the buffer last used by the current thread
+    struct BufferCache {
+        uint64_t instanceId = 0;
+        ThreadBuffer* buffer = nullptr;
+    };
+    thread_local BufferCache cache;
+    if (cache.instanceId == m_instanceId)
+        return cache.buffer;
+
+    const std::thread::id threadId = std::this_thread::get_id();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto itBuffer = std::find_if(
+        m_vecThreadBuffer.begin(), m_vecThreadBuffer.end(),
+        [=](const std::unique_ptr<ThreadBuffer>& buffer) { return buffer->threadId == threadId; }
+    );
+    if (itBuffer == m_vecThreadBuffer.end()) {
+        m_vecThreadBuffer.push_back(std::make_unique<ThreadBuffer>());
+        m_vecThreadBuffer.back()->threadId = threadId;
+        itBuffer = std::prev(m_vecThreadBuffer.end());
+    }
+
+    cache = { m_instanceId, itBuffer->get() };
+    return cache.buffer;
+}
+
 } // namespace Mayo
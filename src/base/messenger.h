@@ -7,7 +7,11 @@
 
 #include <gsl/span>
 
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string_view>
 #include <vector>
@@ -111,4 +115,57 @@ private:
     std::vector<Messenger::Message> m_vecMessage;
 };
 
+// Thread-safe variant of MessageCollecter, meant for readers emitting lots of messages(eg one
+// warning per entity) possibly from parallel tasks
+//
+// Messages are appended to per-thread buffers, locking happens only for the first message emitted
+// by a thread. Identical messages(same type and text) are collected once along with their count of
+// occurrences. Beyond 'maxEntryCount' distinct messages of a type further new messages of that type
+// are suppressed, only their count is kept(limit applies to each thread and then to the merged
+// messages). So lots of warnings can't suppress a later error
+class ConcurrentMessageCollecter : public Messenger {
+public:
+    struct Entry {
+        MessageType type;
+        std::string text;
+        int occurrenceCount = 0;
+    };
+
+    explicit ConcurrentMessageCollecter(int maxEntryCount = 100);
+    ~ConcurrentMessageCollecter();
+
+    // Filtering must be configured before messages are emitted
+    void only(MessageType msgType);
+    void ignore(MessageType msgType);
+    bool isIgnored(MessageType msgType) const;
+
+    void emitMessage(MessageType msgType, std::string_view text) override;
+
+    // Functions below must not be called concurrently with emitMessage()
+
+    // Returns the messages collected from all threads, identical messages being merged
+    std::vector<Entry> entries() const;
+
+    // Count of suppressed messages(including occurrences of identical ones) of type 'msgType'
+    int suppressedCount(MessageType msgType) const;
+
+    // Text of the messages, each followed by its count of occurrences if greater than 1 and then a
+    // summary of the suppressed messages if any
+    std::string asString(std::string_view separator, MessageType msgType) const;
+
+    void clear();
+
+private:
+    struct ThreadBuffer;
+    ThreadBuffer* currentThreadBuffer();
+    std::vector<Entry> mergedEntries(std::array<int, 4>* ptrArraySuppressedCount) const;
+    static unsigned toFlag(MessageType msgType);
+
+    const uint64_t m_instanceId;
+    const int m_maxEntryCount;
+    unsigned m_ignoredTypes = 0;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_vecThreadBuffer; // Protected by 'm_mutex'
+};
+
 } // namespace Mayo
@@ -12,7 +12,8 @@
 namespace Mayo {
 
 OccProgressIndicator::OccProgressIndicator(TaskProgress* progress)
-    : m_progress(progress)
+    : m_progress(progress),
+      m_cancellationToken(progress ? progress->cancellationToken() : CancellationToken{})
 {
 #if OCC_VERSION_HEX < OCC_VERSION_CHECK(7, 5, 0)
     this->SetScale(0., 100., 1.);
@@ -51,7 +52,7 @@ bool OccProgressIndicator::Show(const bool /*force*/)
 
 bool OccProgressIndicator::UserBreak()
 {
-    return TaskProgress::isAbortRequested(m_progress);
+    return m_cancellationToken.isCancelled();
 }
 
 } // namespace Mayo
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "cancellation_token.h"
 #include "tkernel_utils.h"
 #include <Message_ProgressIndicator.hxx>
 
@@ -13,6 +14,7 @@ namespace Mayo {
 class TaskProgress;
 
 // Provides implementation of OpenCascade-based progress indicator around Mayo::TaskProgress
+// UserBreak() reports the abort requested on the task, whatever the depth of the TaskProgress
 class OccProgressIndicator : public Message_ProgressIndicator {
 public:
     explicit OccProgressIndicator(TaskProgress* progress);
@@ -27,6 +29,7 @@ public:
 
 private:
     TaskProgress* m_progress = nullptr;
+    CancellationToken m_cancellationToken;
     const char* m_lastStepName = nullptr;
     int m_lastProgress = -1;
 };
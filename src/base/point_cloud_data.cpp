@@ -5,6 +5,8 @@
 
 #include "point_cloud_data.h"
 
+#include "label_data.h"
+
 #include <Standard_GUID.hxx>
 #include <TDF_Label.hxx>
 
@@ -22,6 +24,7 @@ PointCloudDataPtr PointCloudData::Set(const TDF_Label& label)
     if (!label.FindAttribute(PointCloudData::GetID(), data)) {
         data = makeOccHandle<PointCloudData>();
         label.AddAttribute(data);
+        invalidateLabelDataFlags(label);
     }
 
     return data;
@@ -0,0 +1,141 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Mayo {
+
+template<typename Signature, size_t InlineSize = 48> class SmallFunction;
+
+// Move-only alternative to std::function storing the callable object within an internal buffer of
+// 'InlineSize' bytes, so construction doesn't allocate memory
+// Callables not fitting in the buffer(too big, over-aligned or with a throwing move constructor)
+// are allocated on the heap
+template<typename R, typename... Args, size_t InlineSize>
+class SmallFunction<R(Args...), InlineSize> {
+public:
+    SmallFunction() = default;
+
+    template<typename Function,
+             typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, SmallFunction>>>
+    SmallFunction(Function&& fn)
+    {
+        using Callable = std::decay_t<Function>;
+        if constexpr (isStorableInline<Callable>())
+            new (m_buffer) Callable(std::forward<Function>(fn));
+        else
+            *reinterpret_cast<Callable**>(m_buffer) = new Callable(std::forward<Function>(fn));
+
+        m_ops = &OpsOf<Callable>::ops;
+    }
+
+    SmallFunction(SmallFunction&& other) noexcept
+    {
+        this->moveFrom(std::move(other));
+    }
+
+    SmallFunction& operator=(SmallFunction&& other) noexcept
+    {
+        if (this != &other) {
+            this->reset();
+            this->moveFrom(std::move(other));
+        }
+
+        return *this;
+    }
+
+    ~SmallFunction() { this->reset(); }
+
+    // Disable copy
+    SmallFunction(const SmallFunction&) = delete;
+    SmallFunction& operator=(const SmallFunction&) = delete;
+
+    explicit operator bool() const { return m_ops != nullptr; }
+
+    // Whether the callable object is stored within the internal buffer(ie not allocated on heap)
+    bool isStoredInline() const { return m_ops && m_ops->isInline; }
+
+    R operator()(Args... args) const {
+        return m_ops->invoke(const_cast<unsigned char*>(m_buffer), std::forward<Args>(args)...);
+    }
+
+    void reset()
+    {
+        if (m_ops) {
+            m_ops->destroy(m_buffer);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    // Type-specific operations on the stored callable object
+    struct Ops {
+        R (*invoke)(void* buffer, Args&&... args);
+        void (*moveTo)(void* bufferSrc, void* bufferDst); // Also destroys source object
+        void (*destroy)(void* buffer);
+        bool isInline;
+    };
+
+    template<typename Callable>
+    static constexpr bool isStorableInline()
+    {
+        return sizeof(Callable) <= InlineSize
+               && alignof(Callable) <= alignof(std::max_align_t)
+               && std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+    template<typename Callable>
+    struct OpsOf {
+        static Callable* get(void* buffer) {
+            if constexpr (isStorableInline<Callable>())
+                return std::launder(reinterpret_cast<Callable*>(buffer));
+            else
+                return *reinterpret_cast<Callable**>(buffer);
+        }
+
+        static R invoke(void* buffer, Args&&... args) {
+            return (*get(buffer))(std::forward<Args>(args)...);
+        }
+
+        static void moveTo(void* bufferSrc, void* bufferDst) {
+            if constexpr (isStorableInline<Callable>()) {
+                Callable* src = get(bufferSrc);
+                new (bufferDst) Callable(std::move(*src));
+                src->~Callable();
+            }
+            else {
+                *reinterpret_cast<Callable**>(bufferDst) = get(bufferSrc);
+            }
+        }
+
+        static void destroy(void* buffer) {
+            if constexpr (isStorableInline<Callable>())
+                get(buffer)->~Callable();
+            else
+                delete get(buffer);
+        }
+
+        static constexpr Ops ops = { &invoke, &moveTo, &destroy, isStorableInline<Callable>() };
+    };
+
+    void moveFrom(SmallFunction&& other)
+    {
+        if (other.m_ops) {
+            other.m_ops->moveTo(other.m_buffer, m_buffer);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_buffer[InlineSize] = {};
+    const Ops* m_ops = nullptr;
+};
+
+} // namespace Mayo
@@ -18,4 +18,7 @@ constexpr TaskId TaskId_null = UINT64_MAX;
 // Syntactic sugar for task auto-deletion flag(see TaskManager::run/exec())
 enum class TaskAutoDestroy { On, Off };
 
+// Scheduling priority of a task, pending tasks of higher priority are started first
+enum class TaskPriority { Low, Normal, High };
+
 } // namespace Mayo
@@ -0,0 +1,146 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "task_executor.h"
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+
+namespace Mayo {
+
+namespace {
+
+constexpr int TaskPriorityCount = int(TaskPriority::High) + 1;
+
+// Executor and index of the worker running in the current thread, if any
+thread_local const TaskExecutor* threadExecutor = nullptr;
+thread_local int threadWorkerIndex = -1;
+
+} // namespace
+
+struct TaskExecutor::Worker {
+    std::mutex mutex;
+    std::deque<Job> arrayQueue[TaskPriorityCount];
+    std::thread thread;
+};
+
+TaskExecutor::TaskExecutor(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = std::max(int(std::thread::hardware_concurrency()), 2);
+
+    m_vecWorker.reserve(threadCount);
+    for (int i = 0; i < threadCount; ++i)
+        m_vecWorker.push_back(std::make_unique<Worker>());
+
+    // Workers are all allocated before any thread starts, as they can steal from each other
+    for (int i = 0; i < threadCount; ++i)
+        m_vecWorker.at(i)->thread = std::thread([=]{ this->runWorker(i); });
+}
+
+TaskExecutor::~TaskExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutexIdle);
+        m_isStopping = true;
+    }
+
+    m_condIdle.notify_all();
+    for (const std::unique_ptr<Worker>& worker : m_vecWorker) {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+void TaskExecutor::post(Job job, TaskPriority priority)
+{
+    const int workerIndex =
+        this->isWorkerThread() ?
+            threadWorkerIndex :
+            int(m_nextWorkerIndex.fetch_add(1) % m_vecWorker.size())
+        ;
+    Worker* worker = m_vecWorker.at(workerIndex).get();
+    {
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->arrayQueue[int(priority)].push_back(std::move(job));
+    }
+
+    {
+        // Counter is updated under the lock so that no wake-up can be missed by idle workers
+        std::lock_guard<std::mutex> lock(m_mutexIdle);
+        ++m_pendingJobCount;
+    }
+
+    m_condIdle.notify_one();
+}
+
+bool TaskExecutor::runPendingJob()
+{
+    if (!this->isWorkerThread())
+        return false;
+
+    Job job;
+    if (!this->takeJob(threadWorkerIndex, &job))
+        return false;
+
+    job();
+    return true;
+}
+
+bool TaskExecutor::isWorkerThread() const
+{
+    return threadExecutor == this;
+}
+
+void TaskExecutor::runWorker(int workerIndex)
+{
+    threadExecutor = this;
+    threadWorkerIndex = workerIndex;
+    for (;;) {
+        Job job;
+        if (this->takeJob(workerIndex, &job)) {
+            job();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutexIdle);
+        m_condIdle.wait(lock, [=]{ return m_pendingJobCount > 0 || m_isStopping; });
+        if (m_isStopping && m_pendingJobCount == 0)
+            return;
+    }
+}
+
+bool TaskExecutor::takeJob(int workerIndex, Job* job)
+{
+    const int workerCount = int(m_vecWorker.size());
+    for (int iPriority = TaskPriorityCount - 1; iPriority >= 0; --iPriority) {
+        // Own queue first(newest job), then steal from the other workers(oldest job)
+        for (int i = 0; i < workerCount; ++i) {
+            const bool isOwnQueue = i == 0;
+            Worker* worker = m_vecWorker.at((workerIndex + i) % workerCount).get();
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            std::deque<Job>& queue = worker->arrayQueue[iPriority];
+            if (queue.empty())
+                continue;
+
+            if (isOwnQueue) {
+                *job = std::move(queue.back());
+                queue.pop_back();
+            }
+            else {
+                *job = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            --m_pendingJobCount;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace Mayo
@@ -0,0 +1,70 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "task_common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mayo {
+
+// Fixed-size pool of worker threads executing jobs with work-stealing
+//
+// Each worker owns a queue of jobs per priority. A job posted from a worker thread(ie nested job)
+// goes to the queues of that worker and is popped back in LIFO order, which is cache friendly.
+// Jobs posted from any other thread are distributed round-robin among workers. Idle workers steal
+// the oldest jobs from the queues of other workers. Pending jobs of higher priority always come first
+class TaskExecutor {
+public:
+    using Job = std::function<void()>;
+
+    // 'threadCount' <= 0 means std::thread::hardware_concurrency(), with at least two threads so a
+    // job waiting for another one can't starve the pool
+    explicit TaskExecutor(int threadCount = 0);
+
+    // Waits for all pending jobs to be executed, then joins the worker threads
+    ~TaskExecutor();
+
+    // Not copyable
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    int threadCount() const { return int(m_vecWorker.size()); }
+
+    // Queues 'job' for asynchronous execution by some worker thread
+    void post(Job job, TaskPriority priority = TaskPriority::Normal);
+
+    // Executes one pending job in the calling thread, provided it's a worker thread of this executor
+    // Meant to be called while waiting for other jobs to complete, otherwise all the workers could
+    // end up waiting for jobs that will never start
+    // Returns 'true' if a job was executed
+    bool runPendingJob();
+
+    // Whether the calling thread is one of the worker threads of this executor
+    bool isWorkerThread() const;
+
+private:
+    struct Worker;
+
+    void runWorker(int workerIndex);
+    bool takeJob(int workerIndex, Job* job);
+
+    std::vector<std::unique_ptr<Worker>> m_vecWorker;
+    std::atomic<unsigned> m_nextWorkerIndex = 0;
+
+    // Guards waiting of idle workers
+    std::mutex m_mutexIdle;
+    std::condition_variable m_condIdle;
+    std::atomic<int> m_pendingJobCount = 0;
+    bool m_isStopping = false;
+};
+
+} // namespace Mayo
@@ -7,12 +7,16 @@
 
 #include "cpp_utils.h"
 #include "math_utils.h"
+#include "task_executor.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace Mayo {
@@ -23,9 +27,16 @@ struct TaskManager::Entity {
     TaskJob taskJob;
     TaskProgress taskProgress;
     std::string title;
+    std::shared_ptr<std::promise<void>> promise;
     std::future<void> control;
     std::atomic<bool> isFinished = false;
     TaskAutoDestroy autoDestroy = TaskAutoDestroy::On;
+    TaskPriority priority = TaskPriority::Normal;
+    // Count of unfinished dependencies, plus one until run() is called
+    std::atomic<int> pendingDependencyCount = 1;
+    // Tasks depending on this one, protected by 'mutexDependent'
+    std::mutex mutexDependent;
+    std::vector<TaskManager::Entity*> vecDependent;
 };
 
 // Pimpl struct providing private(hidden) interface of TaskManager class
@@ -40,27 +51,52 @@ struct TaskManager::Private {
     // Execute(synchronous) task entity, sending started/ended signals accordingly
     void execEntity(TaskManager::Entity* entity);
 
+    // Queue task entity in the executor
+    void postEntity(TaskManager::Entity* entity);
+
+    // Mark task entity as finished and queue the dependent tasks having no more dependencies
+    void finishEntity(TaskManager::Entity* entity);
+
+    // Blocks until task entity has finished or 'msecs' elapsed(if not negative)
+    bool waitForEntity(const TaskManager::Entity* entity, int msecs);
+
     // Destroy finished task entities whose policy was set to TaskAutoDestroy::On
     void cleanGarbage();
 
     TaskManager* taskMgr = nullptr;
+    const std::atomic<bool>* abortState = nullptr; // See TaskManager::setAbortSource()
+    std::unique_ptr<TaskExecutor> ownedExecutor;
+    TaskExecutor* executor = nullptr;
     std::atomic<TaskId> taskIdSeq = {};
     std::unordered_map<TaskId, std::unique_ptr<TaskManager::Entity>> mapEntity;
 };
 
 TaskManager::TaskManager()
+    : TaskManager(0)
+{
+}
+
+TaskManager::TaskManager(int threadCount)
+    : d(new Private(this))
+{
+    d->ownedExecutor = std::make_unique<TaskExecutor>(threadCount);
+    d->executor = d->ownedExecutor.get();
+}
+
+TaskManager::TaskManager(TaskExecutor* sharedExecutor)
     : d(new Private(this))
 {
+    if (!sharedExecutor)
+        d->ownedExecutor = std::make_unique<TaskExecutor>();
+
+    d->executor = sharedExecutor ? sharedExecutor : d->ownedExecutor.get();
 }
 
 TaskManager::~TaskManager()
 {
     // Make sure all tasks are really finished
-    for (const auto& mapPair : d->mapEntity) {
-        const std::unique_ptr<Entity>& ptrEntity = mapPair.second;
-        if (ptrEntity->control.valid())
-            ptrEntity->control.wait();
-    }
+    for (const auto& mapPair : d->mapEntity)
+        d->waitForEntity(mapPair.second.get(), -1);
 
     // Erase the task from its container before destruction, this will allow TaskProgress destructor
     // to behave correctly(it calls TaskProgress::setValue())
@@ -78,10 +114,42 @@ TaskId TaskManager::newTask(TaskJob fn)
     ptrEntity->taskJob = std::move(fn);
     ptrEntity->taskProgress.setTaskId(taskId);
     ptrEntity->taskProgress.setTaskManager(this);
+    if (d->abortState)
+        ptrEntity->taskProgress.setAbortState(d->abortState);
+
     d->mapEntity.insert({ taskId, std::move(ptrEntity) });
     return taskId;
 }
 
+TaskId TaskManager::newTask(TaskJob fn, const std::vector<TaskId>& dependencies)
+{
+    const TaskId taskId = this->newTask(std::move(fn));
+    Entity* entity = d->findEntity(taskId);
+    for (TaskId dependencyId : dependencies) {
+        Entity* dependency = d->findEntity(dependencyId);
+        if (!dependency || dependency == entity)
+            continue;
+
+        std::lock_guard<std::mutex> lock(dependency->mutexDependent);
+        if (!dependency->isFinished) {
+            dependency->vecDependent.push_back(entity);
+            ++(entity->pendingDependencyCount);
+        }
+    }
+
+    return taskId;
+}
+
+TaskId TaskManager::newContinuation(TaskId id, TaskJob fn)
+{
+    return this->newTask(std::move(fn), { id });
+}
+
+TaskId TaskManager::newTaskWhenAll(const std::vector<TaskId>& ids)
+{
+    return this->newTask([](TaskProgress*) {}, ids);
+}
+
 void TaskManager::run(TaskId id, TaskAutoDestroy policy)
 {
     d->cleanGarbage();
@@ -91,12 +159,12 @@ void TaskManager::run(TaskId id, TaskAutoDestroy policy)
 
     entity->isFinished = false;
     entity->autoDestroy = policy;
-    // NOSONAR[cpp:S8460] Intentional usage of std::async() here
-    //   * The returned future is stored in entity->control, so the destructor-blocking behavior is
-    //     controlled
-    //   * The std::launch::async policy is specified, if not the default is async|deferred and
-    //     which one gets selected is implementation-defined
-    entity->control = std::async(std::launch::async, [=]{ d->execEntity(entity); }); // NOSONAR
+    // std::function requires a copyable object, hence the shared promise
+    entity->promise = std::make_shared<std::promise<void>>();
+    entity->control = entity->promise->get_future();
+    // Dependencies are pending only on first call
+    if (entity->pendingDependencyCount.fetch_sub(1) <= 1)
+        d->postEntity(entity);
 }
 
 void TaskManager::exec(TaskId id, TaskAutoDestroy policy)
@@ -108,24 +176,20 @@ void TaskManager::exec(TaskId id, TaskAutoDestroy policy)
 
     entity->isFinished = false;
     entity->autoDestroy = policy;
-    d->execEntity(entity);
+    try {
+        d->execEntity(entity);
+    } catch (...) {
+        d->finishEntity(entity);
+        throw;
+    }
+
+    d->finishEntity(entity);
 }
 
 bool TaskManager::waitForDone(TaskId id, int msecs)
 {
     const Entity* entity = d->findEntity(id);
-    if (!entity)
-        return true;
-
-    if (!entity->control.valid())
-        return true;
-
-    if (msecs < 0) {
-        entity->control.wait();
-        return true;
-    }
-
-    return entity->control.wait_for(std::chrono::milliseconds(msecs)) == std::future_status::ready;
+    return entity ? d->waitForEntity(entity, msecs) : true;
 }
 
 void TaskManager::requestAbort(TaskId id)
@@ -137,12 +201,22 @@ void TaskManager::requestAbort(TaskId id)
     }
 }
 
+void TaskManager::setAbortSource(const TaskProgress* progress)
+{
+    d->abortState = progress ? progress->m_abortState : nullptr;
+}
+
 void TaskManager::foreachTask(const std::function<void(TaskId)>& fn)
 {
     for (const auto& mapPair : d->mapEntity)
         fn(mapPair.first);
 }
 
+TaskExecutor& TaskManager::executor() const
+{
+    return *d->executor;
+}
+
 double TaskManager::progress(TaskId id) const
 {
     const Entity* entity = d->findEntity(id);
@@ -174,6 +248,19 @@ void TaskManager::setTitle(TaskId id, std::string_view title)
         entity->title = title;
 }
 
+TaskPriority TaskManager::priority(TaskId id) const
+{
+    const Entity* entity = d->findEntity(id);
+    return entity ? entity->priority : TaskPriority::Normal;
+}
+
+void TaskManager::setPriority(TaskId id, TaskPriority priority)
+{
+    Entity* entity = d->findEntity(id);
+    if (entity)
+        entity->priority = priority;
+}
+
 TaskManager::Entity* TaskManager::Private::findEntity(TaskId id)
 {
     auto it = this->mapEntity.find(id);
@@ -198,7 +285,70 @@ void TaskManager::Private::execEntity(Entity* entity)
         entity->taskProgress.setValue(100);
 
     this->taskMgr->signalEnded.send(entity->taskId);
-    entity->isFinished = true;
+}
+
+void TaskManager::Private::postEntity(Entity* entity)
+{
+    this->executor->post([=]{
+        // Keep the promise alive, the entity might be destroyed as soon as it's fulfilled
+        const std::shared_ptr<std::promise<void>> promise = entity->promise;
+        std::exception_ptr ptrException;
+        try {
+            this->execEntity(entity);
+        } catch (...) {
+            ptrException = std::current_exception();
+        }
+
+        this->finishEntity(entity);
+        if (ptrException)
+            promise->set_exception(ptrException);
+        else
+            promise->set_value();
+    }, entity->priority);
+}
+
+void TaskManager::Private::finishEntity(Entity* entity)
+{
+    std::vector<Entity*> vecDependent;
+    {
+        std::lock_guard<std::mutex> lock(entity->mutexDependent);
+        entity->isFinished = true;
+        vecDependent.swap(entity->vecDependent);
+    }
+
+    for (Entity* dependent : vecDependent) {
+        if (dependent->pendingDependencyCount.fetch_sub(1) == 1)
+            this->postEntity(dependent);
+    }
+}
+
+bool TaskManager::Private::waitForEntity(const Entity* entity, int msecs)
+{
+    const std::future<void>& control = entity->control;
+    if (!control.valid())
+        return true;
+
+    if (!this->executor->isWorkerThread()) {
+        if (msecs < 0) {
+            control.wait();
+            return true;
+        }
+
+        return control.wait_for(std::chrono::milliseconds(msecs)) == std::future_status::ready;
+    }
+
+    // Current thread is a worker, help the executor instead of blocking it
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point timeEnd = Clock::now() + std::chrono::milliseconds(std::max(msecs, 0));
+    while (control.wait_for(std::chrono::seconds::zero()) != std::future_status::ready) {
+        if (msecs >= 0 && Clock::now() >= timeEnd)
+            return false;
+
+        if (!this->executor->runPendingJob())
+            control.wait_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
 }
 
 void TaskManager::Private::cleanGarbage()
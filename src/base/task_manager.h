@@ -5,15 +5,19 @@
 
 #pragma once
 
+#include "fast_signal.h"
 #include "signal.h"
 #include "task_progress.h"
 
 #include <functional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace Mayo {
 
+class TaskExecutor;
+
 // Piece of code to be executed as a task(ie with TaskManager::run/exec())
 using TaskJob = std::function<void(TaskProgress*)>;
 
@@ -21,7 +25,13 @@ using TaskJob = std::function<void(TaskProgress*)>;
 class TaskManager {
 public:
     // Ctor & dtor
+    // Tasks are executed by a pool of 'threadCount' threads owned by the TaskManager, <= 0 means
+    // the count of hardware threads(see TaskExecutor)
     TaskManager();
+    explicit TaskManager(int threadCount);
+    // Tasks are executed by 'sharedExecutor', which must outlive the TaskManager
+    // Useful for "child" TaskManager objects, so nested tasks don't create additional threads
+    explicit TaskManager(TaskExecutor* sharedExecutor);
     ~TaskManager();
 
     // Not copyable
@@ -32,16 +42,34 @@ public:
     // Returns the task identifier(unique in the scope of the owning TaskManager)
     TaskId newTask(TaskJob fn);
 
+    // Allocates a new task entity depending on tasks 'dependencies'
+    // Once run() is called, the task job is scheduled only when all the dependency tasks are
+    // finished, so no thread has to block waiting for them. Dependencies that are already finished
+    // or don't exist are ignored
+    // NOTE Each dependency task must be run at some point, otherwise the task job never executes
+    TaskId newTask(TaskJob fn, const std::vector<TaskId>& dependencies);
+
+    // Allocates a new task entity to be executed once task 'id' is finished
+    // Same as newTask(fn, { id })
+    TaskId newContinuation(TaskId id, TaskJob fn);
+
+    // Allocates a new task entity without any job, finishing as soon as all tasks 'ids' are finished
+    // Useful to wait for a group of tasks(see waitForDone()) or to join them in a continuation
+    TaskId newTaskWhenAll(const std::vector<TaskId>& ids);
+
     // Asynchronous execution of job associated with task identifier 'id'
     // By default destroy policy is set to 'On' meaning the task will be deleted at some point
     // after its completion
-    // This function is based on std::async() so depending on the C++ stdlib implementation this is
-    // probably using a thread pool
+    // The job is queued in the executor(see executor()), it will run as soon as a worker thread is
+    // available. If called from within a task job then the task is queued locally to the current
+    // worker thread
+    // If the task has dependencies then it's queued only once they are all finished
     // NOTE The task must have been allocated previously with newTask()
     void run(TaskId id, TaskAutoDestroy policy = TaskAutoDestroy::On);
 
     // Same as run() but execution of the task job is synchronous(it runs in the current thread
     // just like a regular function call)
+    // NOTE Dependencies of the task are not waited for
     void exec(TaskId id, TaskAutoDestroy policy = TaskAutoDestroy::On);
 
     // Current progress of task identified by 'id'
@@ -55,7 +83,13 @@ public:
     const std::string& title(TaskId id) const;
     void setTitle(TaskId id, std::string_view title);
 
+    // Scheduling priority of a task identified by 'id', applies on next call to run()
+    TaskPriority priority(TaskId id) const;
+    void setPriority(TaskId id, TaskPriority priority);
+
     // Blocks the current thread until task of identifier 'id' has finished
+    // If called from within a task job then pending tasks are executed meanwhile by the current
+    // thread, so waiting for nested tasks can't dead-lock the executor
     bool waitForDone(TaskId id, int msecs = -1);
 
     // Instructs the task of identifier 'id' to abort as soon as possible
@@ -63,9 +97,17 @@ public:
     // TaskProgress::isAbortRequested() flag and interrupt consequently
     void requestAbort(TaskId id);
 
+    // Tasks allocated afterwards share the abort state of 'progress', so they're aborted along with
+    // the task owning 'progress'. Then requestAbort() has no effect on these tasks
+    // Useful for "child" TaskManager objects running nested tasks
+    void setAbortSource(const TaskProgress* progress);
+
     // Applies function 'fn' to each task
     void foreachTask(const std::function<void(TaskId)>& fn);
 
+    // Pool of threads executing the tasks, can also be used directly to post jobs
+    TaskExecutor& executor() const;
+
     // Signal emitted when some task execution has just started
     Signal<TaskId> signalStarted;
 
@@ -73,7 +115,8 @@ public:
     Signal<TaskId, const std::string&> signalProgressStep;
 
     // Signal emitted when the current progress of some task has changed
-    Signal<TaskId, double> signalProgressChanged;
+    // It's a FastSignal as it can be sent at high frequency from many worker threads
+    FastSignal<TaskId, double> signalProgressChanged;
 
     // Signal emitted when requestAbort() was called on some task
     Signal<TaskId> signalAbortRequested;
@@ -9,16 +9,51 @@
 #include "math_utils.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <limits>
 
 namespace Mayo {
 
+namespace {
+
+// Progress values are stored as fixed-point integers, so they can be accumulated with atomic
+// operations(std::atomic<double> has no fetch_add() before C++20)
+constexpr int64_t FixedOnePercent = 1'000'000'000'000;
+constexpr int64_t FixedHundredPercent = 100 * FixedOnePercent;
+
+// Minimum time between two emissions of TaskManager::signalProgressChanged for a task
+constexpr int64_t SignalInterval_ms = 1000 / 30;
+
+int64_t toFixed(double pct)
+{
+    return std::llround(std::clamp(pct, 0., 100.) * FixedOnePercent);
+}
+
+double fromFixed(int64_t value)
+{
+    return double(value) / FixedOnePercent;
+}
+
+int64_t clampFixed(int64_t value)
+{
+    return std::clamp(value, int64_t(0), FixedHundredPercent);
+}
+
+int64_t currentTime_ms()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 TaskProgress::TaskProgress(TaskProgress* parent, double portionSize, std::string_view step)
     : m_parent(parent),
       m_taskMgr(parent ? parent->m_taskMgr : nullptr),
       m_taskId(parent ? parent->m_taskId : TaskId_null),
-      m_portionSize(std::clamp(portionSize, 0., 100.))
+      m_portionSize(std::clamp(portionSize, 0., 100.)),
+      m_abortState(parent ? parent->m_abortState : &m_isAbortRequested)
 {
     if (!step.empty())
         this->setStep(step);
@@ -41,31 +76,60 @@ bool TaskProgress::isNull() const
     return m_taskId == TaskId_null;
 }
 
+double TaskProgress::value() const
+{
+    return fromFixed(clampFixed(m_value));
+}
+
 void TaskProgress::setValue(double pct)
 {
     if (m_taskId == TaskId_null)
         return;
 
-    if (m_isAbortRequested)
+    if (this->isAbortRequested())
         return;
 
-    const double valueOnEntry = m_value;
-    pct = std::clamp(pct, 0., 100.);
-    m_value = pct;
+    const int64_t value = toFixed(pct);
+    const int64_t valueOnEntry = m_value.exchange(value);
+    this->propagateValueChange(clampFixed(valueOnEntry), value);
+}
 
-    if (m_parent) {
-        const auto valueDeltaInParent = (m_value - valueOnEntry) * (m_portionSize / 100.);
-        m_parent->setValue(m_parent->value() + valueDeltaInParent);
+void TaskProgress::propagateValueChange(int64_t valueOnEntry, int64_t valueOnExit)
+{
+    // Accumulate the change in each ancestor, values on entry/exit are clamped so a parent receives
+    // at most the portion of a child
+    TaskProgress* progress = this;
+    while (progress->m_parent) {
+        const double deltaInParent = (valueOnExit - valueOnEntry) * (progress->m_portionSize / 100.);
+        const auto fixedDeltaInParent = static_cast<int64_t>(std::llround(deltaInParent));
+        progress = progress->m_parent;
+        const int64_t parentValueOnEntry = progress->m_value.fetch_add(fixedDeltaInParent);
+        valueOnEntry = clampFixed(parentValueOnEntry);
+        valueOnExit = clampFixed(parentValueOnEntry + fixedDeltaInParent);
+    }
+
+    // Reached the root progress of the task, send signal if value 0% or 100% or if enough time
+    // elapsed since previous emission
+    const bool isValueChanged = valueOnEntry != valueOnExit;
+    const bool isValueBound = valueOnExit == 0 || valueOnExit == FixedHundredPercent;
+    if (!isValueChanged && valueOnExit != 0)
+        return;
+
+    const int64_t timeNow = currentTime_ms();
+    int64_t timeLastSignal = progress->m_lastSignalTime;
+    if (isValueBound) {
+        progress->m_lastSignalTime = timeNow;
     }
     else {
-        // Single decimal rounding function
-        auto fnRound = [](double v) { return std::round(v * 10.) / 10.; };
-        if (MathUtils::fuzzyIsNull(fnRound(pct))
-            || !MathUtils::fuzzyEqual(fnRound(valueOnEntry), fnRound(pct)))
-        {
-            m_taskMgr->signalProgressChanged.send(m_taskId, m_value);
-        }
+        if ((timeNow - timeLastSignal) < SignalInterval_ms)
+            return;
+
+        // Fails if some other thread is just sending the signal
+        if (!progress->m_lastSignalTime.compare_exchange_strong(timeLastSignal, timeNow))
+            return;
     }
+
+    progress->m_taskMgr->signalProgressChanged.send(progress->m_taskId, fromFixed(valueOnExit));
 }
 
 void TaskProgress::setStep(std::string_view title)
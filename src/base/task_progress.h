@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include "cancellation_token.h"
 #include "task_common.h"
 #include <atomic>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -15,6 +17,10 @@ namespace Mayo {
 class TaskManager;
 
 // Provides feedback on the progress of a running/executing task
+// Progress values are accumulated with atomic operations, so children of a same TaskProgress
+// object can be updated concurrently from different threads
+// Signal TaskManager::signalProgressChanged is throttled, it's sent at most 30 times per second for
+// a task(apart the 0% and 100% values which are always sent)
 class TaskProgress {
 public:
     TaskProgress() = default;
@@ -28,7 +34,7 @@ public:
     TaskManager* taskManager() const { return m_taskMgr; }
 
     // Value in [0,100]
-    double value() const { return m_value; }
+    double value() const;
     void setValue(double pct);
 
     const std::string& step() const { return m_step; }
@@ -38,9 +44,13 @@ public:
     const TaskProgress* parent() const { return m_parent; }
     TaskProgress* parent() { return m_parent; }
 
-    bool isAbortRequested() const { return m_isAbortRequested; }
+    // Abort state is shared by all the TaskProgress objects of a task, so children report the abort
+    // requested on the root TaskProgress
+    bool isAbortRequested() const { return m_abortState->load(std::memory_order_relaxed); }
     static bool isAbortRequested(const TaskProgress* progress);
 
+    CancellationToken cancellationToken() const { return CancellationToken(m_abortState); }
+
     // Disable copy
     TaskProgress(const TaskProgress&) = delete;
     TaskProgress(TaskProgress&&) = delete;
@@ -50,7 +60,9 @@ public:
 private:
     void setTaskId(TaskId id) { m_taskId = id; }
     void setTaskManager(TaskManager* mgr) { m_taskMgr = mgr; }
+    void setAbortState(const std::atomic<bool>* state) { m_abortState = state; }
     void requestAbort();
+    void propagateValueChange(int64_t valueOnEntry, int64_t valueOnExit);
 
     friend class TaskManager;
 
@@ -58,9 +70,11 @@ private:
     TaskManager* m_taskMgr{nullptr};
     TaskId m_taskId{TaskId_null};
     double m_portionSize{-1.};
-    std::atomic<double> m_value = 0.;
+    std::atomic<int64_t> m_value = 0; // Fixed-point, see task_progress.cpp
+    std::atomic<int64_t> m_lastSignalTime = 0; // Milliseconds, for root TaskProgress only
     std::string m_step;
-    bool m_isAbortRequested{false};
+    std::atomic<bool> m_isAbortRequested = false; // For root TaskProgress only
+    const std::atomic<bool>* m_abortState = &m_isAbortRequested; // Points to flag of root TaskProgress
 };
 
 } // namespace Mayo
@@ -0,0 +1,74 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "task_progress_dispatcher.h"
+#include "task_manager.h"
+
+#include <utility>
+#include <vector>
+
+namespace Mayo {
+
+TaskProgressDispatcher::TaskProgressDispatcher(TaskManager* taskMgr, std::function<void()> fnFlushRequest)
+    : m_fnFlushRequest(std::move(fnFlushRequest))
+{
+    // Direct connections(not connectSlot()) as TaskManager signals are sent from worker threads
+    m_connProgressChanged = taskMgr->signalProgressChanged.connect(
+        &TaskProgressDispatcher::onTaskProgressChanged, this
+    );
+    m_connEnded = taskMgr->signalEnded.connect(&TaskProgressDispatcher::onTaskEnded, this);
+}
+
+TaskProgressDispatcher::~TaskProgressDispatcher()
+{
+    m_connProgressChanged.disconnect();
+    m_connEnded.disconnect();
+}
+
+void TaskProgressDispatcher::flush()
+{
+    std::vector<std::pair<TaskId, double>> vecProgress;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        vecProgress.assign(m_mapPendingProgress.begin(), m_mapPendingProgress.end());
+        m_mapPendingProgress.clear();
+    }
+
+    for (const auto& [taskId, pct] : vecProgress)
+        this->signalProgressChanged.send(taskId, pct);
+
+    m_deliveredUpdateCount += vecProgress.size();
+    if (!vecProgress.empty())
+        this->signalFlushed.send();
+}
+
+bool TaskProgressDispatcher::hasPendingUpdates() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_mapPendingProgress.empty();
+}
+
+void TaskProgressDispatcher::onTaskProgressChanged(TaskId taskId, double pct)
+{
+    ++m_sentUpdateCount;
+    bool isFlushRequired = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        isFlushRequired = m_mapPendingProgress.empty();
+        m_mapPendingProgress.insert_or_assign(taskId, pct);
+    }
+
+    if (isFlushRequired && m_fnFlushRequest)
+        m_fnFlushRequest();
+}
+
+void TaskProgressDispatcher::onTaskEnded(TaskId taskId)
+{
+    // Receivers are notified of the end of the task anyway, pending update is superseded
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mapPendingProgress.erase(taskId);
+}
+
+} // namespace Mayo
@@ -0,0 +1,75 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "fast_signal.h"
+#include "signal.h"
+#include "task_common.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace Mayo {
+
+class TaskManager;
+
+// Coalesces the progress updates of the tasks owned by a TaskManager object
+//
+// TaskManager::signalProgressChanged is received directly in the thread sending it(typically a
+// worker thread), only the latest value of each task is kept. Updates are then delivered with
+// TaskProgressDispatcher::signalProgressChanged when flush() is called in the receiving thread,
+// typically from a timer running at FlushInterval_ms
+// This way receivers(UI, console) get at most one update per task and per flush, whatever the
+// count of updates sent by the tasks
+class TaskProgressDispatcher {
+public:
+    // Suggested interval between two calls to flush(), ie 30 flushes per second
+    static constexpr int FlushInterval_ms = 1000 / 30;
+
+    // 'fnFlushRequest' is called when an update is pending while there was none, it's expected to
+    // schedule a call to flush() in the receiving thread(eg after FlushInterval_ms)
+    // NOTE 'fnFlushRequest' can be called from any thread
+    TaskProgressDispatcher(TaskManager* taskMgr, std::function<void()> fnFlushRequest);
+    ~TaskProgressDispatcher();
+
+    // Not copyable
+    TaskProgressDispatcher(const TaskProgressDispatcher&) = delete;
+    TaskProgressDispatcher& operator=(const TaskProgressDispatcher&) = delete;
+
+    // Delivers the pending updates with signalProgressChanged, then sends signalFlushed if at least
+    // one update was delivered
+    void flush();
+
+    bool hasPendingUpdates() const;
+
+    // Count of updates sent by the TaskManager object
+    uint64_t sentUpdateCount() const { return m_sentUpdateCount; }
+    // Count of updates delivered with signalProgressChanged, superseded updates being dropped
+    uint64_t deliveredUpdateCount() const { return m_deliveredUpdateCount; }
+
+    // Signal emitted by flush() for each task whose progress changed since previous flush
+    Signal<TaskId, double> signalProgressChanged;
+
+    // Signal emitted at the end of flush() if some updates were delivered
+    Signal<> signalFlushed;
+
+private:
+    void onTaskProgressChanged(TaskId taskId, double pct);
+    void onTaskEnded(TaskId taskId);
+
+    std::function<void()> m_fnFlushRequest;
+    mutable std::mutex m_mutex;
+    std::unordered_map<TaskId, double> m_mapPendingProgress; // Protected by 'm_mutex'
+    std::atomic<uint64_t> m_sentUpdateCount = 0;
+    std::atomic<uint64_t> m_deliveredUpdateCount = 0;
+    FastSignalConnection m_connProgressChanged;
+    SignalConnectionHandle m_connEnded;
+};
+
+} // namespace Mayo
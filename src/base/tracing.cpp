@@ -0,0 +1,192 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "tracing.h"
+
+#include <fmt/format.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mayo::Tracing {
+
+namespace {
+
+struct Span {
+    const char* category;
+    const char* name;
+    int64_t beginTime_ns;
+    int64_t endTime_ns;
+};
+
+// Fixed-size block of spans, 'count' is published with release semantics so the spans can be read
+// by another thread while the owner thread is appending new ones
+struct SpanChunk {
+    static constexpr int Capacity = 4096;
+    std::array<Span, Capacity> spans;
+    std::atomic<int> count = 0;
+    std::atomic<SpanChunk*> next = nullptr;
+};
+
+// Spans recorded by a single thread, only that thread appends spans
+struct ThreadBuffer {
+    explicit ThreadBuffer(int index) : threadIndex(index) {}
+    ~ThreadBuffer() {
+        SpanChunk* chunk = headChunk.next;
+        while (chunk) {
+            SpanChunk* nextChunk = chunk->next;
+            delete chunk;
+            chunk = nextChunk;
+        }
+    }
+
+    const int threadIndex;
+    SpanChunk headChunk;
+    SpanChunk* tailChunk = &headChunk;
+};
+
+// Owns the buffers of all threads, so spans are still available once a thread has exited
+struct Registry {
+    std::atomic<bool> isEnabled = false;
+    std::atomic<uint64_t> spanCount = 0;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> vecThreadBuffer; // Protected by 'mutex'
+    const int64_t originTime_ns = currentTime_ns();
+};
+
+Registry& registry()
+{
+    static Registry reg;
+    return reg;
+}
+
+ThreadBuffer* currentThreadBuffer()
+{
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.vecThreadBuffer.push_back(std::make_unique<ThreadBuffer>(int(reg.vecThreadBuffer.size())));
+        buffer = reg.vecThreadBuffer.back().get();
+    }
+
+    return buffer;
+}
+
+std::string jsonEscaped(const char* str)
+{
+    std::string strEscaped;
+    for (const char* it = str; it && *it != '\0'; ++it) {
+        const char c = *it;
+        if (c == '"' || c == '\\')
+            strEscaped += '\\';
+
+        if (static_cast<unsigned char>(c) >= 0x20)
+            strEscaped += c;
+    }
+
+    return strEscaped;
+}
+
+} // namespace
+
+bool isEnabled()
+{
+    return registry().isEnabled.load(std::memory_order_relaxed);
+}
+
+void setEnabled(bool on)
+{
+    registry().isEnabled = on;
+}
+
+uint64_t spanCount()
+{
+    return registry().spanCount;
+}
+
+int64_t currentTime_ns()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void ScopedSpan::recordSpan(const char* category, const char* name, int64_t beginTime_ns, int64_t endTime_ns)
+{
+    ThreadBuffer* buffer = currentThreadBuffer();
+    SpanChunk* chunk = buffer->tailChunk;
+    int count = chunk->count.load(std::memory_order_relaxed);
+    if (count == SpanChunk::Capacity) {
+        auto newChunk = new SpanChunk;
+        chunk->next.store(newChunk, std::memory_order_release);
+        buffer->tailChunk = newChunk;
+        chunk = newChunk;
+        count = 0;
+    }
+
+    chunk->spans[count] = { category, name, beginTime_ns, endTime_ns };
+    chunk->count.store(count + 1, std::memory_order_release);
+    registry().spanCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string toChromeTraceJson()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::string json = "{\"traceEvents\":[\n";
+    bool isFirstEvent = true;
+    auto fnAppendEvent = [&](const std::string& strEvent) {
+        if (!isFirstEvent)
+            json += ",\n";
+
+        json += strEvent;
+        isFirstEvent = false;
+    };
+
+    for (const std::unique_ptr<ThreadBuffer>& buffer : reg.vecThreadBuffer) {
+        fnAppendEvent(fmt::format(
+            R"({{"name":"thread_name","ph":"M","pid":1,"tid":{0},"args":{{"name":"Thread #{0}"}}}})",
+            buffer->threadIndex
+        ));
+        const SpanChunk* chunk = &buffer->headChunk;
+        while (chunk) {
+            const int count = chunk->count.load(std::memory_order_acquire);
+            for (int i = 0; i < count; ++i) {
+                const Span& span = chunk->spans[i];
+                // Timestamps are expressed in microseconds
+                fnAppendEvent(fmt::format(
+                    R"({{"name":"{}","cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{}}})",
+                    jsonEscaped(span.name),
+                    jsonEscaped(span.category),
+                    (span.beginTime_ns - reg.originTime_ns) / 1000.,
+                    (span.endTime_ns - span.beginTime_ns) / 1000.,
+                    buffer->threadIndex
+                ));
+            }
+
+            chunk = chunk->next.load(std::memory_order_acquire);
+        }
+    }
+
+    json += "\n],\n\"displayTimeUnit\":\"ms\"}\n";
+    return json;
+}
+
+bool writeChromeTraceFile(const FilePath& filepath)
+{
+    std::ofstream fstr(filepath, std::ios::out | std::ios::binary);
+    if (!fstr.is_open())
+        return false;
+
+    fstr << toChromeTraceJson();
+    fstr.close();
+    return fstr.good();
+}
+
+} // namespace Mayo::Tracing
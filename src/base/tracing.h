@@ -0,0 +1,79 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "filepath.h"
+
+#include <common/mayo_config.h>
+
+#include <cstdint>
+#include <string>
+
+namespace Mayo::Tracing {
+
+// Lightweight recording of timed spans(named code scopes) for profiling purpose
+//
+// Spans are recorded into per-thread buffers without any locking, only when recording is enabled
+// with setEnabled(). Recorded spans can then be exported in the Chrome trace-event JSON format,
+// which can be loaded in chrome://tracing or https://ui.perfetto.dev
+// Instrumentation is done with the MAYO_TRACE_SCOPE() macros, which expand to nothing if
+// MAYO_ENABLE_TRACING isn't defined(see CMake option Mayo_EnableTracing)
+//
+// NOTE Span names and categories must be string literals(or have static storage duration)
+
+// Whether spans are currently recorded, disabled by default
+bool isEnabled();
+void setEnabled(bool on);
+
+// Count of spans recorded so far, for all threads
+uint64_t spanCount();
+
+// Writes all recorded spans into file 'filepath' in the Chrome trace-event JSON format
+// Should be called when no span is being recorded(eg after setEnabled(false))
+// Returns 'true' on success
+bool writeChromeTraceFile(const FilePath& filepath);
+
+// Same as writeChromeTraceFile() but returns the JSON contents
+std::string toChromeTraceJson();
+
+// Nanoseconds elapsed since some arbitrary(but fixed) point in time
+int64_t currentTime_ns();
+
+// Records a span starting at construction and ending at destruction
+class ScopedSpan {
+public:
+    ScopedSpan(const char* category, const char* name)
+        : m_category(category),
+          m_name(name),
+          m_beginTime_ns(isEnabled() ? currentTime_ns() : -1)
+    {}
+
+    ~ScopedSpan() {
+        if (m_beginTime_ns >= 0)
+            recordSpan(m_category, m_name, m_beginTime_ns, currentTime_ns());
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+private:
+    static void recordSpan(const char* category, const char* name, int64_t beginTime_ns, int64_t endTime_ns);
+
+    const char* m_category;
+    const char* m_name;
+    int64_t m_beginTime_ns;
+};
+
+} // namespace Mayo::Tracing
+
+#ifdef MAYO_ENABLE_TRACING
+#  define MAYO_TRACE_CONCAT_IMPL(a, b) a##b
+#  define MAYO_TRACE_CONCAT(a, b) MAYO_TRACE_CONCAT_IMPL(a, b)
+#  define MAYO_TRACE_SCOPE(category, name) \
+       const Mayo::Tracing::ScopedSpan MAYO_TRACE_CONCAT(mayoTraceSpan_, __LINE__)(category, name)
+#else
+#  define MAYO_TRACE_SCOPE(category, name)
+#endif
@@ -5,6 +5,8 @@
 
 #include "triangulation_annex_data.h"
 
+#include "label_data.h"
+
 #include <Standard_GUID.hxx>
 #include <TDF_Label.hxx>
 #include <algorithm>
@@ -24,6 +26,7 @@ TriangulationAnnexDataPtr TriangulationAnnexData::Set(const TDF_Label& label)
     if (!label.FindAttribute(TriangulationAnnexData::GetID(), data)) {
         data = makeOccHandle<TriangulationAnnexData>();
         label.AddAttribute(data);
+        invalidateLabelDataFlags(label);
     }
 
     return data;
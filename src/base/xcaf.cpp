@@ -4,23 +4,116 @@
 ****************************************************************************/
 
 #include "xcaf.h"
+#include "brep_utils.h"
 #include "caf_utils.h"
+#include "label_data.h"
 #include "math_utils.h"
+#include "string_conv.h"
 
+#include <BRep_Tool.hxx>
+#include <BRepAdaptor_Surface.hxx>
 #include <TDataStd_TreeNode.hxx>
 #include <TDocStd_Document.hxx>
 #include <TDF_AttributeIterator.hxx>
+#include <TopExp.hxx>
+#include <TopoDS.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <XCAFDoc.hxx>
 #include <XCAFDoc_Area.hxx>
 #include <XCAFDoc_Centroid.hxx>
 #include <XCAFDoc_DocumentTool.hxx>
 #include <XCAFDoc_Volume.hxx>
 
+#include <functional>
+#include <iterator>
 #include <optional>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace Mayo {
 
+namespace {
+
+// Geometric fingerprint of a product shape, two products can be duplicates only if their
+// fingerprints are equal
+// Note: curve/surface parameters aren't part of the fingerprint, so equal fingerprints must be
+//       confirmed by a full comparison of the shapes
+struct ProductFingerprint {
+    std::vector<int> vecTopologyCount; // Count of vertices, edges, wires, faces, shells, solids
+    std::vector<int> vecSurfaceType; // Indexed by face
+    std::vector<gp_XYZ> vecVertexPos; // Indexed by vertex
+    size_t hash = 0;
+
+    static ProductFingerprint compute(const TopoDS_Shape& shape);
+
+    bool operator==(const ProductFingerprint& other) const {
+        auto fnPosEqual = [](const gp_XYZ& lhs, const gp_XYZ& rhs) {
+            return lhs.X() == rhs.X() && lhs.Y() == rhs.Y() && lhs.Z() == rhs.Z();
+        };
+        return this->hash == other.hash
+               && this->vecTopologyCount == other.vecTopologyCount
+               && this->vecSurfaceType == other.vecSurfaceType
+               && std::equal(
+                   this->vecVertexPos.cbegin(), this->vecVertexPos.cend(),
+                   other.vecVertexPos.cbegin(), other.vecVertexPos.cend(),
+                   fnPosEqual
+               );
+    }
+};
+
+struct ProductFingerprintHasher {
+    size_t operator()(const ProductFingerprint& fingerprint) const { return fingerprint.hash; }
+};
+
+ProductFingerprint ProductFingerprint::compute(const TopoDS_Shape& shape)
+{
+    ProductFingerprint fingerprint;
+    auto fnHashCombine = [&](size_t value) {
+        size_t& seed = fingerprint.hash;
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    };
+
+    const TopAbs_ShapeEnum arrayTopologyType[] = {
+        TopAbs_VERTEX, TopAbs_EDGE, TopAbs_WIRE, TopAbs_FACE, TopAbs_SHELL, TopAbs_SOLID
+    };
+    TopTools_IndexedMapOfShape mapVertex;
+    TopTools_IndexedMapOfShape mapFace;
+    for (size_t i = 0; i < std::size(arrayTopologyType); ++i) {
+        TopTools_IndexedMapOfShape mapOther;
+        TopTools_IndexedMapOfShape& mapShape =
+            arrayTopologyType[i] == TopAbs_VERTEX ? mapVertex :
+            arrayTopologyType[i] == TopAbs_FACE ? mapFace :
+            mapOther
+            ;
+        TopExp::MapShapes(shape, arrayTopologyType[i], mapShape);
+        fingerprint.vecTopologyCount.push_back(mapShape.Extent());
+        fnHashCombine(std::hash<int>{}(mapShape.Extent()));
+    }
+
+    fingerprint.vecSurfaceType.reserve(mapFace.Extent());
+    for (int i = 1; i <= mapFace.Extent(); ++i) {
+        const BRepAdaptor_Surface surface(TopoDS::Face(mapFace.FindKey(i)), false/*!restriction*/);
+        const int surfaceType = surface.GetType();
+        fingerprint.vecSurfaceType.push_back(surfaceType);
+        fnHashCombine(std::hash<int>{}(surfaceType));
+    }
+
+    fingerprint.vecVertexPos.reserve(mapVertex.Extent());
+    for (int i = 1; i <= mapVertex.Extent(); ++i) {
+        const gp_XYZ pos = BRep_Tool::Pnt(TopoDS::Vertex(mapVertex.FindKey(i))).XYZ();
+        fingerprint.vecVertexPos.push_back(pos);
+        for (int iCoord = 1; iCoord <= 3; ++iCoord)
+            fnHashCombine(std::hash<double>{}(pos.Coord(iCoord)));
+    }
+
+    return fingerprint;
+}
+
+} // namespace
+
 bool XCaf::isNull() const
 {
     auto doc = TDocStd_Document::Get(m_labelMain);
@@ -96,6 +189,8 @@ TopoDS_Shape XCaf::shape(const TDF_Label& lbl)
 void XCaf::setShape(const TDF_Label& label, const TopoDS_Shape& shape)
 {
     this->shapeTool()->SetShape(label, shape);
+    if (m_labelDataFlagsCache)
+        m_labelDataFlagsCache->erase(label);
 }
 
 //QString XCaf::findLabelName(const TDF_Label& lbl)
@@ -269,6 +364,43 @@ TopLoc_Location XCaf::shapeAbsoluteLocation(const Tree<TDF_Label>& modelTree, Tr
     return absoluteLoc;
 }
 
+namespace {
+
+void deepTraverseTreeWithLocation(
+        const Tree<TDF_Label>& modelTree,
+        TreeNodeId id,
+        const TopLoc_Location& locParent,
+        const XCaf::TraverseTreeWithLocationCallback& fnCallback)
+{
+    const TopLoc_Location loc = locParent * XCaf::shapeReferenceLocation(modelTree.nodeData(id));
+    fnCallback(id, loc);
+    visitDirectChildren(id, modelTree, [&](TreeNodeId childId) {
+        deepTraverseTreeWithLocation(modelTree, childId, loc, fnCallback);
+    });
+}
+
+} // namespace
+
+void XCaf::traverseTreeWithLocation(
+        const Tree<TDF_Label>& modelTree, TreeNodeId id, const TraverseTreeWithLocationCallback& fnCallback)
+{
+    if (id == 0 || !fnCallback)
+        return;
+
+    const TopLoc_Location locParent = XCaf::shapeAbsoluteLocation(modelTree, modelTree.nodeParent(id));
+    deepTraverseTreeWithLocation(modelTree, id, locParent, fnCallback);
+}
+
+void XCaf::traverseTreeWithLocation(
+        const Tree<TDF_Label>& modelTree, const TraverseTreeWithLocationCallback& fnCallback)
+{
+    if (!fnCallback)
+        return;
+
+    for (TreeNodeId id : modelTree.roots())
+        deepTraverseTreeWithLocation(modelTree, id, TopLoc_Location(), fnCallback);
+}
+
 QuantityDensity XCaf::shapeMaterialDensity(const TDF_Label& lbl)
 {
     return XCaf::shapeMaterialDensity(XCaf::shapeMaterial(lbl));
@@ -340,6 +472,141 @@ NCollection_Sequence<TDF_Label> XCaf::diffTopLevelFreeShapes(const NCollection_S
     return seqDiff;
 }
 
+XCaf::DeduplicateProductsResult XCaf::deduplicateProducts(const NCollection_Sequence<TDF_Label>& seqEntity)
+{
+    DeduplicateProductsResult result;
+
+    // Collect the products referred by assemblies, in order of appearance
+    std::vector<TDF_Label> vecProduct;
+    std::unordered_set<TDF_Label> setVisitedLabel;
+    std::function<void(const TDF_Label&)> fnCollectProducts = [&](const TDF_Label& label) {
+        if (!setVisitedLabel.insert(label).second)
+            return;
+
+        if (XCaf::isShapeAssembly(label)) {
+            for (const TDF_Label& labelComponent : XCaf::shapeComponents(label))
+                fnCollectProducts(XCaf::shapeReferred(labelComponent));
+        }
+        else if (XCaf::isShapeSimple(label) && XCaf::hasShapeUsers(label)) {
+            vecProduct.push_back(label);
+        }
+    };
+    for (const TDF_Label& labelEntity : seqEntity)
+        fnCollectProducts(labelEntity);
+
+    result.productCount = int(vecProduct.size());
+
+    // Products kept so far, grouped by fingerprint
+    // The BRep serialization of a kept product is computed only when another product has the same
+    // fingerprint, it's then compared to detect actual duplicates
+    struct KeptProduct {
+        TDF_Label label;
+        std::optional<std::string> strBRep;
+    };
+    std::unordered_map<ProductFingerprint, std::vector<KeptProduct>, ProductFingerprintHasher> mapFingerprintProducts;
+    struct Duplicate {
+        TDF_Label labelProduct;
+        TDF_Label labelKept;
+        size_t brepSize; // Size of the BRep serialization, which covers topology and geometry
+    };
+    std::vector<Duplicate> vecDuplicate;
+
+    // The attributes of a removed product would be lost, so they must match the kept product
+    auto fnSameColor = [this](const TDF_Label& lhs, const TDF_Label& rhs) {
+        const bool hasColor = this->hasShapeColor(lhs);
+        if (hasColor != this->hasShapeColor(rhs))
+            return false;
+
+        return !hasColor || this->shapeColor(lhs) == this->shapeColor(rhs);
+    };
+    auto fnLayerNames = [this](const TDF_Label& label) {
+        std::set<std::string> setLayerName;
+        for (const TDF_Label& layerLabel : this->layers(label))
+            setLayerName.insert(to_stdString(this->layerName(layerLabel)));
+
+        return setLayerName;
+    };
+    auto fnSameMaterial = [](const TDF_Label& lhs, const TDF_Label& rhs) {
+        const OccHandle<XCAFDoc_Material> lhsMaterial = XCaf::shapeMaterial(lhs);
+        const OccHandle<XCAFDoc_Material> rhsMaterial = XCaf::shapeMaterial(rhs);
+        if (!lhsMaterial || !rhsMaterial)
+            return !lhsMaterial && !rhsMaterial;
+
+        auto fnName = [](const OccHandle<XCAFDoc_Material>& material) {
+            return material->GetName() ? to_stdString(material->GetName()->String()) : std::string{};
+        };
+        return fnName(lhsMaterial) == fnName(rhsMaterial) && lhsMaterial->GetDensity() == rhsMaterial->GetDensity();
+    };
+    auto fnSameAttributes = [&](const TDF_Label& lhs, const TDF_Label& rhs) {
+        return CafUtils::labelAttrStdName(lhs) == CafUtils::labelAttrStdName(rhs)
+               && fnSameColor(lhs, rhs)
+               && fnLayerNames(lhs) == fnLayerNames(rhs)
+               && fnSameMaterial(lhs, rhs);
+    };
+
+    for (const TDF_Label& labelProduct : vecProduct) {
+        if (!XCaf::shapeSubs(labelProduct).IsEmpty())
+            continue;
+
+        // User-defined attributes can't be compared, they would be lost
+        if (CafUtils::namedDataCount(this->shapeUserDefinedAttributes(labelProduct)) > 0)
+            continue;
+
+        const TopoDS_Shape shapeProduct = XCaf::shape(labelProduct);
+        std::vector<KeptProduct>& vecKept = mapFingerprintProducts[ProductFingerprint::compute(shapeProduct)];
+        std::optional<std::string> strBRep;
+        const KeptProduct* ptrKept = nullptr;
+        for (KeptProduct& kept : vecKept) {
+            if (!fnSameAttributes(labelProduct, kept.label))
+                continue;
+
+            if (!kept.strBRep)
+                kept.strBRep = BRepUtils::shapeToString(XCaf::shape(kept.label));
+
+            if (!strBRep)
+                strBRep = BRepUtils::shapeToString(shapeProduct);
+
+            if (*strBRep == *kept.strBRep) {
+                ptrKept = &kept;
+                break;
+            }
+        }
+
+        if (ptrKept)
+            vecDuplicate.push_back({ labelProduct, ptrKept->label, strBRep->size() });
+        else
+            vecKept.push_back({ labelProduct, std::move(strBRep) });
+    }
+
+    if (vecDuplicate.empty())
+        return result;
+
+    // Redirect the references, as XCAFDoc_ShapeTool::AddComponent() would do
+    const OccHandle<XCAFDoc_ShapeTool> shapeTool = this->shapeTool();
+    for (const Duplicate& duplicate : vecDuplicate) {
+        NCollection_Sequence<TDF_Label> seqReference;
+        XCAFDoc_ShapeTool::GetUsers(duplicate.labelProduct, seqReference, false/*!getSubChildren*/);
+        auto mainNode = TDataStd_TreeNode::Set(duplicate.labelKept, XCAFDoc::ShapeRefGUID());
+        for (const TDF_Label& labelReference : seqReference) {
+            OccHandle<TDataStd_TreeNode> refNode;
+            if (labelReference.FindAttribute(XCAFDoc::ShapeRefGUID(), refNode)) {
+                refNode->Remove();
+                mainNode->Append(refNode);
+                ++result.referenceCount;
+            }
+        }
+
+        if (shapeTool->RemoveShape(duplicate.labelProduct, false/*!removeCompletely*/)) {
+            ++result.duplicateCount;
+            result.savedMemorySize += duplicate.brepSize;
+        }
+    }
+
+    // Rebuild the compound shapes of assemblies, they now share the kept products
+    shapeTool->UpdateAssemblies();
+    return result;
+}
+
 OccHandle<TDataStd_NamedData> XCaf::shapeUserDefinedAttributes(const TDF_Label& lbl) const
 {
     if (lbl.IsNull())
@@ -354,9 +621,7 @@ OccHandle<TDataStd_NamedData> XCaf::shapeUserDefinedAttributes(const TDF_Label&
 
 TreeNodeId XCaf::deepBuildAssemblyTree(TreeNodeId parentNode, const TDF_Label& label)
 {
-    Expects(m_modelTree != nullptr);
-
-    const TreeNodeId node = m_modelTree->appendChild(parentNode, label);
+    const TreeNodeId node = this->appendModelTreeNode(parentNode, label);
     if (XCaf::isShapeAssembly(label)) {
         for (const TDF_Label& child : XCaf::shapeComponents(label))
             this->deepBuildAssemblyTree(node, child);
@@ -369,4 +634,18 @@ TreeNodeId XCaf::deepBuildAssemblyTree(TreeNodeId parentNode, const TDF_Label& l
     return node;
 }
 
+TreeNodeId XCaf::appendModelTreeNode(TreeNodeId parentNode, const TDF_Label& label)
+{
+    Expects(m_modelTree != nullptr);
+
+    const TreeNodeId node = m_modelTree->appendChild(parentNode, label);
+    if (m_modelTreeIndex)
+        m_modelTreeIndex->insert({ label, node });
+
+    if (m_labelDataFlagsCache && m_labelDataFlagsCache->find(label) == m_labelDataFlagsCache->end())
+        m_labelDataFlagsCache->insert({ label, computeLabelDataFlags(label) });
+
+    return node;
+}
+
 } // namespace Mayo
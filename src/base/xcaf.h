@@ -5,6 +5,8 @@
 
 #pragma once
 
+#include "caf_utils.h"
+#include "label_data.h"
 #include "libtree.h"
 #include "occ_handle.h"
 #include "quantity.h"
@@ -22,9 +24,20 @@
 #if OCC_VERSION_HEX < 0x070400
 #  include <TDataStd_NamedData.hxx>
 #endif
+#include <functional>
+#include <unordered_map>
 
 namespace Mayo {
 
+// Hash index of the model tree nodes by label
+// A label can be mapped to multiple tree nodes(eg product shared by several instances)
+using LabelTreeNodeIndex = std::unordered_multimap<TDF_Label, TreeNodeId>;
+
+// Data flags of labels, cached when the model tree is built(see findLabelDataFlags())
+// It lives outside of the OCAF data framework, so it's neither part of undo/redo deltas nor copied
+// or saved along with the labels
+using LabelDataFlagsCache = std::unordered_map<TDF_Label, LabelDataFlags>;
+
 // Closely related to Mayo::Document
 class XCaf {
 public:
@@ -93,11 +106,39 @@ public:
     TopLoc_Location shapeAbsoluteLocation(TreeNodeId nodeId) const;
     static TopLoc_Location shapeAbsoluteLocation(const Tree<TDF_Label>& modelTree, TreeNodeId nodeId);
     static TopLoc_Location shapeReferenceLocation(const TDF_Label& lbl);
+
+    // Pre-order traversal of the sub-tree of 'modelTree' starting at node 'id', 'fnCallback' is called
+    // for each node along with the absolute location of the node shape
+    // Locations are accumulated while going down the tree, so it's a single location composition per
+    // node instead of the parent chain walk done by shapeAbsoluteLocation()
+    using TraverseTreeWithLocationCallback = std::function<void(TreeNodeId, const TopLoc_Location&)>;
+    static void traverseTreeWithLocation(
+            const Tree<TDF_Label>& modelTree, TreeNodeId id, const TraverseTreeWithLocationCallback& fnCallback
+    );
+    static void traverseTreeWithLocation(
+            const Tree<TDF_Label>& modelTree, const TraverseTreeWithLocationCallback& fnCallback
+    );
     static TDF_Label shapeReferred(const TDF_Label& lbl);
 
     // Returns labels of the top-level free shapes that were not found in 'seqOther'
     NCollection_Sequence<TDF_Label> diffTopLevelFreeShapes(const NCollection_Sequence<TDF_Label>& seqOther) const;
 
+    // Finds the products(simple shapes referred by assemblies) below entities 'seqEntity' that are
+    // exact geometric duplicates of each other. References to duplicates are then redirected to a
+    // single product and the duplicates are removed
+    // Products are first grouped by fingerprint(topology counts, surface types of faces and vertex
+    // positions), then products having the same fingerprint are compared by their BRep
+    // serialization. Duplicates must also have the same name, color, layers and material as the
+    // kept product, otherwise these attributes would be lost. Products having sub-shape labels(eg
+    // colored faces) or user-defined attributes are left untouched
+    struct DeduplicateProductsResult {
+        int productCount = 0; // Count of inspected products
+        int duplicateCount = 0; // Count of removed products
+        int referenceCount = 0; // Count of redirected references
+        size_t savedMemorySize = 0; // Estimated from the BRep serialization(topology, geometry, triangulations) of removed products
+    };
+    DeduplicateProductsResult deduplicateProducts(const NCollection_Sequence<TDF_Label>& seqEntity);
+
     OccHandle<TDataStd_NamedData> shapeUserDefinedAttributes(const TDF_Label& lbl) const;
 
     // --
@@ -128,12 +169,19 @@ private:
     XCaf() = default;
 
     TreeNodeId deepBuildAssemblyTree(TreeNodeId parentNode, const TDF_Label& label);
+    // Appends 'label' in the model tree, registers the new node in the model tree index and caches
+    // the data flags of 'label'
+    TreeNodeId appendModelTreeNode(TreeNodeId parentNode, const TDF_Label& label);
     void setLabelMain(const TDF_Label& labelMain) { m_labelMain = labelMain; }
     void setModelTree(Tree<TDF_Label>& modelTree) { m_modelTree = &modelTree; }
+    void setModelTreeIndex(LabelTreeNodeIndex& index) { m_modelTreeIndex = &index; }
+    void setLabelDataFlagsCache(LabelDataFlagsCache& cache) { m_labelDataFlagsCache = &cache; }
 
     friend class Document;
     TDF_Label m_labelMain;
     Tree<TDF_Label>* m_modelTree = nullptr;
+    LabelTreeNodeIndex* m_modelTreeIndex = nullptr;
+    LabelDataFlagsCache* m_labelDataFlagsCache = nullptr;
 };
 
 } // namespace Mayo
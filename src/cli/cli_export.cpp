@@ -8,17 +8,27 @@
 #include "console.h"
 #include "../app/app_module.h"
 #include "../base/application.h"
+#include "../base/caf_utils.h"
+#include "../base/document.h"
 #include "../base/io_system.h"
 #include "../base/messenger.h"
+#include "../base/string_conv.h"
 #include "../base/task_manager.h"
+#include "../base/task_progress_dispatcher.h"
+#include "../io_image/io_image.h"
 #include "../qtcommon/qstring_conv.h"
 
 #include <Message.hxx>
+#include <Standard_Failure.hxx>
 
+#include <QtCore/QTimer>
 #include <QtCore/QtDebug>
 
 #include <fmt/format.h>
+#include <algorithm>
 #include <atomic>
+#include <cctype>
+#include <chrono>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -42,7 +52,16 @@ struct TaskStatus {
 struct Helper : public QObject {
     // Task manager object to be used
     TaskManager taskMgr;
-    // Counter decremented for each finished export task, when 0 is reached then quit
+    // Coalesces progress updates of the tasks, so console is printed at most once per flush
+    TaskProgressDispatcher progressDispatcher{ &taskMgr, [=]{
+        QTimer::singleShot(0, this, [=]{
+            QTimer::singleShot(TaskProgressDispatcher::FlushInterval_ms, this, [=]{
+                this->progressDispatcher.flush();
+            });
+        });
+    }};
+    // Counter decremented for each finished export task(including rendering of views), when 0 is
+    // reached then quit
     std::atomic<int> exportTaskCount = {};
     // Mapping between a task id and the task status
     std::unordered_map<TaskId, std::unique_ptr<TaskStatus>> mapTaskStatus;
@@ -50,8 +69,27 @@ struct Helper : public QObject {
     std::unordered_map<TaskId, int> mapTaskLineWidth;
     // Count of progress lines in console after last call to printTaskProgress()
     int lastPrintProgressLineCount = 0;
+    // Performance reports of the import and export tasks, filled only if requested by CliExportArgs
+    IO::PerformanceReport importReport;
+    std::unordered_map<TaskId, IO::PerformanceReport> mapExportReport;
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
 };
 
+// Merges the performance reports of all tasks into a single one, total time being the wall-clock
+// time as export tasks run concurrently
+IO::PerformanceReport mergedPerformanceReport(const Helper* helper)
+{
+    IO::PerformanceReport report = helper->importReport;
+    for (const auto& [taskId, exportReport] : helper->mapExportReport) {
+        report.files.insert(report.files.end(), exportReport.files.cbegin(), exportReport.files.cend());
+        report.peakMemoryDelta = std::max(report.peakMemoryDelta, exportReport.peakMemoryDelta);
+    }
+
+    const auto elapsedTime = std::chrono::steady_clock::now() - helper->startTime;
+    report.totalTime_ms = std::chrono::duration<double, std::milli>(elapsedTime).count();
+    return report;
+}
+
 void printTaskProgress(Helper* helper, TaskId taskId)
 {
     std::string strMessage = helper->taskMgr.title(taskId);
@@ -112,8 +150,10 @@ bool importInDocument(DocumentPtr doc, const CliExportArgs& args, Helper* helper
         })
         .withEntityPostProcessRequiredIf([=](IO::Format){ return brepMeshRequired; })
         .withEntityPostProcessInfoProgress(20, CliExport::textIdTr("Mesh BRep shapes"))
+        .withTransferInScratchDocuments(true)
         .withMessenger(&errorCollect)
         .withTaskProgress(progress)
+        .withPerformanceReport(args.statsFormat != CliExportArgs::StatsFormat::None ? &helper->importReport : nullptr)
         .execute();
     helper->taskMgr.setTitle(progress->taskId(), okImport ? CliExport::textIdTr("Imported") : errorCollect.asString(" "));
     helper->mapTaskStatus.at(progress->taskId())->success = okImport;
@@ -128,6 +168,8 @@ void exportDocument(const DocumentPtr& doc, const FilePath& filepath, Helper* he
     errorCollect.only(MessageType::Error);
     const IO::Format format = appModule->ioSystem()->probeFormat(filepath);
     const ApplicationItem appItems[] = { ApplicationItem{doc} };
+    auto itReport = helper->mapExportReport.find(progress->taskId());
+    IO::PerformanceReport* report = itReport != helper->mapExportReport.end() ? &itReport->second : nullptr;
     const bool okExport = appModule->ioSystem()->exportApplicationItems()
                 .targetFile(filepath)
                 .targetFormat(format)
@@ -135,6 +177,7 @@ void exportDocument(const DocumentPtr& doc, const FilePath& filepath, Helper* he
                 .withParameters(appModule->findWriterParameters(format))
                 .withMessenger(&errorCollect)
                 .withTaskProgress(progress)
+                .withPerformanceReport(report)
                 .execute();
     const std::string strFilename = filepath.filename().u8string();
     const std::string msg =
@@ -147,6 +190,71 @@ void exportDocument(const DocumentPtr& doc, const FilePath& filepath, Helper* he
     --(helper->exportTaskCount);
 }
 
+// Renders the standard views of each entity in 'doc' into PNG files of CliExportArgs::dirExportViews
+// Image files are named "<entityIndex>_<entityName>_<viewName>.png"
+void exportDocumentViews(const DocumentPtr& doc, const CliExportArgs& args, Helper* helper, TaskProgress* progress)
+{
+    auto appModule = AppModule::get();
+    IO::ImageWriter imageWriter(args.guiApp);
+    imageWriter.applyProperties(appModule->findWriterParameters(IO::Format_Image));
+
+    // Replace characters which could be invalid in file names
+    auto fnSanitizedName = [](std::string name) {
+        for (char& c : name) {
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_')
+                c = '_';
+        }
+
+        return name;
+    };
+
+    std::vector<IO::ImageBatchRenderer::Job> vecJob;
+    int entityIndex = 0;
+    for (TreeNodeId entityId : doc->allEntityNodeIds()) {
+        ++entityIndex;
+        const TDF_Label entityLabel = doc->modelTreeNodeLabel(entityId);
+        const std::string entityName = fnSanitizedName(to_stdString(CafUtils::labelAttrStdName(entityLabel)));
+        for (const IO::ImageBatchRenderer::StandardView& view : IO::ImageBatchRenderer::standardViews()) {
+            IO::ImageBatchRenderer::Job job;
+            job.doc = doc;
+            job.entityId = entityId;
+            job.cameraOrientation = view.cameraOrientation;
+            job.filepath = args.dirExportViews / fmt::format("{}_{}_{}.png", entityIndex, entityName, view.name);
+            vecJob.push_back(std::move(job));
+        }
+    }
+
+    std::error_code errorCode;
+    std_filesystem::create_directories(args.dirExportViews, errorCode);
+    int imageCount = 0;
+    std::string strError;
+    try {
+        IO::ImageBatchRenderer renderer(args.guiApp, imageWriter.constParameters());
+        imageCount = renderer.run(vecJob, progress);
+    } catch (const Standard_Failure& err) {
+        strError = err.GetMessageString();
+    }
+
+    const bool ok = imageCount == int(vecJob.size());
+    const std::string msg =
+            ok ?
+                fmt::format(CliExport::textIdTr("Exported {} views"), imageCount) :
+                fmt::format(CliExport::textIdTr("Exported {}/{} views {}"), imageCount, vecJob.size(), strError);
+    helper->taskMgr.setTitle(progress->taskId(), msg);
+    helper->mapTaskStatus.at(progress->taskId())->success = ok;
+    helper->mapTaskStatus.at(progress->taskId())->finished = true;
+    --(helper->exportTaskCount);
+}
+
+void skipExportDocument(const FilePath& filepath, Helper* helper, TaskProgress* progress)
+{
+    const std::string strFilename = filepath.filename().u8string();
+    helper->taskMgr.setTitle(progress->taskId(), fmt::format(CliExport::textIdTr("Skipped export of {}"), strFilename));
+    helper->mapTaskStatus.at(progress->taskId())->success = false;
+    helper->mapTaskStatus.at(progress->taskId())->finished = true;
+    --(helper->exportTaskCount);
+}
+
 } // namespace
 
 void cli_asyncExportDocuments(
@@ -160,6 +268,13 @@ void cli_asyncExportDocuments(
 
     // Helper function to exit current function
     auto fnExit = [=](int retCode) {
+        if (args.statsFormat != CliExportArgs::StatsFormat::None) {
+            const IO::PerformanceReport report = mergedPerformanceReport(helper);
+            const bool isJson = args.statsFormat == CliExportArgs::StatsFormat::Json;
+            std::cout << (isJson ? report.toJson() : report.toText());
+            std::cout.flush();
+        }
+
         helper->deleteLater();
         fnContinuation(retCode);
     };
@@ -191,12 +306,13 @@ void cli_asyncExportDocuments(
                 qCritical() << to_QString(taskMgr->title(taskId));
         }
     });
-    taskMgr->signalProgressChanged.connectSlot([=]{
+    helper->progressDispatcher.signalFlushed.connectSlot([=]{
         if (args.progressReport)
             fnPrintProgress();
     });
 
-    helper->exportTaskCount = int(args.filesToExport.size());
+    const bool hasExportViews = !args.dirExportViews.empty() && args.guiApp;
+    helper->exportTaskCount = int(args.filesToExport.size()) + (hasExportViews ? 1 : 0);
     taskMgr->signalEnded.connectSlot([=]{
         if (helper->exportTaskCount == 0) {
             bool okExport = true;
@@ -212,31 +328,42 @@ void cli_asyncExportDocuments(
     // Suppress output from OpenCascade
     Message::DefaultMessenger()->RemovePrinters(Message_Printer::get_type_descriptor());
 
-    // Execute import operation(synchronous)
+    // Export operations are continuations of the import operation, all executed asynchronously
     DocumentPtr doc = app->newDocument();
-    bool okImport = true;
-    const TaskId importTaskId = taskMgr->newTask([&](TaskProgress* progress) {
-            okImport = importInDocument(doc, args, helper, progress);
+    const TaskId importTaskId = taskMgr->newTask([=](TaskProgress* progress) {
+        importInDocument(doc, args, helper, progress);
     });
     helper->mapTaskStatus.insert({ importTaskId, std::make_unique<TaskStatus>() });
     taskMgr->setTitle(importTaskId, CliExport::textIdTr("Importing..."));
-    taskMgr->exec(importTaskId, TaskAutoDestroy::Off);
-    if (!okImport)
-        return fnExit(EXIT_FAILURE); // Error
 
-    // Run export operations(asynchronous)
     for (const FilePath& filepath : args.filesToExport) {
-        const TaskId taskId = taskMgr->newTask([=](TaskProgress* progress) {
-            exportDocument(doc, filepath, helper, progress);
+        const TaskId taskId = taskMgr->newContinuation(importTaskId, [=](TaskProgress* progress) {
+            if (helper->mapTaskStatus.at(importTaskId)->success)
+                exportDocument(doc, filepath, helper, progress);
+            else
+                skipExportDocument(filepath, helper, progress);
         });
         const std::string strFilename = filepath.filename().u8string();
         helper->mapTaskStatus.insert({ taskId, std::make_unique<TaskStatus>() });
+        if (args.statsFormat != CliExportArgs::StatsFormat::None)
+            helper->mapExportReport.insert({ taskId, {} });
+
         taskMgr->setTitle(taskId, fmt::format(CliExport::textIdTr("Exporting {}..."), strFilename));
     }
 
+    if (hasExportViews) {
+        const TaskId taskId = taskMgr->newContinuation(importTaskId, [=](TaskProgress* progress) {
+            if (helper->mapTaskStatus.at(importTaskId)->success)
+                exportDocumentViews(doc, args, helper, progress);
+            else
+                skipExportDocument(args.dirExportViews, helper, progress);
+        });
+        helper->mapTaskStatus.insert({ taskId, std::make_unique<TaskStatus>() });
+        taskMgr->setTitle(taskId, CliExport::textIdTr("Exporting views..."));
+    }
+
     taskMgr->foreachTask([=](TaskId taskId) {
-        if (taskId != importTaskId)
-            taskMgr->run(taskId, TaskAutoDestroy::Off);
+        taskMgr->run(taskId, TaskAutoDestroy::Off);
     });
 }
 
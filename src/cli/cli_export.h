@@ -13,11 +13,23 @@
 
 namespace Mayo {
 
+class GuiApplication;
+
 // Contains arguments for the cli_asyncExportDocuments() function
 struct CliExportArgs {
+    // Format of the performance report(see IO::PerformanceReport) printed once all operations are
+    // finished, None for no report
+    enum class StatsFormat { None, Text, Json };
+
     bool progressReport = true;
+    StatsFormat statsFormat = StatsFormat::None;
     gsl::span<const FilePath> filesToOpen;
     gsl::span<const FilePath> filesToExport;
+    // Output directory of the standard views images(see IO::ImageBatchRenderer) of the imported
+    // entities. No image is rendered if empty
+    FilePath dirExportViews;
+    // Required to render images
+    GuiApplication* guiApp = nullptr;
 };
 
 // Asynchronously exports input file(s) listed in 'args'
@@ -8,6 +8,7 @@
 #include "../base/application.h"
 #include "../base/io_system.h"
 #include "../base/settings.h"
+#include "../base/tracing.h"
 #include "../graphics/graphics_mesh_object_driver.h"
 #include "../graphics/graphics_point_cloud_object_driver.h"
 #include "../graphics/graphics_shape_object_driver.h"
@@ -43,6 +44,7 @@
 #include <OpenGl_GraphicDriver.hxx>
 
 #include <fmt/format.h>
+#include <gsl/util>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -67,12 +69,15 @@ struct CommandLineArguments {
     FilePath filepathUseSettings;
     FilePath filepathWriteSettings;
     FilePath filepathLog;
+    FilePath filepathTrace;
+    FilePath dirExportViews;
     std::vector<FilePath> listFilepathToExport;
     std::vector<FilePath> listFilepathToOpen;
     bool cacheUseSettings = false;
     bool includeDebugLogs = true;
     bool progressReport = true;
     bool showSystemInformation = false;
+    CliExportArgs::StatsFormat statsFormat = CliExportArgs::StatsFormat::None;
 };
 
 // Helper to filter out AppModule settings that are not useful for MayoConv application
@@ -224,6 +229,15 @@ static CommandLineArguments processCommandLine()
     );
     cmdParser.addOption(cmdFileToExport);
 
+    const QCommandLineOption cmdExportViews(
+        QStringList{ "export-views" },
+        Main::tr("Render the standard views(front, back, left, right, top, bottom) of each opened "
+                 "entity into PNG files of output directory. Image options are the ones of image "
+                 "export settings"),
+        Main::tr("directory")
+    );
+    cmdParser.addOption(cmdExportViews);
+
     const QCommandLineOption cmdLogFile(
         QStringList{ "log-file" },
         Main::tr("Writes log messages into output file"),
@@ -231,6 +245,13 @@ static CommandLineArguments processCommandLine()
     );
     cmdParser.addOption(cmdLogFile);
 
+    const QCommandLineOption cmdTraceFile(
+        QStringList{ "trace-file" },
+        Main::tr("Records profiling traces and writes them on exit into output file(Chrome trace-event JSON format)"),
+        Main::tr("filepath")
+    );
+    cmdParser.addOption(cmdTraceFile);
+
     const QCommandLineOption cmdDebugLogs(
         QStringList{ "debug-logs" },
         Main::tr("Don't filter out debug log messages in release build")
@@ -243,6 +264,14 @@ static CommandLineArguments processCommandLine()
     );
     cmdParser.addOption(cmdNoProgress);
 
+    const QCommandLineOption cmdStats(
+        QStringList{ "stats" },
+        Main::tr("Print on exit a performance report of import/export operations(stage timings, "
+                 "memory high-water marks, ...). Format is either 'text' or 'json'"),
+        Main::tr("format")
+    );
+    cmdParser.addOption(cmdStats);
+
     const QCommandLineOption cmdSysInfo(
         QStringList{ "system-info" },
         Main::tr("Show detailed system information and quit")
@@ -275,11 +304,17 @@ static CommandLineArguments processCommandLine()
     if (cmdParser.isSet(cmdLogFile))
         args.filepathLog = filepathFrom(cmdParser.value(cmdLogFile));
 
+    if (cmdParser.isSet(cmdTraceFile))
+        args.filepathTrace = filepathFrom(cmdParser.value(cmdTraceFile));
+
     if (cmdParser.isSet(cmdFileToExport)) {
         for (const QString& strFilepath : cmdParser.values(cmdFileToExport))
             args.listFilepathToExport.push_back(filepathFrom(strFilepath));
     }
 
+    if (cmdParser.isSet(cmdExportViews))
+        args.dirExportViews = filepathFrom(cmdParser.value(cmdExportViews));
+
     for (const QString& posArg : cmdParser.positionalArguments())
         args.listFilepathToOpen.push_back(filepathFrom(posArg));
 
@@ -289,6 +324,19 @@ static CommandLineArguments processCommandLine()
 #endif
     args.progressReport = !cmdParser.isSet(cmdNoProgress);
     args.showSystemInformation = cmdParser.isSet(cmdSysInfo);
+    if (cmdParser.isSet(cmdStats)) {
+        const QString strStatsFormat = cmdParser.value(cmdStats);
+        if (strStatsFormat == "text") {
+            args.statsFormat = CliExportArgs::StatsFormat::Text;
+        }
+        else if (strStatsFormat == "json") {
+            args.statsFormat = CliExportArgs::StatsFormat::Json;
+        }
+        else {
+            qCritical().noquote() << Main::tr("Unknown stats format '%1'").arg(strStatsFormat);
+            std::exit(EXIT_FAILURE);
+        }
+    }
 
     return args;
 }
@@ -389,6 +437,16 @@ static int runApp(QCoreApplication* qtApp)
     LogMessageHandler::instance().enableDebugLogs(args.includeDebugLogs);
     LogMessageHandler::instance().setOutputFilePath(args.filepathLog);
 
+    // Profiling traces, written when application quits
+    Tracing::setEnabled(!args.filepathTrace.empty());
+    auto _ = gsl::finally([&]{
+        if (!args.filepathTrace.empty()) {
+            Tracing::setEnabled(false);
+            if (!Tracing::writeChromeTraceFile(args.filepathTrace))
+                qCritical().noquote() << Main::tr("Failed to write trace file [path=%1]").arg(filepathTo<QString>(args.filepathTrace));
+        }
+    });
+
     // Initialize AppModule
     auto appModule = AppModule::get();
     appModule->settings()->setStorage(std::make_unique<QSettingsStorage>());
@@ -464,17 +522,20 @@ static int runApp(QCoreApplication* qtApp)
 
     int exitCode = EXIT_SUCCESS;
     if (args.listFilepathToOpen.empty()) {
-        if (!args.listFilepathToExport.empty()) {
+        if (!args.listFilepathToExport.empty() || !args.dirExportViews.empty()) {
             qCritical() << Main::tr("No input files -> nothing to export");
             exitCode = EXIT_FAILURE;
         }
     }
     else {
-        QTimer::singleShot(0, qtApp, [=]{
+        QTimer::singleShot(0, qtApp, [=, guiApp = guiApp.get()]{
             CliExportArgs cliArgs;
             cliArgs.progressReport = args.progressReport;
+            cliArgs.statsFormat = args.statsFormat;
             cliArgs.filesToOpen = args.listFilepathToOpen;
             cliArgs.filesToExport = args.listFilepathToExport;
+            cliArgs.dirExportViews = args.dirExportViews;
+            cliArgs.guiApp = guiApp;
             cli_asyncExportDocuments(app, cliArgs, [=](int retcode) { qtApp->exit(retcode); });
         });
         exitCode = qtApp->exec();
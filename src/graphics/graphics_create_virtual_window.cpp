@@ -20,6 +20,7 @@
 
 #include <Aspect_DisplayConnection.hxx>
 #include <Graphic3d_GraphicDriver.hxx>
+#include <Standard_Version.hxx>
 #if defined(MAYO_OS_WINDOWS)
 #  include <WNT_WClass.hxx>
 #  include <WNT_Window.hxx>
@@ -28,11 +29,28 @@
 #elif defined(MAYO_OS_ANDROID)
 #  include <Aspect_NeutralWindow.hxx>
 #else
+#  include <Aspect_NeutralWindow.hxx>
 #  include <Xw_Window.hxx>
 #endif
 
 namespace Mayo {
 
+#if !defined(MAYO_OS_WINDOWS) && !defined(MAYO_OS_MAC) && !defined(MAYO_OS_ANDROID)
+// Whether 'displayConn' is bound to a X server
+// This is never the case when OpenCascade is built without Xlib(option USE_XLIB=OFF)
+static bool hasXDisplay(const OccHandle<Aspect_DisplayConnection>& displayConn)
+{
+    if (displayConn.IsNull())
+        return false;
+
+#if OCC_VERSION_HEX >= 0x070600
+    return displayConn->GetDisplayAspect() != nullptr;
+#else
+    return displayConn->GetDisplay() != nullptr;
+#endif
+}
+#endif
+
 OccHandle<Aspect_Window> graphicsCreateVirtualWindow(
         [[maybe_unused]]const OccHandle<Graphic3d_GraphicDriver>& gfxDriver, int wndWidth, int wndHeight
     )
@@ -53,6 +71,16 @@ OccHandle<Aspect_Window> graphicsCreateVirtualWindow(
     wnd->SetSize(wndWidth, wndHeight);
 #else
     auto displayConn = gfxDriver->GetDisplayConnection();
+    if (!hasXDisplay(displayConn)) {
+        // OpenCascade renders through EGL, a virtual neutral window is then drawn offscreen into
+        // an EGL pbuffer surface. No display server is needed, which allows rendering on headless
+        // machines(eg with Mesa llvmpipe software rasterizer)
+        auto wnd = new Aspect_NeutralWindow;
+        wnd->SetSize(wndWidth, wndHeight);
+        wnd->SetVirtual(true);
+        return wnd;
+    }
+
     auto wnd = new Xw_Window(displayConn, "", 0, 0, wndWidth, wndHeight);
 #endif
 
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../base/fast_signal.h"
 #include "../base/occ_handle.h"
 #include "../base/signal.h"
 #include "graphics_object_ptr.h"
@@ -104,7 +105,7 @@ public:
     GraphicsOwnerPtr findSelectedOwner(Predicate fn) const;
 
     // Signals
-    Signal<> signalSelectionChanged;
+    FastSignal<> signalSelectionChanged;
     Signal<> signalSelectionModeChanged;
     Signal<const OccHandle<V3d_View>&> signalRedrawRequested;
 
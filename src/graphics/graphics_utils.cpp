@@ -226,7 +226,12 @@ NCollection_Vec2<int> GraphicsUtils::AspectWindow_size(const OccHandle<Aspect_Wi
 OccHandle<Aspect_DisplayConnection> GraphicsUtils::AspectDisplayConnection_create()
 {
 #if (!defined(MAYO_OS_WINDOWS) && (!defined(MAYO_OS_MAC) || defined(MACOSX_USE_GLX)))
-    return new Aspect_DisplayConnection(std::getenv("DISPLAY"));
+    const char* strDisplay = std::getenv("DISPLAY");
+    if (strDisplay)
+        return new Aspect_DisplayConnection(strDisplay);
+
+    // No X display(eg headless machine), OpenCascade built without Xlib can still render with EGL
+    return new Aspect_DisplayConnection;
 #else
     return new Aspect_DisplayConnection;
 #endif
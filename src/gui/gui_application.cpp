@@ -8,6 +8,7 @@
 #include "../base/application.h"
 #include "../base/application_item_selection_model.h"
 #include "../base/document.h"
+#include "../base/task_executor.h"
 #include "gui_document.h"
 
 #include <unordered_set>
@@ -40,6 +41,7 @@ struct GuiApplication::Private {
     GuiApplication* m_backPtr = nullptr;
     ApplicationPtr m_app;
     std::vector<GuiDocument*> m_vecGuiDocument;
+    TaskExecutor m_taskExecutor;
     std::vector<GraphicsObjectDriverPtr> m_vecGfxObjectDriver;
     SignalConnectionHandle m_connApplicationItemSelectionChanged;
     ApplicationItemSelectionModel m_selectionModel;
@@ -137,6 +139,11 @@ GraphicsObjectDriverPtr GuiApplication::findCompatibleGraphicsObjectDriver(const
     return {};
 }
 
+TaskExecutor& GuiApplication::taskExecutor() const
+{
+    return d->m_taskExecutor;
+}
+
 bool GuiApplication::automaticDocumentMapping() const
 {
     return d->m_automaticDocumentMapping;
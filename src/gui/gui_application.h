@@ -16,6 +16,7 @@
 namespace Mayo {
 
 class GuiDocument;
+class TaskExecutor;
 
 // Provides management of GuiDocument objects
 //
@@ -53,6 +54,10 @@ public:
     GraphicsObjectPtr createGraphicsObject(const TDF_Label& label) const;
     GraphicsObjectDriverPtr findCompatibleGraphicsObjectDriver(const TDF_Label& label) const;
 
+    // Pool of worker threads shared by the GUI application, eg for concurrent creation of graphics
+    // objects in GuiDocument. Can also be shared with TaskManager objects(see TaskManager ctor)
+    TaskExecutor& taskExecutor() const;
+
     // Whether a GuiDocument object is automatically created once a Document is added in Application
     bool automaticDocumentMapping() const;
     void setAutomaticDocumentMapping(bool on);
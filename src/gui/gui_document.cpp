@@ -11,8 +11,10 @@
 #include "../base/caf_utils.h"
 #include "../base/cpp_utils.h"
 #include "../base/document.h"
+#include "../base/libtree_parallel.h"
 #include "../base/math_utils.h"
 #include "../base/tkernel_utils.h"
+#include "../base/tracing.h"
 #include "../graphics/graphics_utils.h"
 #include "../gui/gui_application.h"
 
@@ -25,7 +27,12 @@
 #include <Graphic3d_GraphicDriver.hxx>
 #include <V3d_TypeOfOrientation.hxx>
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
 
 namespace Mayo {
 
@@ -135,7 +142,7 @@ GuiDocument::GuiDocument(const DocumentPtr& doc, GuiApplication* guiApp)
     for (TreeNodeId nodeId : doc->allEntityNodeIds())
         this->mapEntity(nodeId);
 
-    doc->signalEntityAdded.connectSlot(&GuiDocument::onDocumentEntityAdded, this);
+    doc->signalEntitiesAdded.connectSlot(&GuiDocument::onDocumentEntitiesAdded, this);
     doc->signalEntityAboutToBeDestroyed.connectSlot(&GuiDocument::onDocumentEntityAboutToBeDestroyed, this);
     m_gfxScene.signalSelectionChanged.connectSlot(&GuiDocument::onGraphicsSelectionChanged, this);
 }
@@ -254,13 +261,8 @@ TreeNodeId GuiDocument::nodeFromGraphicsObject(const GraphicsObjectPtr& gfxObjec
     if (!gfxObject)
         return 0;
 
-    for (const GraphicsEntity& gfxEntity: m_vecGraphicsEntity) {
-        auto it = gfxEntity.mapGfxObjectTreeNode.find(gfxObject);
-        if (it != gfxEntity.mapGfxObjectTreeNode.cend())
-            return it->second;
-    }
-
-    return 0;
+    auto it = m_mapGfxObjectTreeNode.find(gfxObject);
+    return it != m_mapGfxObjectTreeNode.cend() ? it->second : 0;
 }
 
 void GuiDocument::toggleNodeSelected(TreeNodeId nodeId)
@@ -581,10 +583,19 @@ void GuiDocument::setDefaultGradientBackground(const GradientBackground& gradien
     Internal::defaultGradientBackground() = gradientBkgnd;
 }
 
-void GuiDocument::onDocumentEntityAdded(TreeNodeId entityTreeNodeId)
+void GuiDocument::onDocumentEntitiesAdded(gsl::span<const TreeNodeId> spanEntityTreeNodeId)
 {
-    this->mapEntity(entityTreeNodeId);
-    BndUtils::add(&m_gfxBoundingBox, m_vecGraphicsEntity.back().bndBox);
+    {
+        // Graphics of all the entities are built in one batch, with a single redraw at the end
+        GraphicsSceneRedrawBlocker redrawBlocker(&m_gfxScene);
+        m_vecGraphicsEntity.reserve(m_vecGraphicsEntity.size() + spanEntityTreeNodeId.size());
+        for (TreeNodeId entityTreeNodeId : spanEntityTreeNodeId) {
+            this->mapEntity(entityTreeNodeId);
+            BndUtils::add(&m_gfxBoundingBox, m_vecGraphicsEntity.back().bndBox);
+        }
+    }
+
+    m_gfxScene.redraw();
     GraphicsUtils::V3dView_fitAll(m_v3dView, this->graphicsBoundingBox(OnlySelectedGraphics | OnlyVisibleGraphics));
     this->signalGraphicsBoundingBoxChanged.send(m_gfxBoundingBox);
 }
@@ -612,6 +623,7 @@ void GuiDocument::onGraphicsSelectionChanged()
     }
 
     std::vector<ApplicationItem> vecSelected;
+    std::unordered_set<ApplicationItem> setSelected;
     m_gfxScene.foreachSelectedOwner([&](const GraphicsOwnerPtr& gfxOwner) {
         auto gfxObject = GraphicsObjectPtr::DownCast(
             gfxOwner ? gfxOwner->Selectable() : OccHandle<SelectMgr_SelectableObject>()
@@ -619,7 +631,8 @@ void GuiDocument::onGraphicsSelectionChanged()
         const TreeNodeId nodeId = this->nodeFromGraphicsObject(gfxObject);
         if (nodeId != 0) {
             const ApplicationItem appItem({ m_document, nodeId });
-            vecSelected.push_back(std::move(appItem));
+            if (setSelected.insert(appItem).second)
+                vecSelected.push_back(appItem);
         }
     });
 
@@ -628,8 +641,7 @@ void GuiDocument::onGraphicsSelectionChanged()
         if (appItem.document() != m_document)
             continue;
 
-        auto it = std::find(vecSelected.cbegin(), vecSelected.cend(), appItem);
-        if (it == vecSelected.cend())
+        if (setSelected.find(appItem) == setSelected.cend())
             vecRemoved.push_back(appItem);
     }
 
@@ -642,56 +654,94 @@ void GuiDocument::onGraphicsSelectionChanged()
 
 void GuiDocument::mapEntity(TreeNodeId entityTreeNodeId)
 {
+    MAYO_TRACE_SCOPE("gui", "GuiDocument::mapEntity");
     const Tree<TDF_Label>& docModelTree = m_document->modelTree();
     GraphicsEntity gfxEntity;
     gfxEntity.treeNodeId = entityTreeNodeId;
+
+    // Graphics objects of the products are created concurrently while collecting the leaf tree
+    // nodes: creation doesn't involve the AIS context(objects are displayed afterwards by this
+    // thread) and graphics drivers only read the document
+    // Each product is created once, by the first thread reaching one of its instances
+    std::mutex mutexGfxProduct;
     std::unordered_map<TDF_Label, GraphicsObjectPtr> mapLabelGfxProduct;
+    using LeafNode = std::pair<TreeNodeId, TopLoc_Location>; // With absolute location
+    using VectorLeafNode = std::vector<LeafNode>;
+    auto fnMapLeafNode = [&](TreeNodeId id) {
+        VectorLeafNode vecLeafNode;
+        if (!docModelTree.nodeIsLeaf(id))
+            return vecLeafNode;
 
-    traverseTree(entityTreeNodeId, docModelTree, [&](TreeNodeId id) {
         const TDF_Label nodeLabel = docModelTree.nodeData(id);
-        if (docModelTree.nodeIsLeaf(id)) {
-            GraphicsObjectPtr gfxProduct = CppUtils::findValue(nodeLabel, mapLabelGfxProduct);
-            if (!gfxProduct) {
-                gfxProduct = m_guiApp->createGraphicsObject(nodeLabel);
-                if (!gfxProduct)
-                    return;
-
-                mapLabelGfxProduct.insert({ nodeLabel, gfxProduct });
-            }
+        bool isNewProduct = false;
+        {
+            std::lock_guard<std::mutex> lock(mutexGfxProduct);
+            isNewProduct = mapLabelGfxProduct.insert({ nodeLabel, GraphicsObjectPtr{} }).second;
+        }
+
+        if (isNewProduct) {
+            GraphicsObjectPtr gfxProduct = m_guiApp->createGraphicsObject(nodeLabel);
+            std::lock_guard<std::mutex> lock(mutexGfxProduct);
+            mapLabelGfxProduct[nodeLabel] = gfxProduct;
+        }
+
+        vecLeafNode.push_back({ id, XCaf::shapeAbsoluteLocation(docModelTree, id) });
+        return vecLeafNode;
+    };
+    auto fnConcatLeafNodes = [](VectorLeafNode lhs, VectorLeafNode rhs) {
+        if (lhs.size() < rhs.size())
+            std::swap(lhs, rhs);
 
-            if (!docModelTree.nodeIsRoot(id)) {
-                const TreeNodeId parentNodeId = docModelTree.nodeParent(id);
-                const TDF_Label parentNodeLabel = docModelTree.nodeData(parentNodeId);
-                if (XCaf::isShapeReference(parentNodeLabel) && m_document->xcaf().hasShapeColor(parentNodeLabel)) {
-                    // Parent node is a reference and it redefines color attribute, so the graphics
-                    // can't be shared with the product
-                    auto gfxObject = m_guiApp->createGraphicsObject(parentNodeLabel);
-                    const TreeNodeId grandParentNodeId = docModelTree.nodeParent(parentNodeId);
-                    const TopLoc_Location locGrandParentShape = XCaf::shapeAbsoluteLocation(docModelTree, grandParentNodeId);
-                    gfxObject->SetLocalTransformation(locGrandParentShape);
-                    gfxEntity.vecObject.emplace_back(gfxObject);
-                }
-                else {
-                    auto gfxInstance = makeOccHandle<AIS_ConnectedInteractive>();
-                    gfxInstance->Connect(gfxProduct, XCaf::shapeAbsoluteLocation(docModelTree, id));
-                    gfxInstance->SetDisplayMode(gfxProduct->DisplayMode());
-                    gfxInstance->Attributes()->SetFaceBoundaryDraw(gfxProduct->Attributes()->FaceBoundaryDraw());
-                    gfxInstance->SetOwner(gfxProduct->GetOwner());
-                    gfxEntity.vecObject.emplace_back(gfxInstance);
-                }
-
-                if (XCaf::isShapeReference(parentNodeLabel))
-                    id = docModelTree.nodeParent(id);
+        lhs.insert(lhs.end(), std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+        return lhs;
+    };
+    VectorLeafNode vecLeafNode = traverseTree_parallelReduce(
+        entityTreeNodeId, docModelTree, VectorLeafNode{}, fnMapLeafNode, fnConcatLeafNodes, m_guiApp->taskExecutor()
+    );
+    // Leaf nodes were collected in unspecified order, sort them so graphics objects are always
+    // created in the same order
+    std::sort(vecLeafNode.begin(), vecLeafNode.end(), [](const LeafNode& lhs, const LeafNode& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    for (const auto& [leafNodeId, locNode] : vecLeafNode) {
+        TreeNodeId id = leafNodeId;
+        const GraphicsObjectPtr gfxProduct = CppUtils::findValue(docModelTree.nodeData(id), mapLabelGfxProduct);
+        if (!gfxProduct)
+            continue;
+
+        if (!docModelTree.nodeIsRoot(id)) {
+            const TreeNodeId parentNodeId = docModelTree.nodeParent(id);
+            const TDF_Label parentNodeLabel = docModelTree.nodeData(parentNodeId);
+            if (XCaf::isShapeReference(parentNodeLabel) && m_document->xcaf().hasShapeColor(parentNodeLabel)) {
+                // Parent node is a reference and it redefines color attribute, so the graphics
+                // can't be shared with the product
+                auto gfxObject = m_guiApp->createGraphicsObject(parentNodeLabel);
+                const TreeNodeId grandParentNodeId = docModelTree.nodeParent(parentNodeId);
+                const TopLoc_Location locGrandParentShape = XCaf::shapeAbsoluteLocation(docModelTree, grandParentNodeId);
+                gfxObject->SetLocalTransformation(locGrandParentShape);
+                gfxEntity.vecObject.emplace_back(gfxObject);
             }
             else {
-                gfxEntity.vecObject.emplace_back(gfxProduct);
+                auto gfxInstance = makeOccHandle<AIS_ConnectedInteractive>();
+                gfxInstance->Connect(gfxProduct, locNode);
+                gfxInstance->SetDisplayMode(gfxProduct->DisplayMode());
+                gfxInstance->Attributes()->SetFaceBoundaryDraw(gfxProduct->Attributes()->FaceBoundaryDraw());
+                gfxInstance->SetOwner(gfxProduct->GetOwner());
+                gfxEntity.vecObject.emplace_back(gfxInstance);
             }
 
-            const GraphicsEntity::Object& lastGfxObject = gfxEntity.vecObject.back();
-            gfxEntity.mapTreeNodeGfxObject.insert({ id, lastGfxObject.ptr });
-            gfxEntity.mapGfxObjectTreeNode.insert({ lastGfxObject.ptr, id });
+            if (XCaf::isShapeReference(parentNodeLabel))
+                id = docModelTree.nodeParent(id);
         }
-    });
+        else {
+            gfxEntity.vecObject.emplace_back(gfxProduct);
+        }
+
+        const GraphicsEntity::Object& lastGfxObject = gfxEntity.vecObject.back();
+        gfxEntity.mapTreeNodeGfxObject.insert({ id, lastGfxObject.ptr });
+        m_mapGfxObjectTreeNode.insert({ lastGfxObject.ptr, id });
+    }
 
     for (const GraphicsEntity::Object& object : gfxEntity.vecObject) {
         m_gfxScene.addObject(object.ptr);
@@ -715,6 +765,7 @@ void GuiDocument::mapEntity(TreeNodeId entityTreeNodeId)
         m_mapTreeNodeCheckState.insert({ id, CheckState::On });
     });
 
+    m_mapEntityTreeNodeGfxEntityIndex.insert({ entityTreeNodeId, m_vecGraphicsEntity.size() });
     m_vecGraphicsEntity.push_back(std::move(gfxEntity));
 }
 
@@ -725,11 +776,18 @@ void GuiDocument::unmapEntity(TreeNodeId entityTreeNodeId)
         if (!ptrItem)
             return;
 
-        for (const GraphicsEntity::Object& object : ptrItem->vecObject)
+        for (const GraphicsEntity::Object& object : ptrItem->vecObject) {
             m_gfxScene.eraseObject(object.ptr);
+            m_mapGfxObjectTreeNode.erase(object.ptr);
+        }
 
         const auto indexItem = ptrItem - &m_vecGraphicsEntity.front();
         m_vecGraphicsEntity.erase(m_vecGraphicsEntity.begin() + indexItem);
+        // Entities after the erased one are shifted down
+        m_mapEntityTreeNodeGfxEntityIndex.erase(entityTreeNodeId);
+        for (auto i = size_t(indexItem); i < m_vecGraphicsEntity.size(); ++i)
+            m_mapEntityTreeNodeGfxEntityIndex[m_vecGraphicsEntity.at(i).treeNodeId] = i;
+
         m_gfxScene.redraw();
     }
 
@@ -740,12 +798,8 @@ void GuiDocument::unmapEntity(TreeNodeId entityTreeNodeId)
 
 const GuiDocument::GraphicsEntity* GuiDocument::findGraphicsEntity(TreeNodeId entityTreeNodeId) const
 {
-    auto itFound = std::find_if(
-        m_vecGraphicsEntity.cbegin(),
-        m_vecGraphicsEntity.cend(),
-        [=](const GraphicsEntity& item) { return item.treeNodeId == entityTreeNodeId; }
-    );
-    return itFound != m_vecGraphicsEntity.cend() ? &(*itFound) : nullptr;
+    auto itFound = m_mapEntityTreeNodeGfxEntityIndex.find(entityTreeNodeId);
+    return itFound != m_mapEntityTreeNodeGfxEntityIndex.cend() ? &m_vecGraphicsEntity.at(itFound->second) : nullptr;
 }
 
 void GuiDocument::applyExplodingFactor(const GraphicsEntity& entity, double t)
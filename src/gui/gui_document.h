@@ -6,6 +6,7 @@
 #pragma once
 
 #include "../base/document.h"
+#include "../base/fast_signal.h"
 #include "../base/global.h"
 #include "../base/signal.h"
 #include "../graphics/graphics_object_driver.h"
@@ -74,6 +75,7 @@ public:
     void foreachGraphicsObject(TreeNodeId nodeId, const std::function<void(GraphicsObjectPtr)>& fn) const;
 
     // Finds the tree node id associated to graphics object
+    // Complexity is O(1) on average
     TreeNodeId nodeFromGraphicsObject(const GraphicsObjectPtr& gfxObject) const;
 
     // Toggles selected status of a tree node(doesn't affect Application's selection model)
@@ -147,7 +149,7 @@ public:
 
     // Signals
     using MapVisibilityByTreeNodeId = std::unordered_map<TreeNodeId, CheckState>;
-    mutable Signal<const MapVisibilityByTreeNodeId&> signalNodesVisibilityChanged;
+    mutable FastSignal<const MapVisibilityByTreeNodeId&> signalNodesVisibilityChanged;
     mutable Signal<const Bnd_Box&> signalGraphicsBoundingBoxChanged;
     mutable Signal<ViewTrihedronMode> signalViewTrihedronModeChanged;
     mutable Signal<Aspect_TypeOfTriedronPosition> signalViewTrihedronCornerChanged;
@@ -155,7 +157,7 @@ public:
 
     // -- Implementation
 private:
-    void onDocumentEntityAdded(TreeNodeId entityTreeNodeId);
+    void onDocumentEntitiesAdded(gsl::span<const TreeNodeId> spanEntityTreeNodeId);
     void onDocumentEntityAboutToBeDestroyed(TreeNodeId entityTreeNodeId);
     void onGraphicsSelectionChanged();
 
@@ -173,7 +175,6 @@ private:
         TreeNodeId treeNodeId;
         std::vector<Object> vecObject;
         std::unordered_map<TreeNodeId, GraphicsObjectPtr> mapTreeNodeGfxObject;
-        std::unordered_map<GraphicsObjectPtr, TreeNodeId> mapGfxObjectTreeNode;
         Bnd_Box bndBox;
     };
 
@@ -197,6 +198,8 @@ private:
     OccHandle<AIS_InteractiveObject> m_aisViewCube;
 
     std::vector<GraphicsEntity> m_vecGraphicsEntity;
+    std::unordered_map<TreeNodeId, size_t> m_mapEntityTreeNodeGfxEntityIndex;
+    std::unordered_map<GraphicsObjectPtr, TreeNodeId> m_mapGfxObjectTreeNode;
     Bnd_Box m_gfxBoundingBox;
 
     std::unordered_map<GraphicsObjectDriverPtr, int> m_mapGfxDriverDisplayMode;
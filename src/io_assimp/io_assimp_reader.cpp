@@ -14,6 +14,7 @@
 #include "../base/messenger.h"
 #include "../base/occ_handle.h"
 #include "../base/property.h"
+#include "../base/property_enumeration.h"
 #include "../base/string_conv.h"
 #include "../base/task_progress.h"
 #include "../base/tkernel_utils.h"
@@ -26,6 +27,7 @@
 
 #include <fmt/format.h>
 
+#include <atomic>
 #include <cassert>
 #include <iostream>
 
@@ -33,6 +35,7 @@
 #include <gp_Trsf.hxx>
 #include <BRep_Builder.hxx>
 #include <Image_Texture.hxx>
+#include <OSD_Parallel.hxx>
 #include <Poly_Triangulation.hxx>
 #include <TDataStd_Name.hxx>
 #include <XCAFDoc_VisMaterial.hxx>
@@ -229,6 +232,44 @@ OccHandle<Image_Texture> createOccTexture(const aiTexture* texture)
     return new Image_Texture(buff, texture->mFilename.C_Str());
 }
 
+// Copy assimp vectors(single precision) into the nodes(double precision) of 'triangulation'
+// Poly_Triangulation::SetNode() is inline since OpenCascade 7.6, this allows the compiler to unroll
+// and vectorize the float->double conversion loop, which is not possible with MeshUtils::setNode()
+void copyNodes(const aiVector3D* vertices, unsigned count, const OccHandle<Poly_Triangulation>& triangulation)
+{
+#if OCC_VERSION_HEX >= 0x070600
+    Poly_Triangulation* ptrTriangulation = triangulation.get();
+    for (unsigned i = 0; i < count; ++i) {
+        const aiVector3D& vertex = vertices[i];
+        ptrTriangulation->SetNode(i + 1, gp_Pnt{ vertex.x, vertex.y, vertex.z });
+    }
+#else
+    for (unsigned i = 0; i < count; ++i) {
+        const aiVector3D& vertex = vertices[i];
+        MeshUtils::setNode(triangulation, i + 1, { vertex.x, vertex.y, vertex.z });
+    }
+#endif
+}
+
+// Copy assimp normals into the normals of 'triangulation'
+// Note: MeshUtils::allocateNormals() must have been called before
+void copyNormals(const aiVector3D* normals, unsigned count, const OccHandle<Poly_Triangulation>& triangulation)
+{
+    using OccNormal = MeshUtils::Poly_Triangulation_NormalType;
+#if OCC_VERSION_HEX >= 0x070600
+    Poly_Triangulation* ptrTriangulation = triangulation.get();
+    for (unsigned i = 0; i < count; ++i) {
+        const aiVector3D& normal = normals[i];
+        ptrTriangulation->SetNormal(i + 1, OccNormal{ normal.x, normal.y, normal.z });
+    }
+#else
+    for (unsigned i = 0; i < count; ++i) {
+        const aiVector3D& normal = normals[i];
+        MeshUtils::setNormal(triangulation, i + 1, OccNormal{ normal.x, normal.y, normal.z });
+    }
+#endif
+}
+
 // Create an OpenCascade Poly_Triangulation object from assimp mesh
 // The input 'mesh' is assumed to contain only triangles
 OccHandle<Poly_Triangulation> createOccTriangulation(const aiMesh* mesh)
@@ -240,10 +281,7 @@ OccHandle<Poly_Triangulation> createOccTriangulation(const aiMesh* mesh)
     const bool hasUvNodes = mesh->HasTextureCoords(textureIndex) && mesh->mNumUVComponents[textureIndex] == 2;
     auto triangulation = makeOccHandle<Poly_Triangulation>(mesh->mNumVertices, mesh->mNumFaces, hasUvNodes);
 
-    for (unsigned i = 0; i < mesh->mNumVertices; ++i) {
-        const aiVector3D& vertex = mesh->mVertices[i];
-        MeshUtils::setNode(triangulation, i + 1, { vertex.x, vertex.y, vertex.z });
-    }
+    copyNodes(mesh->mVertices, mesh->mNumVertices, triangulation);
 
     for (unsigned i = 0; i < mesh->mNumFaces; ++i) {
         const auto indices = mesh->mFaces[i].mIndices;
@@ -253,11 +291,7 @@ OccHandle<Poly_Triangulation> createOccTriangulation(const aiMesh* mesh)
 
     if (mesh->HasNormals()) {
         MeshUtils::allocateNormals(triangulation);
-        for (unsigned i = 0; i < mesh->mNumVertices; ++i) {
-            using OccNormal = MeshUtils::Poly_Triangulation_NormalType;
-            const aiVector3D& normal = mesh->mNormals[i];
-            MeshUtils::setNormal(triangulation, i + 1, OccNormal{ normal.x, normal.y, normal.z });
-        }
+        copyNormals(mesh->mNormals, mesh->mNumVertices, triangulation);
     }
 
     if (hasUvNodes) {
@@ -299,36 +333,54 @@ private:
 // --
 
 class AssimpReader::Properties : public PropertyGroup {
+    MAYO_DECLARE_TEXT_ID_FUNCTIONS(Mayo::IO::AssimpReader::Properties)
 public:
-    using PropertyGroup::PropertyGroup; // Inherit PropertyGroup constructors
+    explicit Properties(PropertyGroup* parentGroup)
+        : PropertyGroup(parentGroup)
+    {
+        this->postProcessProfile.setDescription(
+            textIdTr("Post-processing steps applied by assimp on the imported scene. This is a "
+                     "trade-off between load time, memory usage and the count of entities created "
+                     "in the document")
+        );
+        this->postProcessProfile.setDescriptions({
+            { PostProcessProfile::Default, textIdTr("Triangulation and joining of identical vertices. "
+              "If some scene node has scaling then vertices are pre-transformed, instancing is lost")
+            },
+            { PostProcessProfile::Fast, textIdTr("Minimal post-processing(triangulation only). Fastest "
+              "load time, but meshes may contain duplicated vertices so memory usage is higher")
+            },
+            { PostProcessProfile::Instanced, textIdTr("Identical meshes are detected and mapped to "
+              "shared products referenced by XCAF components. Lowest memory usage for scenes with "
+              "many repeated parts, at the cost of an extra search step during load")
+            },
+            { PostProcessProfile::Compact, textIdTr("Scene graph and meshes are optimized to reduce "
+              "the count of nodes and meshes. Node names and hierarchy might be lost, load time is "
+              "longer but the document is much lighter for scenes made of many small meshes")
+            }
+        });
+    }
+
+    void restoreDefaults() override
+    {
+        const AssimpReader::Parameters params;
+        this->postProcessProfile.setValue(params.postProcessProfile);
+    }
+
+    PropertyEnum<PostProcessProfile> postProcessProfile{ this, textId("postProcessProfile") };
 };
 
 bool AssimpReader::readFile(const FilePath& filepath, TaskProgress* progress)
 {
     m_vecTriangulation.clear();
+    m_vecInstancedFace.clear();
     m_vecMaterial.clear();
     m_mapMaterialLabel.clear();
     m_mapNodeData.clear();
     m_mapEmbeddedTexture.clear();
     m_mapFileTexture.clear();
 
-    const unsigned flags =
-            aiProcess_Triangulate
-            | aiProcess_JoinIdenticalVertices
-            //| aiProcess_SortByPType /* Crashes with assimp-5.3.1 on Windows */
-            //| aiProcess_OptimizeGraph
-            //| aiProcess_TransformUVCoords
-            //| aiProcess_FlipUVs
-            //| aiProcess_FindInstances
-            //| aiProcess_PreTransformVertices
-            //| aiProcess_FixInfacingNormals
-            //| aiProcess_GlobalScale -> AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY
-            //| aiProcess_GenNormals
-            //| aiProcess_GenSmoothNormals
-            //| aiProcess_GenUVCoords
-            //| aiProcess_CalcTangentSpace
-            //| aiProcess_ValidateDataStructure
-            ;
+    const unsigned flags = this->postProcessFlags();
     //const unsigned flags = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace;
     //m_importer.SetPropertyBool(AI_CONFIG_IMPORT_FBX_PRESERVE_PIVOTS, false);
     m_importer.SetPropertyBool(AI_CONFIG_PP_PTV_KEEP_HIERARCHY, true);
@@ -339,35 +391,44 @@ bool AssimpReader::readFile(const FilePath& filepath, TaskProgress* progress)
         return false;
     }
 
-#ifndef MAYO_ASSIMP_READER_HANDLE_SCALING
     // Apply "aiProcess_PreTransformVertices" post-processing step
     // This avoids issues with any non-identity scaling matrix
     // WARNING Assimp bones and animations are destructed by this step
-    if (deep_aiNodeTransformationHasScaling(m_scene->mRootNode)) {
+    if (!this->handlesNodeScaling() && deep_aiNodeTransformationHasScaling(m_scene->mRootNode)) {
         m_scene = m_importer.ApplyPostProcessing(aiProcess_PreTransformVertices);
         this->messenger()->emitTrace("aiProcess_PreTransformVertices ON");
     }
-#endif
 
     // Create OpenCascade elements from the assimp meshes
     //     mesh of triangles -> Poly_Triangulation
     //     mesh lines -> Poly_Polygon3D
+    // Meshes are independent from each other, so they are converted concurrently. This is done
+    // before the sequential construction of the XCAF scene graph in AssimpReader::transfer()
     m_vecTriangulation.resize(m_scene->mNumMeshes);
     std::fill(m_vecTriangulation.begin(), m_vecTriangulation.end(), nullptr);
-    for (unsigned i = 0; i < m_scene->mNumMeshes; ++i) {
+    std::atomic<bool> hasLinePrimitive = false;
+    std::atomic<bool> hasUnsupportedPrimitive = false;
+    OSD_Parallel::For(0, static_cast<int>(m_scene->mNumMeshes), [&](int i) {
+        if (TaskProgress::isAbortRequested(progress))
+            return;
+
         const aiMesh* mesh = m_scene->mMeshes[i];
-        if (mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE) {
-            auto triangulation = createOccTriangulation(mesh);
-            m_vecTriangulation.at(i) = triangulation;
-        }
-        else if (mesh->mPrimitiveTypes & aiPrimitiveType_LINE) {
-            // TODO Create and add a Poly_Polygon3D object
-            this->messenger()->emitWarning(AssimpReaderI18N::textIdTr("LINE primitives not supported yet"));
-        }
-        else {
-            this->messenger()->emitWarning(AssimpReaderI18N::textIdTr("Some primitive not supported"));
-        }
-    }
+        if (mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE)
+            m_vecTriangulation.at(i) = createOccTriangulation(mesh);
+        else if (mesh->mPrimitiveTypes & aiPrimitiveType_LINE)
+            hasLinePrimitive = true; // TODO Create and add a Poly_Polygon3D object
+        else
+            hasUnsupportedPrimitive = true;
+    });
+
+    if (TaskProgress::isAbortRequested(progress))
+        return false;
+
+    if (hasLinePrimitive)
+        this->messenger()->emitWarning(AssimpReaderI18N::textIdTr("LINE primitives not supported yet"));
+
+    if (hasUnsupportedPrimitive)
+        this->messenger()->emitWarning(AssimpReaderI18N::textIdTr("Some primitive not supported"));
 
     for (unsigned i = 0; i < m_scene->mNumTextures; ++i) {
         const aiTexture* texture = m_scene->mTextures[i];
@@ -393,6 +454,8 @@ NCollection_Sequence<TDF_Label> AssimpReader::transfer(DocumentPtr doc, TaskProg
         return {};
 
     m_mapNodeData.clear();
+    m_vecInstancedFace.clear();
+    m_vecInstancedFace.resize(m_scene->mNumMeshes);
 
     // Compute data for each aiNode object in the scene
     deep_aiNodeVisit(m_scene->mRootNode, [=](const aiNode* node) {
@@ -436,18 +499,56 @@ NCollection_Sequence<TDF_Label> AssimpReader::transfer(DocumentPtr doc, TaskProg
     return CafUtils::makeLabelSequence({ labelEntity });
 }
 
-std::unique_ptr<PropertyGroup> AssimpReader::createProperties(PropertyGroup* /*parentGroup*/)
+std::unique_ptr<PropertyGroup> AssimpReader::createProperties(PropertyGroup* parentGroup)
 {
-    return {};
+    return std::make_unique<Properties>(parentGroup);
 }
 
 void AssimpReader::applyProperties(const PropertyGroup* group)
 {
     auto ptr = dynamic_cast<const Properties*>(group);
     if (ptr) {
+        m_params.postProcessProfile = ptr->postProcessProfile;
     }
 }
 
+unsigned AssimpReader::postProcessFlags() const
+{
+    // Other flags of interest:
+    //     aiProcess_SortByPType -> crashes with assimp-5.3.1 on Windows
+    //     aiProcess_TransformUVCoords, aiProcess_FlipUVs
+    //     aiProcess_FixInfacingNormals
+    //     aiProcess_GlobalScale -> AI_CONFIG_GLOBAL_SCALE_FACTOR_KEY
+    //     aiProcess_GenNormals, aiProcess_GenSmoothNormals, aiProcess_GenUVCoords
+    //     aiProcess_CalcTangentSpace
+    //     aiProcess_ValidateDataStructure
+    switch (m_params.postProcessProfile) {
+    case PostProcessProfile::Default:
+        return aiProcess_Triangulate | aiProcess_JoinIdenticalVertices;
+    case PostProcessProfile::Fast:
+        return aiProcess_Triangulate;
+    case PostProcessProfile::Instanced:
+        return aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_FindInstances;
+    case PostProcessProfile::Compact:
+        return aiProcess_Triangulate
+               | aiProcess_JoinIdenticalVertices
+               | aiProcess_OptimizeMeshes
+               | aiProcess_OptimizeGraph
+            ;
+    }
+
+    return aiProcess_Triangulate | aiProcess_JoinIdenticalVertices;
+}
+
+bool AssimpReader::handlesNodeScaling() const
+{
+#ifdef MAYO_ASSIMP_READER_HANDLE_SCALING
+    return true;
+#else
+    return m_params.postProcessProfile == PostProcessProfile::Instanced;
+#endif
+}
+
 OccHandle<Image_Texture> AssimpReader::findOccTexture(
         const std::string& strFilepath, const FilePath& modelFilepath
     )
@@ -727,8 +828,10 @@ void AssimpReader::transferSceneNode(
         if (!triangulation)
             continue; // Skip
 
-#ifdef MAYO_ASSIMP_READER_HANDLE_SCALING
-        if (hasScaleFactor(nodeScale)) {
+        TopoDS_Face face;
+        bool isNewProduct = true;
+        const bool isNodeScaled = this->handlesNodeScaling() && hasScaleFactor(nodeScale);
+        if (isNodeScaled) {
             triangulation = triangulation->Copy();
             for (int i = 1; i <= triangulation->NbNodes(); ++i) {
                 const gp_Pnt pnt = triangulation->Node(i);
@@ -736,13 +839,28 @@ void AssimpReader::transferSceneNode(
                     triangulation, i, gp_Pnt{ pnt.X() * nodeScale.x, pnt.Y() * nodeScale.y, pnt.Z() * nodeScale.z }
                 );
             }
+
+            face = BRepUtils::makeFace(triangulation);
+        }
+        else if (m_params.postProcessProfile == PostProcessProfile::Instanced) {
+            // Share the same face between all nodes referring to the mesh, so XCAF creates a single
+            // product(referred by many components)
+            TopoDS_Face& instancedFace = m_vecInstancedFace.at(sceneMeshIndex);
+            isNewProduct = instancedFace.IsNull();
+            if (isNewProduct)
+                instancedFace = BRepUtils::makeFace(triangulation);
+
+            face = instancedFace;
+        }
+        else {
+            face = BRepUtils::makeFace(triangulation);
         }
-#endif
 
-        TopoDS_Face face = BRepUtils::makeFace(triangulation);
         face.Location(nodeAbsoluteTrsf);
         const TDF_Label labelComponent = targetDoc->xcaf().shapeTool()->AddComponent(labelEntity, face);
         const TDF_Label labelFace = XCaf::shapeReferred(labelComponent);
+        if (!isNewProduct)
+            continue; // Material and name already assigned to the shared product
 
         if (mesh->mMaterialIndex < m_vecMaterial.size()) {
             const OccHandle<XCAFDoc_VisMaterial>& material = m_vecMaterial.at(mesh->mMaterialIndex);
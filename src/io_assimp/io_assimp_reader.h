@@ -11,6 +11,7 @@
 
 #include <Image_Texture.hxx>
 #include <Poly_Triangulation.hxx>
+#include <TopoDS_Face.hxx>
 #include <XCAFDoc_VisMaterial.hxx>
 
 #include <functional>
@@ -31,10 +32,39 @@ public:
     bool readFile(const FilePath& filepath, TaskProgress* progress) override;
     NCollection_Sequence<TDF_Label> transfer(DocumentPtr doc, TaskProgress* progress) override;
 
+    // Parameters
+
+    // Set of assimp post-processing steps applied on the imported scene
+    // Load time and memory of each profile are measured by mayo_bench(results "read_collada_<profile>")
+    enum class PostProcessProfile {
+        // Triangulation and vertex joining. Pre-transforms vertices if some node has scaling
+        Default,
+        // Triangulation only, fastest load time but meshes keep duplicated vertices
+        Fast,
+        // Identical meshes are detected and shared through XCAF references(no vertex
+        // pre-transformation, node scaling is baked into per-instance meshes)
+        Instanced,
+        // Scene graph and meshes are merged as much as possible, lowest count of XCAF entities
+        Compact
+    };
+
+    struct Parameters {
+        PostProcessProfile postProcessProfile = PostProcessProfile::Default;
+    };
+    Parameters& parameters() { return m_params; }
+    const Parameters& constParameters() const { return m_params; }
+
     static std::unique_ptr<PropertyGroup> createProperties(PropertyGroup* parentGroup);
     void applyProperties(const PropertyGroup* params) override;
 
 private:
+    // Returns the assimp post-processing flags corresponding to current parameters
+    unsigned postProcessFlags() const;
+
+    // Whether scaling found in scene node transformations is handled by the reader itself, meaning
+    // there is no need for "aiProcess_PreTransformVertices" post-processing step
+    bool handlesNodeScaling() const;
+
     // Create OpenCascade texture object
     // Parameter 'strFilepath' is the filepath to the texture as specified by the assimp material
     // Parameter 'modelFilepath' is the filepath to the 3D model being imported with Reader::readFile()
@@ -56,10 +86,12 @@ private:
     };
 
     class Properties;
+    Parameters m_params;
     Assimp::Importer m_importer;
     const aiScene* m_scene = nullptr;
 
     std::vector<OccHandle<Poly_Triangulation>> m_vecTriangulation;
+    std::vector<TopoDS_Face> m_vecInstancedFace;
     std::vector<OccHandle<XCAFDoc_VisMaterial>> m_vecMaterial;
     std::unordered_map<OccHandle<XCAFDoc_VisMaterial>, TDF_Label> m_mapMaterialLabel;
     std::unordered_map<const aiNode*, aiNodeData> m_mapNodeData;
@@ -1029,7 +1029,7 @@ bool DxfParser::parseBlock()
         getLine();
         switch (n) {
         case 0: {
-            while (!endBlockHandled()) {
+            while (!endBlockHandled() && !inputStream().eof()) {
                 auto itHandler = m_mapEntityHandler.find(m_str);
                 if (itHandler != m_mapEntityHandler.cend()) {
                     const auto& fnEntityHandler = itHandler->second;
@@ -1465,6 +1465,14 @@ void DxfParser::parse(std::istream& stream)
     }
 }
 
+void DxfParser::stopParse()
+{
+    m_fail = true;
+    // All parsing loops end on EOF of the input stream
+    if (m_inputStream)
+        m_inputStream->setstate(std::ios::eofbit);
+}
+
 void DxfParser::setGetLinePostCallback(std::function<void(size_t)> fn)
 {
     m_getLinePostCallback = std::move(fn);
@@ -42,6 +42,9 @@ public:
     const Dxf_STYLE* findStyle(DxfStringRef name) const;
 
     void parse(std::istream& stream);
+    // Interrupts parse() as soon as possible, failed() then returns true
+    // Meant to be called during parsing, eg from the "get line" callback
+    void stopParse();
 
     // NOTE std::getline() doesn't affect std::istream::gcount
     void setGetLinePostCallback(std::function<void(size_t)> fn);
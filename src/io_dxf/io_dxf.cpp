@@ -648,6 +648,8 @@ DxfReader::ReaderImpl::ReaderImpl()
         m_fileReadSize += getLineSize;
         if (m_progress) {
             m_progress->setValue(MathUtils::toPercent(m_fileReadSize, 0, m_fileSize));
+            if (m_progress->isAbortRequested())
+                this->stopParse();
         }
     });
     this->setReportErrorCallback([=](std::string_view msg) {
@@ -1191,6 +1193,9 @@ NCollection_Sequence<TDF_Label> DxfReader::transferByGroupLayers(DocumentPtr doc
     std::unordered_map<const Dxf_LAYER*, ArrayOfTransferObjects> mapObjectsByLayer;
 
     for (const Dxf_EntityVariant& entityVar : m_impl->allEntities()) {
+        if (progress->isAbortRequested())
+            return {};
+
         const TopoDS_Shape entityShape = m_impl->createEntityShape(entityVar);
         if (entityShape.IsNull())
             continue; // Skip
@@ -1249,6 +1254,9 @@ NCollection_Sequence<TDF_Label> DxfReader::transferBySingleEntities(DocumentPtr
     std::unordered_map<size_t, unsigned> mapCountByEntityType;
 
     for (const Dxf_EntityVariant& entityVar : m_impl->allEntities()) {
+        if (progress->isAbortRequested())
+            break;
+
         const TopoDS_Shape entityShape = m_impl->createEntityShape(entityVar);
         if (entityShape.IsNull())
             continue; // Skip
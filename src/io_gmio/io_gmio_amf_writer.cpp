@@ -4,6 +4,7 @@
 ****************************************************************************/
 
 #include "io_gmio_amf_writer.h"
+#include "zip_deflate_writer.h"
 
 #include "../base/application_item.h"
 #include "../base/brep_utils.h"
@@ -26,6 +27,7 @@
 #include <gmio_amf/amf_error.h>
 #include <gmio_amf/amf_io.h>
 #include <gmio_core/error.h>
+#include <gmio_core/stream.h>
 #include <gmio_stl/stl_error.h>
 
 #include <fmt/format.h>
@@ -37,6 +39,10 @@ namespace Mayo::IO {
 
 namespace {
 
+struct GmioAmfWriterI18N {
+    MAYO_DECLARE_TEXT_ID_FUNCTIONS(Mayo::IO::GmioAmfWriterI18N)
+};
+
 bool gmio_taskIsStopRequested(void* cookie)
 {
     auto progress = static_cast<const TaskProgress*>(cookie);
@@ -53,6 +59,28 @@ void gmio_handleProgress(void* cookie, intmax_t value, intmax_t maxValue)
     }
 }
 
+size_t gmio_zipStreamWrite(void* cookie, const void* ptr, size_t size, size_t count)
+{
+    auto zipWriter = static_cast<ZipDeflateWriter*>(cookie);
+    return zipWriter->write(ptr, size * count) ? count : 0;
+}
+
+bool gmio_zipStreamError(void* cookie)
+{
+    auto zipWriter = static_cast<const ZipDeflateWriter*>(cookie);
+    return zipWriter->hasError();
+}
+
+// Returns gmio output stream forwarding XML contents to 'zipWriter'
+gmio_stream gmio_createZipStream(ZipDeflateWriter* zipWriter)
+{
+    gmio_stream stream = gmio_stream_null();
+    stream.cookie = zipWriter;
+    stream.func_write = gmio_zipStreamWrite;
+    stream.func_error = gmio_zipStreamError;
+    return stream;
+}
+
 gmio_task_iface gmio_createTask(TaskProgress* progress)
 {
     gmio_task_iface task = {};
@@ -153,6 +181,14 @@ public:
                     fmt::format(textIdTr("Use the ZIP64 format extensions.\n"
                                          "Only applicable if option `{}` is on"),
                                 this->createZipArchive.label()));
+
+        this->zipCompressionLevel.setConstraintsEnabled(true);
+        this->zipCompressionLevel.setRange(0, 9);
+        this->zipCompressionLevel.setDescription(
+                    fmt::format(textIdTr("Compression level of the AMF entry within the ZIP archive, "
+                                         "from 0(no compression) to 9(best compression but slowest).\n"
+                                         "Only applicable if option `{}` is on"),
+                                this->createZipArchive.label()));
     }
 
     void restoreDefaults() override
@@ -163,9 +199,11 @@ public:
         this->createZipArchive.setValue(params.createZipArchive);
         this->zipEntryFilename.setValue(params.zipEntryFilename);
         this->useZip64.setValue(params.useZip64);
+        this->zipCompressionLevel.setValue(params.zipCompressionLevel);
 
         this->zipEntryFilename.setEnabled(this->createZipArchive);
         this->useZip64.setEnabled(this->createZipArchive);
+        this->zipCompressionLevel.setEnabled(this->createZipArchive);
     }
 
     void onPropertyChanged(Property* prop) override
@@ -173,6 +211,7 @@ public:
         if (prop == &this->createZipArchive) {
             this->zipEntryFilename.setEnabled(this->createZipArchive);
             this->useZip64.setEnabled(this->createZipArchive);
+            this->zipCompressionLevel.setEnabled(this->createZipArchive);
         }
 
         PropertyGroup::onPropertyChanged(prop);
@@ -183,6 +222,7 @@ public:
     PropertyBool createZipArchive{ this, textId("createZipArchive") };
     PropertyString zipEntryFilename{ this, textId("zipEntryFilename") };
     PropertyBool useZip64{ this, textId("useZip64") };
+    PropertyInt zipCompressionLevel{ this, textId("zipCompressionLevel") };
 };
 
 bool GmioAmfWriter::transfer(gsl::span<const ApplicationItem> spanAppItem, TaskProgress* progress)
@@ -203,7 +243,7 @@ bool GmioAmfWriter::transfer(gsl::span<const ApplicationItem> spanAppItem, TaskP
         auto it = mapLabelObjectId.find(label);
         return it != mapLabelObjectId.cend() ? it->second : -1;
     };
-    auto fnCreateObject = [&](const Tree<TDF_Label>& modelTree, TreeNodeId id) {
+    auto fnCreateObject = [&](const Tree<TDF_Label>& modelTree, TreeNodeId id, const TopLoc_Location& loc) {
         const TDF_Label nodeLabel = modelTree.nodeData(id);
         if (modelTree.nodeIsLeaf(id)) {
             int objectId = fnFindObjectId(nodeLabel);
@@ -232,7 +272,7 @@ bool GmioAmfWriter::transfer(gsl::span<const ApplicationItem> spanAppItem, TaskP
                 absoluteName.erase(0, 1); // Remove starting '/'
                 Instance instance;
                 instance.objectId = objectId;
-                instance.trsf = XCaf::shapeAbsoluteLocation(modelTree, id);
+                instance.trsf = loc;
                 instance.name = absoluteName;
                 m_vecInstance.push_back(std::move(instance));
             }
@@ -243,14 +283,11 @@ bool GmioAmfWriter::transfer(gsl::span<const ApplicationItem> spanAppItem, TaskP
         const auto appItemIndex = &appItem - &spanAppItem.front();
         progress->setValue(MathUtils::toPercent(appItemIndex, 0, spanAppItem.size() - 1));
         const Tree<TDF_Label>& modelTree = appItem.document()->modelTree();
-        if (appItem.isDocument()) {
-            traverseTree(modelTree, [&](TreeNodeId id) { fnCreateObject(modelTree, id); });
-        }
-        else if (appItem.isDocumentTreeNode()) {
-            traverseTree(appItem.documentTreeNode().id(), modelTree, [&](TreeNodeId id) {
-                fnCreateObject(modelTree, id);
-            });
-        }
+        auto fnNodeCallback = [&](TreeNodeId id, const TopLoc_Location& loc) { fnCreateObject(modelTree, id, loc); };
+        if (appItem.isDocument())
+            XCaf::traverseTreeWithLocation(modelTree, fnNodeCallback);
+        else if (appItem.isDocumentTreeNode())
+            XCaf::traverseTreeWithLocation(modelTree, appItem.documentTreeNode().id(), fnNodeCallback);
     }
 
     return true;
@@ -286,13 +323,39 @@ bool GmioAmfWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
     amfOptions.task_iface.func_is_stop_requested = &gmio_taskIsStopRequested;
     amfOptions.float64_format = fnAmfFloat64Format(m_params.float64Format);
     amfOptions.float64_prec = m_params.float64Precision;
-    amfOptions.create_zip_archive = m_params.createZipArchive;
-    amfOptions.dont_use_zip64_extensions = !m_params.useZip64;
-    amfOptions.zip_entry_filename = m_params.zipEntryFilename.c_str();
-    amfOptions.zip_entry_filename_len = gsl::narrow<uint16_t>(m_params.zipEntryFilename.size());
-    // TODO Handle gmio_amf_write_options::z_compress_options
-    const int error = gmio_amf_write_file(filepath.u8string().c_str(), &amfDoc, &amfOptions);
-    return gmio_no_error(error);
+    if (!m_params.createZipArchive) {
+        const int error = gmio_amf_write_file(filepath.u8string().c_str(), &amfDoc, &amfOptions);
+        return gmio_no_error(error);
+    }
+
+    // ZIP archive: gmio generates plain XML which is compressed by ZipDeflateWriter in a separate
+    // thread, so XML generation and compression are overlapped
+    ZipDeflateWriter::Options zipOptions;
+    zipOptions.entryFilename = m_params.zipEntryFilename;
+    zipOptions.compressionLevel = m_params.zipCompressionLevel;
+    zipOptions.useZip64 = m_params.useZip64;
+    ZipDeflateWriter zipWriter(filepath, zipOptions);
+    gmio_stream zipStream = gmio_createZipStream(&zipWriter);
+    const int error = gmio_amf_write(&zipStream, &amfDoc, &amfOptions);
+    const bool zipOk = zipWriter.finish();
+    if (zipWriter.isZip64Required()) {
+        this->messenger()->emitError(
+            GmioAmfWriterI18N::textIdTr("ZIP archive exceeds 4GB, option 'useZip64' must be enabled")
+        );
+    }
+
+    if (!gmio_no_error(error) || !zipOk)
+        return false;
+
+    if (zipWriter.uncompressedSize() > 0) {
+        const double ratio = zipWriter.compressedSize() / double(zipWriter.uncompressedSize());
+        this->messenger()->emitInfo(fmt::format(
+            GmioAmfWriterI18N::textIdTr("AMF compressed to {:.1f}% of its size({} -> {} bytes)"),
+            ratio * 100, zipWriter.uncompressedSize(), zipWriter.compressedSize()
+        ));
+    }
+
+    return true;
 }
 
 std::unique_ptr<PropertyGroup> GmioAmfWriter::createProperties(PropertyGroup* parentGroup)
@@ -309,6 +372,7 @@ void GmioAmfWriter::applyProperties(const PropertyGroup* group)
         m_params.createZipArchive = ptr->createZipArchive;
         m_params.zipEntryFilename = ptr->zipEntryFilename;
         m_params.useZip64 = ptr->useZip64;
+        m_params.zipCompressionLevel = ptr->zipCompressionLevel;
     }
 }
 
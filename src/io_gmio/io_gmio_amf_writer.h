@@ -42,6 +42,7 @@ public:
         uint8_t float64Precision = 16;
         bool createZipArchive = false;
         bool useZip64 = true;
+        int zipCompressionLevel = 6; // In range [0,9], 0 means no compression
         std::string zipEntryFilename; // UTF8
     };
     Parameters& parameters() { return m_params; }
@@ -0,0 +1,346 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "zip_deflate_writer.h"
+#include "../base/global.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <ctime>
+
+namespace Mayo::IO {
+
+namespace {
+
+// Size of the chunks of uncompressed data handed over to the worker thread
+constexpr size_t ChunkSize = 1024 * 1024;
+
+// Maximum count of chunks waiting for compression, bounds memory usage
+constexpr size_t MaxPendingChunkCount = 8;
+
+constexpr uint32_t ZipSignature_LocalFileHeader = 0x04034b50;
+constexpr uint32_t ZipSignature_DataDescriptor = 0x08074b50;
+constexpr uint32_t ZipSignature_CentralDirectoryHeader = 0x02014b50;
+constexpr uint32_t ZipSignature_Zip64EndOfCentralDirectory = 0x06064b50;
+constexpr uint32_t ZipSignature_Zip64EndOfCentralDirectoryLocator = 0x07064b50;
+constexpr uint32_t ZipSignature_EndOfCentralDirectory = 0x06054b50;
+
+constexpr uint16_t ZipFlag_DataDescriptor = 0x0008;
+constexpr uint16_t ZipFlag_Utf8Filename = 0x0800;
+constexpr uint16_t ZipCompressionMethod_Deflate = 8;
+constexpr uint16_t ZipExtraId_Zip64 = 0x0001;
+
+// Sizes and offsets of the standard(non ZIP64) format are stored on 32 bits, value 0xFFFFFFFF being
+// reserved to indicate the real value is in the ZIP64 extra field
+constexpr uint64_t ZipMaxValue32 = UINT32_MAX - 1;
+
+void writeLE16(std::ostream& outs, uint16_t v)
+{
+    const char bytes[] = { char(v & 0xFF), char((v >> 8) & 0xFF) };
+    outs.write(bytes, sizeof(bytes));
+}
+
+void writeLE32(std::ostream& outs, uint32_t v)
+{
+    writeLE16(outs, uint16_t(v & 0xFFFF));
+    writeLE16(outs, uint16_t(v >> 16));
+}
+
+void writeLE64(std::ostream& outs, uint64_t v)
+{
+    writeLE32(outs, uint32_t(v & 0xFFFFFFFF));
+    writeLE32(outs, uint32_t(v >> 32));
+}
+
+uint16_t zipVersionNeeded(bool useZip64)
+{
+    return useZip64 ? 45 : 20;
+}
+
+// Thread-safe alternative to std::localtime()
+bool localTime(std::time_t time, std::tm* tm)
+{
+#ifdef MAYO_OS_WINDOWS
+    return localtime_s(tm, &time) == 0;
+#else
+    return localtime_r(&time, tm) != nullptr;
+#endif
+}
+
+} // namespace
+
+ZipDeflateWriter::ZipDeflateWriter(const FilePath& filepath, const Options& options)
+    : m_fstr(filepath, std::ios::out | std::ios::binary | std::ios::trunc),
+      m_options(options)
+{
+    m_options.compressionLevel = std::clamp(m_options.compressionLevel, 0, 9);
+    if (m_options.entryFilename.empty())
+        m_options.entryFilename = filepath.stem().u8string() + ".amf";
+
+    std::tm tmNow = {};
+    if (localTime(std::time(nullptr), &tmNow)) {
+        m_dosTime = uint16_t((tmNow.tm_hour << 11) | (tmNow.tm_min << 5) | (tmNow.tm_sec / 2));
+        m_dosDate = uint16_t(((std::max(tmNow.tm_year - 80, 0)) << 9) | ((tmNow.tm_mon + 1) << 5) | tmNow.tm_mday);
+    }
+
+    m_hasError = !m_fstr.is_open();
+    if (!m_hasError) {
+        this->writeLocalFileHeader();
+        m_currentChunk.reserve(ChunkSize);
+        m_worker = std::thread([=]{ this->runWorker(); });
+    }
+}
+
+ZipDeflateWriter::~ZipDeflateWriter()
+{
+    if (m_worker.joinable())
+        this->finish();
+}
+
+bool ZipDeflateWriter::write(const void* data, size_t size)
+{
+    if (this->hasError())
+        return false;
+
+    auto bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        const size_t copySize = std::min(size, ChunkSize - m_currentChunk.size());
+        m_currentChunk.insert(m_currentChunk.end(), bytes, bytes + copySize);
+        bytes += copySize;
+        size -= copySize;
+        if (m_currentChunk.size() >= ChunkSize) {
+            this->pushChunk(std::move(m_currentChunk));
+            m_currentChunk = {};
+            m_currentChunk.reserve(ChunkSize);
+        }
+    }
+
+    return true;
+}
+
+bool ZipDeflateWriter::finish()
+{
+    if (!m_worker.joinable())
+        return !this->hasError();
+
+    if (!m_currentChunk.empty())
+        this->pushChunk(std::move(m_currentChunk));
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isInputDone = true;
+    }
+
+    m_condition.notify_all();
+    m_worker.join();
+    if (!this->hasError()) {
+        this->writeDataDescriptor();
+        // Central directory offset must also fit in 32 bits without ZIP64
+        if (!m_options.useZip64 && static_cast<uint64_t>(m_fstr.tellp()) > ZipMaxValue32) {
+            m_isZip64Required = true;
+            m_hasError = true;
+        }
+    }
+
+    if (!this->hasError()) {
+        this->writeCentralDirectory();
+        m_fstr.flush();
+    }
+
+    if (!m_fstr.good())
+        m_hasError = true;
+
+    m_fstr.close();
+    return !m_hasError;
+}
+
+void ZipDeflateWriter::pushChunk(Chunk&& chunk)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [=]{ return m_queueChunk.size() < MaxPendingChunkCount || m_hasError; });
+    if (!m_hasError)
+        m_queueChunk.push_back(std::move(chunk));
+
+    lock.unlock();
+    m_condition.notify_all();
+}
+
+void ZipDeflateWriter::runWorker()
+{
+    z_stream zstream = {};
+    // Negative window bits: raw deflate data, without zlib header and trailer as required by ZIP
+    if (deflateInit2(&zstream, m_options.compressionLevel, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasError = true;
+        m_condition.notify_all();
+        return;
+    }
+
+    uint32_t crc = crc32(0L, Z_NULL, 0);
+    std::vector<uint8_t> outBuffer(ChunkSize);
+    auto fnDeflate = [&](const Chunk& chunk, int flush) {
+        zstream.next_in = const_cast<Bytef*>(chunk.data());
+        zstream.avail_in = static_cast<uInt>(chunk.size());
+        int res = Z_OK;
+        do {
+            zstream.next_out = outBuffer.data();
+            zstream.avail_out = static_cast<uInt>(outBuffer.size());
+            res = deflate(&zstream, flush);
+            const size_t outSize = outBuffer.size() - zstream.avail_out;
+            m_fstr.write(reinterpret_cast<const char*>(outBuffer.data()), outSize);
+            m_compressedSize += outSize;
+        } while (zstream.avail_out == 0 && res != Z_STREAM_ERROR);
+
+        return res != Z_STREAM_ERROR && m_fstr.good();
+    };
+
+    // Without ZIP64, stop as soon as sizes can't be stored in the archive instead of truncating them
+    auto fnCheckZip32Limits = [&]{
+        if (!m_options.useZip64 && (m_uncompressedSize > ZipMaxValue32 || m_compressedSize > ZipMaxValue32))
+            m_isZip64Required = true;
+
+        return !m_isZip64Required;
+    };
+
+    bool ok = true;
+    for (;;) {
+        Chunk chunk;
+        bool isInputDone = false;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [=]{ return !m_queueChunk.empty() || m_isInputDone; });
+            if (!m_queueChunk.empty()) {
+                chunk = std::move(m_queueChunk.front());
+                m_queueChunk.pop_front();
+            }
+
+            isInputDone = m_isInputDone && m_queueChunk.empty();
+        }
+
+        m_condition.notify_all();
+        if (!chunk.empty()) {
+            crc = crc32(crc, chunk.data(), static_cast<uInt>(chunk.size()));
+            m_uncompressedSize += chunk.size();
+            ok = fnDeflate(chunk, Z_NO_FLUSH) && fnCheckZip32Limits();
+        }
+
+        if (!ok || isInputDone)
+            break;
+    }
+
+    if (ok)
+        ok = fnDeflate(Chunk{}, Z_FINISH) && fnCheckZip32Limits();
+
+    deflateEnd(&zstream);
+    m_crc32 = crc;
+    if (!ok) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_hasError = true;
+        m_condition.notify_all();
+    }
+}
+
+void ZipDeflateWriter::writeLocalFileHeader()
+{
+    m_localHeaderOffset = 0;
+    const auto& filename = m_options.entryFilename;
+    writeLE32(m_fstr, ZipSignature_LocalFileHeader);
+    writeLE16(m_fstr, zipVersionNeeded(m_options.useZip64));
+    writeLE16(m_fstr, ZipFlag_DataDescriptor | ZipFlag_Utf8Filename);
+    writeLE16(m_fstr, ZipCompressionMethod_Deflate);
+    writeLE16(m_fstr, m_dosTime);
+    writeLE16(m_fstr, m_dosDate);
+    // CRC32 and sizes are unknown at this point, they are written in the data descriptor
+    writeLE32(m_fstr, 0);
+    writeLE32(m_fstr, m_options.useZip64 ? UINT32_MAX : 0);
+    writeLE32(m_fstr, m_options.useZip64 ? UINT32_MAX : 0);
+    writeLE16(m_fstr, static_cast<uint16_t>(filename.size()));
+    writeLE16(m_fstr, m_options.useZip64 ? 20 : 0);
+    m_fstr.write(filename.data(), filename.size());
+    if (m_options.useZip64) {
+        writeLE16(m_fstr, ZipExtraId_Zip64);
+        writeLE16(m_fstr, 16);
+        writeLE64(m_fstr, 0); // Uncompressed size
+        writeLE64(m_fstr, 0); // Compressed size
+    }
+}
+
+void ZipDeflateWriter::writeDataDescriptor()
+{
+    writeLE32(m_fstr, ZipSignature_DataDescriptor);
+    writeLE32(m_fstr, m_crc32);
+    if (m_options.useZip64) {
+        writeLE64(m_fstr, m_compressedSize);
+        writeLE64(m_fstr, m_uncompressedSize);
+    }
+    else {
+        writeLE32(m_fstr, static_cast<uint32_t>(m_compressedSize));
+        writeLE32(m_fstr, static_cast<uint32_t>(m_uncompressedSize));
+    }
+}
+
+void ZipDeflateWriter::writeCentralDirectory()
+{
+    const auto& filename = m_options.entryFilename;
+    const bool useZip64 = m_options.useZip64;
+    const uint64_t centralDirOffset = static_cast<uint64_t>(m_fstr.tellp());
+    writeLE32(m_fstr, ZipSignature_CentralDirectoryHeader);
+    writeLE16(m_fstr, zipVersionNeeded(useZip64)); // Version made by
+    writeLE16(m_fstr, zipVersionNeeded(useZip64)); // Version needed to extract
+    writeLE16(m_fstr, ZipFlag_DataDescriptor | ZipFlag_Utf8Filename);
+    writeLE16(m_fstr, ZipCompressionMethod_Deflate);
+    writeLE16(m_fstr, m_dosTime);
+    writeLE16(m_fstr, m_dosDate);
+    writeLE32(m_fstr, m_crc32);
+    writeLE32(m_fstr, useZip64 ? UINT32_MAX : static_cast<uint32_t>(m_compressedSize));
+    writeLE32(m_fstr, useZip64 ? UINT32_MAX : static_cast<uint32_t>(m_uncompressedSize));
+    writeLE16(m_fstr, static_cast<uint16_t>(filename.size()));
+    writeLE16(m_fstr, useZip64 ? 28 : 0); // Extra field length
+    writeLE16(m_fstr, 0); // File comment length
+    writeLE16(m_fstr, 0); // Disk number start
+    writeLE16(m_fstr, 0); // Internal file attributes
+    writeLE32(m_fstr, 0); // External file attributes
+    writeLE32(m_fstr, useZip64 ? UINT32_MAX : static_cast<uint32_t>(m_localHeaderOffset));
+    m_fstr.write(filename.data(), filename.size());
+    if (useZip64) {
+        writeLE16(m_fstr, ZipExtraId_Zip64);
+        writeLE16(m_fstr, 24);
+        writeLE64(m_fstr, m_uncompressedSize);
+        writeLE64(m_fstr, m_compressedSize);
+        writeLE64(m_fstr, m_localHeaderOffset);
+    }
+
+    const uint64_t zip64EndOfCentralDirOffset = static_cast<uint64_t>(m_fstr.tellp());
+    const uint64_t centralDirSize = zip64EndOfCentralDirOffset - centralDirOffset;
+    if (useZip64) {
+        writeLE32(m_fstr, ZipSignature_Zip64EndOfCentralDirectory);
+        writeLE64(m_fstr, 44); // Size of the remaining record
+        writeLE16(m_fstr, zipVersionNeeded(useZip64)); // Version made by
+        writeLE16(m_fstr, zipVersionNeeded(useZip64)); // Version needed to extract
+        writeLE32(m_fstr, 0); // Number of this disk
+        writeLE32(m_fstr, 0); // Disk where central directory starts
+        writeLE64(m_fstr, 1); // Number of central directory records on this disk
+        writeLE64(m_fstr, 1); // Total number of central directory records
+        writeLE64(m_fstr, centralDirSize);
+        writeLE64(m_fstr, centralDirOffset);
+
+        writeLE32(m_fstr, ZipSignature_Zip64EndOfCentralDirectoryLocator);
+        writeLE32(m_fstr, 0); // Disk where zip64 end of central directory starts
+        writeLE64(m_fstr, zip64EndOfCentralDirOffset);
+        writeLE32(m_fstr, 1); // Total number of disks
+    }
+
+    writeLE32(m_fstr, ZipSignature_EndOfCentralDirectory);
+    writeLE16(m_fstr, 0); // Number of this disk
+    writeLE16(m_fstr, 0); // Disk where central directory starts
+    writeLE16(m_fstr, 1); // Number of central directory records on this disk
+    writeLE16(m_fstr, 1); // Total number of central directory records
+    writeLE32(m_fstr, useZip64 ? UINT32_MAX : static_cast<uint32_t>(centralDirSize));
+    writeLE32(m_fstr, useZip64 ? UINT32_MAX : static_cast<uint32_t>(centralDirOffset));
+    writeLE16(m_fstr, 0); // Comment length
+}
+
+} // namespace Mayo::IO
@@ -0,0 +1,89 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "../base/filepath.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Mayo::IO {
+
+// Writes a ZIP archive containing a single file entry compressed with the "deflate" method
+// Uncompressed data is pushed with write(), it's then compressed and written to disk by a worker
+// thread. This way production of the data(eg XML generation) and compression run concurrently
+class ZipDeflateWriter {
+public:
+    struct Options {
+        std::string entryFilename; // UTF8
+        int compressionLevel = 6; // In range [0,9], 0 means no compression
+        // If 'false' then the archive is limited to 4GB(sizes and offsets stored on 32 bits), write
+        // operations fail once that limit is exceeded(see isZip64Required())
+        bool useZip64 = true;
+    };
+
+    ZipDeflateWriter(const FilePath& filepath, const Options& options);
+    ~ZipDeflateWriter();
+
+    // Not copyable
+    ZipDeflateWriter(const ZipDeflateWriter&) = delete;
+    ZipDeflateWriter& operator=(const ZipDeflateWriter&) = delete;
+
+    // Appends 'size' bytes of uncompressed data to the ZIP entry
+    // Blocks if the worker thread is lagging too much behind
+    bool write(const void* data, size_t size);
+
+    // Flushes pending data, writes the ZIP central directory and waits for the worker thread
+    // Returns 'true' on success
+    bool finish();
+
+    bool hasError() const { return m_hasError; }
+
+    // Whether writing failed because ZIP64 is disabled and the archive exceeds the limits of the
+    // standard ZIP format
+    bool isZip64Required() const { return m_isZip64Required; }
+
+    uint64_t uncompressedSize() const { return m_uncompressedSize; }
+    uint64_t compressedSize() const { return m_compressedSize; }
+
+private:
+    using Chunk = std::vector<uint8_t>;
+
+    void pushChunk(Chunk&& chunk);
+    void runWorker();
+    void writeLocalFileHeader();
+    void writeDataDescriptor();
+    void writeCentralDirectory();
+
+    std::ofstream m_fstr;
+    Options m_options;
+    uint16_t m_dosTime = 0;
+    uint16_t m_dosDate = 0;
+
+    Chunk m_currentChunk;
+    std::deque<Chunk> m_queueChunk;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_isInputDone = false;
+    std::atomic<bool> m_hasError = false;
+    std::atomic<bool> m_isZip64Required = false;
+    std::thread m_worker;
+
+    // Accessed by worker thread only until finish() returns
+    uint32_t m_crc32 = 0;
+    uint64_t m_uncompressedSize = 0;
+    uint64_t m_compressedSize = 0;
+    uint64_t m_localHeaderOffset = 0;
+};
+
+} // namespace Mayo::IO
@@ -30,7 +30,14 @@
 
 #include <fmt/format.h>
 #include <gsl/util>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <thread>
 
 namespace Mayo {
 
@@ -164,6 +171,96 @@ Aspect_GradientFillMethod toOccGradientFill(ImageWriter::GradientFill fill)
     return Aspect_GFM_NONE;
 }
 
+// Creates graphics object for entity 'label' and adds it into 'gfxScene'
+// Returns null object if no compatible graphics driver could be found
+GraphicsObjectPtr addGraphicsObject(
+        const GuiApplication* guiApp,
+        const ImageWriter::Parameters& params,
+        GraphicsScene* gfxScene,
+        const TDF_Label& label
+    )
+{
+    auto driver = guiApp->findCompatibleGraphicsObjectDriver(label);
+    if (!driver)
+        return {};
+
+    auto gfxObject = driver->createObject(label);
+    gfxScene->addObject(gfxObject);
+    const std::optional<Enumeration::Value> displayMode = params.displayMode(driver);
+    if (displayMode)
+        driver->applyDisplayMode(gfxObject, displayMode.value());
+
+    return gfxObject;
+}
+
+// Executes functions with a fixed count of worker threads
+// Count of pending functions is bounded, push() blocks until a worker thread is available
+class WorkerQueue {
+public:
+    explicit WorkerQueue(int threadCount)
+        : m_maxPendingCount(2 * std::max(threadCount, 1))
+    {
+        for (int i = 0; i < std::max(threadCount, 1); ++i)
+            m_vecThread.emplace_back([=]{ this->runWorker(); });
+    }
+
+    ~WorkerQueue()
+    {
+        this->waitForDone();
+    }
+
+    void push(std::function<void()> fn)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [=]{ return m_queue.size() < m_maxPendingCount; });
+        m_queue.push_back(std::move(fn));
+        lock.unlock();
+        m_condition.notify_all();
+    }
+
+    // Blocks until all pushed functions are executed, then worker threads are stopped
+    void waitForDone()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isDone = true;
+        }
+
+        m_condition.notify_all();
+        for (std::thread& thread : m_vecThread) {
+            if (thread.joinable())
+                thread.join();
+        }
+    }
+
+private:
+    void runWorker()
+    {
+        for (;;) {
+            std::function<void()> fn;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [=]{ return !m_queue.empty() || m_isDone; });
+                if (m_queue.empty())
+                    return;
+
+                fn = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+
+            m_condition.notify_all();
+            fn();
+        }
+    }
+
+    const size_t m_maxPendingCount = 2;
+    std::vector<std::thread> m_vecThread;
+    std::deque<std::function<void()>> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_isDone = false;
+};
+
 } // namespace
 
 ImageWriter::ImageWriter(GuiApplication* guiApp)
@@ -204,14 +301,7 @@ bool ImageWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
     OccHandle<V3d_View> view = ImageWriter::createV3dView(&gfxScene, m_params);
 
     auto fnMapGraphicsObject = [&](const TDF_Label& labelEntity) {
-        auto driver = m_guiApp->findCompatibleGraphicsObjectDriver(labelEntity);
-        if (driver) {
-            auto gfxObject = driver->createObject(labelEntity);
-            gfxScene.addObject(gfxObject);
-            auto itDisplayMode = m_params.m_driverDisplayModes.find(driver);
-            if (itDisplayMode != m_params.m_driverDisplayModes.cend())
-                driver->applyDisplayMode(gfxObject, itDisplayMode->second);
-        }
+        addGraphicsObject(m_guiApp, m_params, &gfxScene, labelEntity);
     };
 
     const int itemCount = static_cast<int>(m_vecAppItem.size());
@@ -364,6 +454,115 @@ void ImageWriter::Parameters::setDisplayMode(const GraphicsObjectDriverPtr& driv
         it->second = enumValue;
 }
 
+ImageBatchRenderer::ImageBatchRenderer(GuiApplication* guiApp, const ImageWriter::Parameters& params)
+    : m_guiApp(guiApp),
+      m_params(params),
+      m_encodingThreadCount(std::max(int(std::thread::hardware_concurrency()), 1))
+{
+}
+
+void ImageBatchRenderer::setEncodingThreadCount(int count)
+{
+    m_encodingThreadCount = std::max(count, 1);
+}
+
+int ImageBatchRenderer::run(gsl::span<const Job> jobs, TaskProgress* progress)
+{
+    GraphicsScene gfxScene;
+    OccHandle<V3d_View> view;
+    int viewWidth = -1;
+    int viewHeight = -1;
+    DocumentPtr currentDoc;
+    TreeNodeId currentEntityId = 0;
+    std::vector<GraphicsObjectPtr> vecGfxObject;
+    std::atomic<int> savedImageCount = 0;
+    WorkerQueue encodingQueue(m_encodingThreadCount);
+    for (const Job& job : jobs) {
+        if (TaskProgress::isAbortRequested(progress))
+            break;
+
+        const int width = job.width > 0 ? job.width : m_params.width;
+        const int height = job.height > 0 ? job.height : m_params.height;
+        if (!view) {
+            ImageWriter::Parameters viewParams = m_params;
+            viewParams.width = width;
+            viewParams.height = height;
+            view = ImageWriter::createV3dView(&gfxScene, viewParams);
+        }
+        else if (width != viewWidth || height != viewHeight) {
+            // Only the virtual window is replaced, graphics driver and OpenGL context are kept
+            view->SetWindow(graphicsCreateVirtualWindow(view->Viewer()->Driver(), width, height));
+        }
+
+        viewWidth = width;
+        viewHeight = height;
+
+        // Map graphics objects only when the document entities change
+        if (job.doc != currentDoc || job.entityId != currentEntityId) {
+            for (const GraphicsObjectPtr& gfxObject : vecGfxObject)
+                gfxScene.eraseObject(gfxObject);
+
+            vecGfxObject.clear();
+            currentDoc = job.doc;
+            currentEntityId = job.entityId;
+            auto fnAddGraphicsObject = [&](TreeNodeId entityId) {
+                const TDF_Label labelEntity = currentDoc->modelTreeNodeLabel(entityId);
+                auto gfxObject = addGraphicsObject(m_guiApp, m_params, &gfxScene, labelEntity);
+                if (gfxObject)
+                    vecGfxObject.push_back(gfxObject);
+            };
+            if (currentDoc && currentEntityId != 0) {
+                fnAddGraphicsObject(currentEntityId);
+            }
+            else if (currentDoc) {
+                for (TreeNodeId entityId : currentDoc->allEntityNodeIds())
+                    fnAddGraphicsObject(entityId);
+            }
+
+            view->Redraw();
+        }
+
+        const gp_Vec& camOrientation = job.cameraOrientation;
+        if (!GeomUtils::isNull(camOrientation))
+            view->SetProj(camOrientation.X(), camOrientation.Y(), camOrientation.Z());
+        else
+            view->SetProj(1, -1, 1);
+
+        GraphicsUtils::V3dView_fitAll(view);
+        OccHandle<Image_AlienPixMap> pixmap = ImageWriter::createImage(view);
+        if (pixmap) {
+            const TCollection_AsciiString strFilepath = filepathTo<TCollection_AsciiString>(job.filepath);
+            encodingQueue.push([=, &savedImageCount]{
+                if (pixmap->Save(strFilepath))
+                    ++savedImageCount;
+            });
+        }
+
+        if (progress) {
+            const auto jobIndex = &job - jobs.data();
+            progress->setValue(MathUtils::toPercent(jobIndex + 1, 0, jobs.size()));
+        }
+    }
+
+    encodingQueue.waitForDone();
+    if (view)
+        gfxScene.v3dViewer()->SetViewOff(view);
+
+    return savedImageCount;
+}
+
+gsl::span<const ImageBatchRenderer::StandardView> ImageBatchRenderer::standardViews()
+{
+    static const StandardView array[] = {
+        { "front", gp_Vec{0, -1, 0} },
+        { "back", gp_Vec{0, 1, 0} },
+        { "left", gp_Vec{-1, 0, 0} },
+        { "right", gp_Vec{1, 0, 0} },
+        { "top", gp_Vec{0, 0, 1} },
+        { "bottom", gp_Vec{0, 0, -1} }
+    };
+    return array;
+}
 
 ImageFactoryWriter::ImageFactoryWriter(GuiApplication* guiApp)
     : m_guiApp(guiApp)
@@ -19,6 +19,7 @@
 
 #include <map>
 #include <optional>
+#include <string_view>
 #include <vector>
 
 // Pre-decls
@@ -99,6 +100,52 @@ private:
     std::vector<ApplicationItem> m_vecAppItem;
 };
 
+// Provides offscreen rendering of a batch of images, typically previews of many documents viewed
+// from several camera orientations
+// A single graphics scene, 3D view and virtual window(hence OpenGL context) are reused for all the
+// jobs. Encoding and saving of image files is done by worker threads while next jobs are rendered
+// NOTE On Linux, rendering doesn't need any display when OpenCascade is built without Xlib(CMake
+//      option USE_XLIB=OFF, OpenCascade >= 7.7): the virtual window is then an EGL pbuffer, so
+//      CPU-only machines can render with Mesa llvmpipe. Otherwise a X11 display is required(eg Xvfb)
+class ImageBatchRenderer {
+public:
+    struct Job {
+        DocumentPtr doc;
+        TreeNodeId entityId = 0; // Entity of 'doc' to be rendered, all entities if 0
+        gp_Vec cameraOrientation = gp_Vec{1, -1, 1}; // X+ Y- Z+
+        int width = 0; // Use ImageWriter::Parameters::width if <= 0
+        int height = 0; // Use ImageWriter::Parameters::height if <= 0
+        FilePath filepath; // Image format is deduced from file extension
+    };
+
+    // Parameter 'params' provides the common rendering options(background, projection, ...)
+    ImageBatchRenderer(GuiApplication* guiApp, const ImageWriter::Parameters& params);
+
+    // Count of threads used to encode and save image files
+    // Default is std::thread::hardware_concurrency()
+    int encodingThreadCount() const { return m_encodingThreadCount; }
+    void setEncodingThreadCount(int count);
+
+    // Renders the jobs in sequence and returns the count of image files successfully written
+    // Consecutive jobs referring to the same document entities share the same graphics objects, so
+    // it's preferable to group jobs by document and entity
+    // Exception Standard_Failure is thrown if no OpenGL context could be created
+    int run(gsl::span<const Job> jobs, TaskProgress* progress = nullptr);
+
+    struct StandardView {
+        std::string_view name;
+        gp_Vec cameraOrientation;
+    };
+
+    // Convenience function returning the 6 axis-aligned views(front, back, left, right, top, bottom)
+    static gsl::span<const StandardView> standardViews();
+
+private:
+    GuiApplication* m_guiApp = nullptr;
+    ImageWriter::Parameters m_params;
+    int m_encodingThreadCount = 1;
+};
+
 class ImageFactoryWriter : public FactoryWriter {
 public:
     explicit ImageFactoryWriter(GuiApplication* guiApp);
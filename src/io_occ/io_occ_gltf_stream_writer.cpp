@@ -0,0 +1,717 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#include "io_occ_gltf_stream_writer.h"
+
+#include "../base/filepath_conv.h"
+#include "../base/math_utils.h"
+#include "../base/string_conv.h"
+#include "../base/task_progress.h"
+#include "../base/text_id.h"
+#include "../base/xcaf.h"
+
+#include <gp_Pnt2d.hxx>
+#include <gp_Quaternion.hxx>
+#include <Poly_Triangle.hxx>
+#include <Precision.hxx>
+#include <RWMesh_FaceIterator.hxx>
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <unordered_set>
+
+namespace Mayo::IO {
+
+namespace {
+
+struct GltfStreamWriterI18N {
+    MAYO_DECLARE_TEXT_ID_FUNCTIONS(Mayo::IO::GltfStreamWriterI18N)
+};
+
+// Constants defined by the glTF 2.0 specification
+enum GltfConstant {
+    GltfComponentType_UnsignedShort = 5123,
+    GltfComponentType_UnsignedInt = 5125,
+    GltfComponentType_Float = 5126,
+    GltfTarget_ArrayBuffer = 34962,
+    GltfTarget_ElementArrayBuffer = 34963
+};
+
+std::string shapeName(
+        const TDF_Label& labelInstance,
+        const TDF_Label& labelProduct,
+        OccGltfWriter::ShapeNameFormat format)
+{
+    using ShapeNameFormat = OccGltfWriter::ShapeNameFormat;
+    const std::string instanceName = to_stdString(CafUtils::labelAttrStdName(labelInstance));
+    const std::string productName = to_stdString(CafUtils::labelAttrStdName(labelProduct));
+    switch (format) {
+    case ShapeNameFormat::Empty: return {};
+    case ShapeNameFormat::Product: return productName;
+    case ShapeNameFormat::Instance: return instanceName;
+    case ShapeNameFormat::InstanceOrProduct: return !instanceName.empty() ? instanceName : productName;
+    case ShapeNameFormat::ProductOrInstance: return !productName.empty() ? productName : instanceName;
+    case ShapeNameFormat::ProductAndInstance:
+        if (!instanceName.empty() && labelInstance != labelProduct)
+            return productName + " [" + instanceName + "]";
+        else
+            return productName;
+    }
+
+    return {};
+}
+
+void collectProducts(const TDF_Label& label, std::unordered_set<TDF_Label>* setProduct)
+{
+    const TDF_Label labelProduct = XCaf::isShapeReference(label) ? XCaf::shapeReferred(label) : label;
+    if (XCaf::isShapeAssembly(labelProduct)) {
+        for (const TDF_Label& labelComponent : XCaf::shapeComponents(labelProduct))
+            collectProducts(labelComponent, setProduct);
+    }
+    else {
+        setProduct->insert(labelProduct);
+    }
+}
+
+void appendJsonString(std::string* json, std::string_view str)
+{
+    json->push_back('"');
+    for (char c : str) {
+        switch (c) {
+        case '"':  json->append("\\\""); break;
+        case '\\': json->append("\\\\"); break;
+        case '\n': json->append("\\n"); break;
+        case '\r': json->append("\\r"); break;
+        case '\t': json->append("\\t"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                fmt::format_to(std::back_inserter(*json), "\\u{:04x}", static_cast<int>(c));
+            else
+                json->push_back(c);
+        }
+    }
+
+    json->push_back('"');
+}
+
+Graphic3d_Vec3 toGraphicVec3(const gp_XYZ& coords)
+{
+    return Graphic3d_Vec3(float(coords.X()), float(coords.Y()), float(coords.Z()));
+}
+
+} // namespace
+
+GltfStreamWriter::GltfStreamWriter(const Options& options)
+    : m_options(options)
+{
+}
+
+bool GltfStreamWriter::write(
+        const FilePath& filepath,
+        const NCollection_Sequence<TDF_Label>& seqRootLabel,
+        TaskProgress* progress)
+{
+    m_errorMessage.clear();
+    m_progress = progress;
+    m_binSize = 0;
+    m_vecBufferView.clear();
+    m_vecAccessor.clear();
+    m_vecMesh.clear();
+    m_vecNode.clear();
+    m_vecRootNode.clear();
+    m_vecMaterial.clear();
+    m_mapProductMesh.clear();
+
+    // With GLB format binary data is first streamed into a temporary file, then copied into the
+    // BIN chunk once the JSON chunk is known(the JSON chunk has to come first)
+    FilePath binFilepath;
+    if (m_options.isBinary) {
+        binFilepath = filepath;
+        binFilepath += ".bin.tmp";
+        m_binUri.clear();
+    }
+    else {
+        m_binUri = filepath.stem().u8string() + ".bin";
+        binFilepath = filepath.parent_path() / filepathFrom(m_binUri);
+    }
+
+    m_binStream.open(binFilepath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!m_binStream.is_open()) {
+        m_errorMessage = fmt::format(
+                    GltfStreamWriterI18N::textIdTr("Unable to open file '{}'"), binFilepath.u8string()
+        );
+        return false;
+    }
+
+    auto fnCleanup = [&](bool success) {
+        m_binStream.close();
+        std::error_code ec;
+        if (m_options.isBinary || !success)
+            std_filesystem::remove(binFilepath, ec);
+    };
+
+    std::unordered_set<TDF_Label> setProduct;
+    for (const TDF_Label& label : seqRootLabel)
+        collectProducts(label, &setProduct);
+
+    m_productCount = int(setProduct.size());
+    setProduct.clear();
+    for (const TDF_Label& label : seqRootLabel) {
+        const int nodeId = this->addNode(label);
+        if (nodeId < 0) {
+            fnCleanup(false);
+            return false;
+        }
+
+        m_vecRootNode.push_back(nodeId);
+    }
+
+    m_binStream.close();
+    if (m_binStream.fail()) {
+        m_errorMessage = fmt::format(
+                    GltfStreamWriterI18N::textIdTr("Failed to write binary data into '{}'"), binFilepath.u8string()
+        );
+        fnCleanup(false);
+        return false;
+    }
+
+    const std::string json = this->jsonContents();
+    bool ok = false;
+    if (m_options.isBinary) {
+        ok = this->writeGlbFile(filepath, binFilepath, json);
+    }
+    else {
+        std::ofstream jsonStream(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+        jsonStream.write(json.data(), json.size());
+        jsonStream.close();
+        ok = !jsonStream.fail();
+        if (!ok) {
+            m_errorMessage = fmt::format(
+                        GltfStreamWriterI18N::textIdTr("Failed to write file '{}'"), filepath.u8string()
+            );
+        }
+    }
+
+    fnCleanup(ok);
+    return ok;
+}
+
+int GltfStreamWriter::addNode(const TDF_Label& label)
+{
+    if (TaskProgress::isAbortRequested(m_progress))
+        return -1;
+
+    const bool isReference = XCaf::isShapeReference(label);
+    const TDF_Label labelProduct = isReference ? XCaf::shapeReferred(label) : label;
+    Node node;
+    node.name = shapeName(label, labelProduct, m_options.nodeNameFormat);
+    if (isReference) {
+        node.trsf = XCaf::shapeReferenceLocation(label).Transformation();
+        m_options.coordSysConverter.TransformTransformation(node.trsf);
+    }
+
+    const int nodeId = int(m_vecNode.size());
+    m_vecNode.push_back(std::move(node));
+    if (XCaf::isShapeAssembly(labelProduct)) {
+        for (const TDF_Label& labelComponent : XCaf::shapeComponents(labelProduct)) {
+            const int childId = this->addNode(labelComponent);
+            if (childId < 0)
+                return -1;
+
+            m_vecNode.at(nodeId).vecChild.push_back(childId);
+        }
+    }
+    else {
+        m_vecNode.at(nodeId).mesh = this->findOrWriteMesh(labelProduct, label);
+        if (!m_errorMessage.empty())
+            return -1;
+    }
+
+    return nodeId;
+}
+
+int GltfStreamWriter::findOrWriteMesh(const TDF_Label& labelProduct, const TDF_Label& labelInstance)
+{
+    // Instanced products are written only once
+    auto itMesh = m_mapProductMesh.find(labelProduct);
+    if (itMesh != m_mapProductMesh.cend())
+        return itMesh->second;
+
+    // Merge faces of the product, one primitive per material
+    // Face colors are those of the product, instance colors aren't taken into account as glTF mesh
+    // data is shared by all instances
+    std::vector<PrimitiveData> vecPrimitiveData;
+    for (RWMesh_FaceIterator itFace(labelProduct, TopLoc_Location(), true); itFace.More(); itFace.Next()) {
+        if (itFace.IsEmptyMesh())
+            continue;
+
+        const int materialId = itFace.HasFaceColor() ? this->findOrAddMaterial(itFace.FaceColor()) : -1;
+        auto itData = std::find_if(
+                    vecPrimitiveData.begin(), vecPrimitiveData.end(),
+                    [=](const PrimitiveData& data) { return data.material == materialId; }
+        );
+        if (itData == vecPrimitiveData.end()) {
+            vecPrimitiveData.emplace_back();
+            vecPrimitiveData.back().material = materialId;
+            itData = std::prev(vecPrimitiveData.end());
+        }
+
+        PrimitiveData& data = *itData;
+        const size_t indexOffset = data.vecPosition.size();
+        const int nodeLower = itFace.NodeLower();
+        for (int i = nodeLower; i <= itFace.NodeUpper(); ++i) {
+            gp_XYZ pnt = itFace.NodeTransformed(i).XYZ();
+            m_options.coordSysConverter.TransformPosition(pnt);
+            data.vecPosition.push_back(toGraphicVec3(pnt));
+        }
+
+        if (itFace.HasNormals()) {
+            for (int i = nodeLower; i <= itFace.NodeUpper(); ++i) {
+                Graphic3d_Vec3 normal = toGraphicVec3(itFace.NormalTransformed(i).XYZ());
+                m_options.coordSysConverter.TransformNormal(normal);
+                data.vecNormal.push_back(normal);
+            }
+        }
+        else {
+            data.vecNormal.resize(data.vecPosition.size(), Graphic3d_Vec3(0.f));
+        }
+
+        if (m_options.forceExportUV) {
+            for (int i = nodeLower; i <= itFace.NodeUpper(); ++i) {
+                // glTF texture coordinates origin is top-left corner
+                const gp_Pnt2d uv = itFace.HasTexCoords() ? itFace.NodeTexCoord(i) : gp_Pnt2d(0, 0);
+                data.vecTexCoord.emplace_back(float(uv.X()), float(1. - uv.Y()));
+            }
+        }
+
+        for (int i = itFace.ElemLower(); i <= itFace.ElemUpper(); ++i) {
+            int n[3];
+            itFace.TriangleOriented(i).Get(n[0], n[1], n[2]);
+            for (int j = 0; j < 3; ++j)
+                data.vecIndex.push_back(uint32_t(indexOffset + n[j] - nodeLower));
+        }
+
+        if (!itFace.HasNormals()) {
+            // Fallback: average the normals of the triangles sharing a node
+            const size_t firstTriangleIndex = data.vecIndex.size() - 3 * size_t(itFace.NbTriangles());
+            for (size_t i = firstTriangleIndex; i < data.vecIndex.size(); i += 3) {
+                const uint32_t n0 = data.vecIndex.at(i);
+                const uint32_t n1 = data.vecIndex.at(i + 1);
+                const uint32_t n2 = data.vecIndex.at(i + 2);
+                const Graphic3d_Vec3 triNormal = Graphic3d_Vec3::Cross(
+                            data.vecPosition.at(n1) - data.vecPosition.at(n0),
+                            data.vecPosition.at(n2) - data.vecPosition.at(n0)
+                );
+                data.vecNormal.at(n0) += triNormal;
+                data.vecNormal.at(n1) += triNormal;
+                data.vecNormal.at(n2) += triNormal;
+            }
+
+            for (size_t i = indexOffset; i < data.vecNormal.size(); ++i) {
+                Graphic3d_Vec3& normal = data.vecNormal.at(i);
+                if (normal.Modulus() > std::numeric_limits<float>::epsilon())
+                    normal.Normalize();
+                else
+                    normal = Graphic3d_Vec3(0.f, 0.f, 1.f);
+            }
+        }
+    }
+
+    int meshId = -1;
+    if (!vecPrimitiveData.empty()) {
+        Mesh mesh;
+        mesh.name = shapeName(labelInstance, labelProduct, m_options.meshNameFormat);
+        for (PrimitiveData& data : vecPrimitiveData) {
+            Primitive primitive;
+            if (!this->writePrimitive(data, &primitive))
+                return -1;
+
+            mesh.vecPrimitive.push_back(primitive);
+            data = PrimitiveData{}; // Release memory as soon as possible
+        }
+
+        meshId = int(m_vecMesh.size());
+        m_vecMesh.push_back(std::move(mesh));
+    }
+
+    m_mapProductMesh.insert({ labelProduct, meshId });
+    if (m_progress)
+        m_progress->setValue(MathUtils::toPercent(int(m_mapProductMesh.size()), 0, m_productCount));
+
+    return meshId;
+}
+
+int GltfStreamWriter::findOrAddMaterial(const Quantity_ColorRGBA& color)
+{
+    auto itMaterial = std::find_if(
+                m_vecMaterial.cbegin(), m_vecMaterial.cend(),
+                [&](const Material& material) { return material.color.IsEqual(color); }
+    );
+    if (itMaterial != m_vecMaterial.cend())
+        return int(itMaterial - m_vecMaterial.cbegin());
+
+    m_vecMaterial.push_back({ color });
+    return int(m_vecMaterial.size()) - 1;
+}
+
+bool GltfStreamWriter::writePrimitive(const PrimitiveData& data, Primitive* primitive)
+{
+    const size_t vertexCount = data.vecPosition.size();
+    primitive->material = data.material;
+
+    auto fnAddAccessor = [&](int bufferView, int componentType, size_t count, const char* type) {
+        Accessor accessor;
+        accessor.bufferView = bufferView;
+        accessor.componentType = componentType;
+        accessor.count = count;
+        accessor.type = type;
+        m_vecAccessor.push_back(accessor);
+        return int(m_vecAccessor.size()) - 1;
+    };
+
+    // Positions
+    {
+        const int bufferView = this->writeBufferView(
+                    data.vecPosition.data(), vertexCount * sizeof(Graphic3d_Vec3),
+                    int(sizeof(Graphic3d_Vec3)), GltfTarget_ArrayBuffer
+        );
+        if (bufferView < 0)
+            return false;
+
+        primitive->positionAccessor = fnAddAccessor(bufferView, GltfComponentType_Float, vertexCount, "VEC3");
+        Accessor& accessor = m_vecAccessor.back();
+        accessor.hasMinMax = true;
+        accessor.minValue = Graphic3d_Vec3(std::numeric_limits<float>::max());
+        accessor.maxValue = Graphic3d_Vec3(std::numeric_limits<float>::lowest());
+        for (const Graphic3d_Vec3& pnt : data.vecPosition) {
+            accessor.minValue = accessor.minValue.cwiseMin(pnt);
+            accessor.maxValue = accessor.maxValue.cwiseMax(pnt);
+        }
+    }
+
+    // Normals
+    {
+        const int bufferView = this->writeBufferView(
+                    data.vecNormal.data(), vertexCount * sizeof(Graphic3d_Vec3),
+                    int(sizeof(Graphic3d_Vec3)), GltfTarget_ArrayBuffer
+        );
+        if (bufferView < 0)
+            return false;
+
+        primitive->normalAccessor = fnAddAccessor(bufferView, GltfComponentType_Float, vertexCount, "VEC3");
+    }
+
+    // UV coordinates
+    if (!data.vecTexCoord.empty()) {
+        const int bufferView = this->writeBufferView(
+                    data.vecTexCoord.data(), vertexCount * sizeof(Graphic3d_Vec2),
+                    int(sizeof(Graphic3d_Vec2)), GltfTarget_ArrayBuffer
+        );
+        if (bufferView < 0)
+            return false;
+
+        primitive->texCoordAccessor = fnAddAccessor(bufferView, GltfComponentType_Float, vertexCount, "VEC2");
+    }
+
+    // Triangle indices, 16-bit whenever possible(note 65535 is reserved by glTF for primitive restart)
+    {
+        const size_t indexCount = data.vecIndex.size();
+        int bufferView = -1;
+        int componentType = 0;
+        if (vertexCount <= std::numeric_limits<uint16_t>::max()) {
+            const std::vector<uint16_t> vecIndex16(data.vecIndex.cbegin(), data.vecIndex.cend());
+            bufferView = this->writeBufferView(
+                        vecIndex16.data(), indexCount * sizeof(uint16_t), 0, GltfTarget_ElementArrayBuffer
+            );
+            componentType = GltfComponentType_UnsignedShort;
+        }
+        else {
+            bufferView = this->writeBufferView(
+                        data.vecIndex.data(), indexCount * sizeof(uint32_t), 0, GltfTarget_ElementArrayBuffer
+            );
+            componentType = GltfComponentType_UnsignedInt;
+        }
+
+        if (bufferView < 0)
+            return false;
+
+        primitive->indicesAccessor = fnAddAccessor(bufferView, componentType, indexCount, "SCALAR");
+    }
+
+    return true;
+}
+
+int GltfStreamWriter::writeBufferView(const void* data, uint64_t byteLength, int byteStride, int target)
+{
+    BufferView view;
+    view.byteOffset = m_binSize;
+    view.byteLength = byteLength;
+    view.byteStride = byteStride;
+    view.target = target;
+    m_binStream.write(reinterpret_cast<const char*>(data), byteLength);
+    // Keep buffer views 4-bytes aligned
+    const char padding[4] = {};
+    const uint64_t paddingSize = (4 - (byteLength % 4)) % 4;
+    m_binStream.write(padding, paddingSize);
+    if (m_binStream.fail()) {
+        m_errorMessage = GltfStreamWriterI18N::textIdTr("Failed to write binary data");
+        return -1;
+    }
+
+    m_binSize += byteLength + paddingSize;
+    m_vecBufferView.push_back(view);
+    return int(m_vecBufferView.size()) - 1;
+}
+
+std::string GltfStreamWriter::jsonContents() const
+{
+    std::string json;
+    auto itJson = std::back_inserter(json);
+    json.append(R"({"asset":{"generator":"Mayo","version":"2.0"})");
+    // Scene
+    json.append(R"(,"scene":0,"scenes":[{"nodes":[)");
+    for (const int& nodeId : m_vecRootNode)
+        fmt::format_to(itJson, "{}{}", &nodeId != &m_vecRootNode.front() ? "," : "", nodeId);
+
+    json.append("]}]");
+
+    // Nodes
+    json.append(R"(,"nodes":[)");
+    for (const Node& node : m_vecNode) {
+        json.append(&node != &m_vecNode.front() ? ",{" : "{");
+        bool isFirstMember = true;
+        auto fnMember = [&](const char* name) {
+            fmt::format_to(itJson, "{}\"{}\":", isFirstMember ? "" : ",", name);
+            isFirstMember = false;
+        };
+        if (!node.name.empty()) {
+            fnMember("name");
+            appendJsonString(&json, node.name);
+        }
+
+        if (node.trsf.Form() != gp_Identity) {
+            const bool useMatrix =
+                    m_options.transformationFormat == RWGltf_WriterTrsfFormat_Mat4
+                    || node.trsf.IsNegative()
+                    || (m_options.transformationFormat == RWGltf_WriterTrsfFormat_Compact
+                        && std::abs(node.trsf.ScaleFactor() - 1.) > Precision::Confusion())
+                    ;
+            if (useMatrix) {
+                fnMember("matrix");
+                json.push_back('[');
+                for (int col = 1; col <= 4; ++col) {
+                    for (int row = 1; row <= 3; ++row)
+                        fmt::format_to(itJson, "{},", node.trsf.Value(row, col));
+
+                    json.append(col < 4 ? "0," : "1");
+                }
+
+                json.push_back(']');
+            }
+            else {
+                const gp_XYZ t = node.trsf.TranslationPart();
+                const gp_Quaternion q = node.trsf.GetRotation();
+                fnMember("translation");
+                fmt::format_to(itJson, "[{},{},{}]", t.X(), t.Y(), t.Z());
+                fnMember("rotation");
+                fmt::format_to(itJson, "[{},{},{},{}]", q.X(), q.Y(), q.Z(), q.W());
+                if (std::abs(node.trsf.ScaleFactor() - 1.) > Precision::Confusion()) {
+                    const double s = node.trsf.ScaleFactor();
+                    fnMember("scale");
+                    fmt::format_to(itJson, "[{},{},{}]", s, s, s);
+                }
+            }
+        }
+
+        if (node.mesh >= 0) {
+            fnMember("mesh");
+            fmt::format_to(itJson, "{}", node.mesh);
+        }
+
+        if (!node.vecChild.empty()) {
+            fnMember("children");
+            json.push_back('[');
+            for (const int& childId : node.vecChild)
+                fmt::format_to(itJson, "{}{}", &childId != &node.vecChild.front() ? "," : "", childId);
+
+            json.push_back(']');
+        }
+
+        json.push_back('}');
+    }
+
+    json.push_back(']');
+
+    // Meshes
+    if (!m_vecMesh.empty()) {
+        json.append(R"(,"meshes":[)");
+        for (const Mesh& mesh : m_vecMesh) {
+            json.append(&mesh != &m_vecMesh.front() ? ",{" : "{");
+            if (!mesh.name.empty()) {
+                json.append(R"("name":)");
+                appendJsonString(&json, mesh.name);
+                json.push_back(',');
+            }
+
+            json.append(R"("primitives":[)");
+            for (const Primitive& primitive : mesh.vecPrimitive) {
+                json.append(&primitive != &mesh.vecPrimitive.front() ? ",{" : "{");
+                fmt::format_to(
+                            itJson, R"("attributes":{{"POSITION":{},"NORMAL":{})",
+                            primitive.positionAccessor, primitive.normalAccessor
+                );
+                if (primitive.texCoordAccessor >= 0)
+                    fmt::format_to(itJson, R"(,"TEXCOORD_0":{})", primitive.texCoordAccessor);
+
+                fmt::format_to(itJson, R"(}},"indices":{},"mode":4)", primitive.indicesAccessor);
+                if (primitive.material >= 0)
+                    fmt::format_to(itJson, R"(,"material":{})", primitive.material);
+
+                json.push_back('}');
+            }
+
+            json.append("]}");
+        }
+
+        json.push_back(']');
+    }
+
+    // Materials
+    if (!m_vecMaterial.empty()) {
+        json.append(R"(,"materials":[)");
+        for (const Material& material : m_vecMaterial) {
+            const Quantity_Color& rgb = material.color.GetRGB();
+            fmt::format_to(
+                        itJson,
+                        R"({}{{"pbrMetallicRoughness":{{"baseColorFactor":[{},{},{},{}],"metallicFactor":0,"roughnessFactor":1}})",
+                        &material != &m_vecMaterial.front() ? "," : "",
+                        rgb.Red(), rgb.Green(), rgb.Blue(), material.color.Alpha()
+            );
+            if (material.color.Alpha() < 1.f)
+                json.append(R"(,"alphaMode":"BLEND")");
+
+            json.append(R"(,"doubleSided":true})");
+        }
+
+        json.push_back(']');
+    }
+
+    // Accessors
+    if (!m_vecAccessor.empty()) {
+        json.append(R"(,"accessors":[)");
+        for (const Accessor& accessor : m_vecAccessor) {
+            fmt::format_to(
+                        itJson, R"({}{{"bufferView":{},"componentType":{},"count":{},"type":"{}")",
+                        &accessor != &m_vecAccessor.front() ? "," : "",
+                        accessor.bufferView, accessor.componentType, accessor.count, accessor.type
+            );
+            if (accessor.hasMinMax) {
+                const Graphic3d_Vec3& vmin = accessor.minValue;
+                const Graphic3d_Vec3& vmax = accessor.maxValue;
+                fmt::format_to(
+                            itJson, R"(,"min":[{},{},{}],"max":[{},{},{}])",
+                            vmin.x(), vmin.y(), vmin.z(), vmax.x(), vmax.y(), vmax.z()
+                );
+            }
+
+            json.push_back('}');
+        }
+
+        json.push_back(']');
+    }
+
+    // Buffer views and buffer
+    if (!m_vecBufferView.empty()) {
+        json.append(R"(,"bufferViews":[)");
+        for (const BufferView& view : m_vecBufferView) {
+            fmt::format_to(
+                        itJson, R"({}{{"buffer":0,"byteOffset":{},"byteLength":{})",
+                        &view != &m_vecBufferView.front() ? "," : "",
+                        view.byteOffset, view.byteLength
+            );
+            if (view.byteStride > 0)
+                fmt::format_to(itJson, R"(,"byteStride":{})", view.byteStride);
+
+            fmt::format_to(itJson, R"(,"target":{}}})", view.target);
+        }
+
+        json.append(R"(],"buffers":[{)");
+        if (!m_binUri.empty()) {
+            json.append(R"("uri":)");
+            appendJsonString(&json, m_binUri);
+            json.push_back(',');
+        }
+
+        fmt::format_to(itJson, R"("byteLength":{}}}])", m_binSize);
+    }
+
+    json.push_back('}');
+    return json;
+}
+
+bool GltfStreamWriter::writeGlbFile(const FilePath& filepath, const FilePath& binFilepath, const std::string& json)
+{
+    const uint64_t jsonChunkSize = (json.size() + 3) & ~uint64_t(3);
+    const uint64_t binChunkSize = m_binSize; // Already 4-bytes aligned
+    const uint64_t glbSize = 12 + 8 + jsonChunkSize + (binChunkSize > 0 ? 8 + binChunkSize : 0);
+    if (glbSize > std::numeric_limits<uint32_t>::max()) {
+        m_errorMessage = GltfStreamWriterI18N::textIdTr("GLB file would exceed 4GB, use JSON format instead");
+        return false;
+    }
+
+    std::ofstream glbStream(filepath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!glbStream.is_open()) {
+        m_errorMessage = fmt::format(
+                    GltfStreamWriterI18N::textIdTr("Unable to open file '{}'"), filepath.u8string()
+        );
+        return false;
+    }
+
+    // glTF binary data is little-endian
+    auto fnWriteUInt32 = [&](uint32_t value) {
+        const uint8_t bytes[4] = {
+            uint8_t(value & 0xFF), uint8_t((value >> 8) & 0xFF),
+            uint8_t((value >> 16) & 0xFF), uint8_t((value >> 24) & 0xFF)
+        };
+        glbStream.write(reinterpret_cast<const char*>(bytes), 4);
+    };
+
+    // Header
+    glbStream.write("glTF", 4);
+    fnWriteUInt32(2);
+    fnWriteUInt32(uint32_t(glbSize));
+    // JSON chunk, padded with spaces
+    fnWriteUInt32(uint32_t(jsonChunkSize));
+    glbStream.write("JSON", 4);
+    glbStream.write(json.data(), json.size());
+    for (uint64_t i = json.size(); i < jsonChunkSize; ++i)
+        glbStream.put(' ');
+
+    // BIN chunk, copied by blocks from the temporary file
+    if (binChunkSize > 0) {
+        fnWriteUInt32(uint32_t(binChunkSize));
+        glbStream.write("BIN\0", 4);
+        std::ifstream binStream(binFilepath, std::ios::in | std::ios::binary);
+        std::vector<char> buffer(1024 * 1024);
+        while (binStream && glbStream) {
+            binStream.read(buffer.data(), buffer.size());
+            glbStream.write(buffer.data(), binStream.gcount());
+        }
+    }
+
+    glbStream.close();
+    if (glbStream.fail()) {
+        m_errorMessage = fmt::format(
+                    GltfStreamWriterI18N::textIdTr("Failed to write file '{}'"), filepath.u8string()
+        );
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Mayo::IO
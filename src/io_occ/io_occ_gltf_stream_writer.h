@@ -0,0 +1,137 @@
+/****************************************************************************
+** Copyright (c) 2016, Fougue SAS <https://www.fougue.pro>
+** SPDX-License-Identifier: BSD-2-Clause
+****************************************************************************/
+
+#pragma once
+
+#include "../base/caf_utils.h"
+#include "../base/filepath.h"
+#include "io_occ_gltf_writer.h"
+
+#include <gp_Trsf.hxx>
+#include <Graphic3d_Vec2.hxx>
+#include <Graphic3d_Vec3.hxx>
+#include <Quantity_ColorRGBA.hxx>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Mayo { class TaskProgress; }
+
+namespace Mayo::IO {
+
+// Writes glTF/GLB files from a XCAF document without building the whole binary buffer in memory
+// Binary data is written to disk product after product as soon as each mesh is built
+// Faces of a product are merged into one primitive per material, index type(16 or 32 bits) is
+// selected for each primitive and a product referenced by several XCAF instances is written once,
+// its glTF mesh being then shared by the corresponding glTF nodes
+class GltfStreamWriter {
+public:
+    struct Options {
+        bool isBinary = true;
+        RWMesh_CoordinateSystemConverter coordSysConverter;
+        RWGltf_WriterTrsfFormat transformationFormat = RWGltf_WriterTrsfFormat_Compact;
+        OccGltfWriter::ShapeNameFormat nodeNameFormat = OccGltfWriter::ShapeNameFormat::ProductOrInstance;
+        OccGltfWriter::ShapeNameFormat meshNameFormat = OccGltfWriter::ShapeNameFormat::Product;
+        bool forceExportUV = false;
+    };
+
+    explicit GltfStreamWriter(const Options& options);
+
+    // Writes the assembly trees starting at 'seqRootLabel' into glTF file 'filepath'
+    // Returns 'true' on success, otherwise errorMessage() gives details
+    bool write(
+            const FilePath& filepath,
+            const NCollection_Sequence<TDF_Label>& seqRootLabel,
+            TaskProgress* progress
+    );
+
+    const std::string& errorMessage() const { return m_errorMessage; }
+
+    // Statistics available after write()
+    int meshCount() const { return int(m_vecMesh.size()); }
+    int nodeCount() const { return int(m_vecNode.size()); }
+    uint64_t binaryDataSize() const { return m_binSize; }
+
+private:
+    struct BufferView {
+        uint64_t byteOffset = 0;
+        uint64_t byteLength = 0;
+        int byteStride = 0;
+        int target = 0;
+    };
+
+    struct Accessor {
+        int bufferView = -1;
+        int componentType = 0;
+        uint64_t count = 0;
+        const char* type = "";
+        bool hasMinMax = false;
+        Graphic3d_Vec3 minValue;
+        Graphic3d_Vec3 maxValue;
+    };
+
+    struct Primitive {
+        int positionAccessor = -1;
+        int normalAccessor = -1;
+        int texCoordAccessor = -1;
+        int indicesAccessor = -1;
+        int material = -1;
+    };
+
+    struct Mesh {
+        std::string name;
+        std::vector<Primitive> vecPrimitive;
+    };
+
+    struct Node {
+        std::string name;
+        gp_Trsf trsf;
+        int mesh = -1;
+        std::vector<int> vecChild;
+    };
+
+    struct Material {
+        Quantity_ColorRGBA color;
+    };
+
+    // Merged faces of a product sharing the same material, lives only while the product is written
+    struct PrimitiveData {
+        int material = -1;
+        std::vector<Graphic3d_Vec3> vecPosition;
+        std::vector<Graphic3d_Vec3> vecNormal;
+        std::vector<Graphic3d_Vec2> vecTexCoord;
+        std::vector<uint32_t> vecIndex;
+    };
+
+    int addNode(const TDF_Label& label);
+    int findOrWriteMesh(const TDF_Label& labelProduct, const TDF_Label& labelInstance);
+    int findOrAddMaterial(const Quantity_ColorRGBA& color);
+    bool writePrimitive(const PrimitiveData& data, Primitive* primitive);
+    int writeBufferView(const void* data, uint64_t byteLength, int byteStride, int target);
+    std::string jsonContents() const;
+    bool writeGlbFile(const FilePath& filepath, const FilePath& binFilepath, const std::string& json);
+
+    Options m_options;
+    std::string m_errorMessage;
+    TaskProgress* m_progress = nullptr;
+    int m_productCount = 0;
+
+    std::ofstream m_binStream;
+    std::string m_binUri;
+    uint64_t m_binSize = 0;
+
+    std::vector<BufferView> m_vecBufferView;
+    std::vector<Accessor> m_vecAccessor;
+    std::vector<Mesh> m_vecMesh;
+    std::vector<Node> m_vecNode;
+    std::vector<int> m_vecRootNode;
+    std::vector<Material> m_vecMaterial;
+    std::unordered_map<TDF_Label, int> m_mapProductMesh;
+};
+
+} // namespace Mayo::IO
@@ -6,6 +6,7 @@
 #include "io_occ_gltf_writer.h"
 
 #include "../base/application_item.h"
+#include "../base/document.h"
 #include "../base/enumeration_fromenum.h"
 #include "../base/io_system.h"
 #include "../base/messenger.h"
@@ -15,6 +16,7 @@
 #include "../base/property_enumeration.h"
 #include "../base/text_id.h"
 #include "io_occ_common.h"
+#include "io_occ_gltf_stream_writer.h"
 
 #include <fmt/format.h>
 #include <RWGltf_CafWriter.hxx>
@@ -68,6 +70,13 @@ public:
                                 this->mergeFaces.label()
                     )
         );
+        this->streamingExport.setDescription(
+                    textIdTr("Write binary data to disk as meshes are produced, memory usage doesn't "
+                             "depend on the size of the whole model.\n\n"
+                             "Faces of a part are always merged(one primitive per material) and shared "
+                             "parts are written once, index type(16 or 32 bits) is selected per primitive.\n\n"
+                             "Textures are not exported in this mode")
+        );
     }
 
     void restoreDefaults() override
@@ -88,21 +97,25 @@ public:
         this->embedTextures.setValue(defaults.embedTextures);
         this->mergeFaces.setValue(defaults.mergeFaces);
         this->keepIndices16b.setValue(defaults.keepIndices16b);
-
-        this->embedTextures.setEnabled(this->format == OccGltfWriter::Format::Binary);
-        this->keepIndices16b.setEnabled(this->mergeFaces);
+        this->streamingExport.setValue(defaults.streamingExport);
+        this->updateEnabledProperties();
     }
 
     void onPropertyChanged(Property* prop) override
     {
-        if (prop == &this->format)
-            this->embedTextures.setEnabled(this->format == OccGltfWriter::Format::Binary);
-        else if (prop == &this->mergeFaces)
-            this->keepIndices16b.setEnabled(this->mergeFaces);
+        if (prop == &this->format || prop == &this->mergeFaces || prop == &this->streamingExport)
+            this->updateEnabledProperties();
 
         PropertyGroup::onPropertyChanged(prop);
     }
 
+    void updateEnabledProperties()
+    {
+        this->embedTextures.setEnabled(this->format == OccGltfWriter::Format::Binary && !this->streamingExport);
+        this->mergeFaces.setEnabled(!this->streamingExport);
+        this->keepIndices16b.setEnabled(this->mergeFaces && !this->streamingExport);
+    }
+
     PropertyEnum<RWMesh_CoordinateSystem> inputCoordinateSystem{ this, textId("inputCoordinateSystem") };
     PropertyEnum<RWMesh_CoordinateSystem> outputCoordinateSystem{ this, textId("outputCoordinateSystem") };
     PropertyEnum<RWGltf_WriterTrsfFormat> transformationFormat{ this, textId("transformationFormat") };
@@ -113,6 +126,7 @@ public:
     PropertyBool embedTextures{ this, textId("embedTextures") };
     PropertyBool mergeFaces{ this, textId("mergeFaces") };
     PropertyBool keepIndices16b{ this, textId("keepIndices16b") };
+    PropertyBool streamingExport{ this, textId("streamingExport") };
 };
 
 bool OccGltfWriter::transfer(gsl::span<const ApplicationItem> spanAppItem, TaskProgress*)
@@ -143,6 +157,9 @@ bool OccGltfWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
     if (!m_document)
         return false;
 
+    if (m_params.streamingExport)
+        return this->writeFileStreaming(filepath, progress);
+
     auto occProgress = makeOccHandle<OccProgressIndicator>(progress);
     const bool isBinary = m_params.format == Format::Binary;
     RWGltf_CafWriter writer(filepath.u8string().c_str(), isBinary);
@@ -196,6 +213,28 @@ bool OccGltfWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
         return writer.Perform(m_document, m_seqRootLabel, nullptr, fileInfo, occProgress->Start());
 }
 
+bool OccGltfWriter::writeFileStreaming(const FilePath& filepath, TaskProgress* progress)
+{
+    GltfStreamWriter::Options options;
+    options.isBinary = m_params.format == Format::Binary;
+    options.coordSysConverter.SetInputCoordinateSystem(m_params.inputCoordinateSystem);
+    options.coordSysConverter.SetOutputCoordinateSystem(m_params.outputCoordinateSystem);
+    options.transformationFormat = m_params.transformationFormat;
+    options.nodeNameFormat = m_params.nodeNameFormat;
+    options.meshNameFormat = m_params.meshNameFormat;
+    options.forceExportUV = m_params.forceExportUV;
+    GltfStreamWriter writer(options);
+    const auto seqRootLabel = m_seqRootLabel.IsEmpty() ? m_document->xcaf().topLevelFreeShapes() : m_seqRootLabel;
+    if (!writer.write(filepath, seqRootLabel, progress)) {
+        if (!writer.errorMessage().empty())
+            this->messenger()->emitError(writer.errorMessage());
+
+        return false;
+    }
+
+    return true;
+}
+
 std::unique_ptr<PropertyGroup> OccGltfWriter::createProperties(PropertyGroup* parentGroup)
 {
     return std::make_unique<Properties>(parentGroup);
@@ -215,6 +254,7 @@ void OccGltfWriter::applyProperties(const PropertyGroup* params)
         m_params.embedTextures = ptr->embedTextures;
         m_params.mergeFaces = ptr->mergeFaces;
         m_params.keepIndices16b = ptr->keepIndices16b;
+        m_params.streamingExport = ptr->streamingExport;
     }
 }
 
@@ -46,11 +46,14 @@ public:
         bool embedTextures = true;    // Only applicable if `format` == Format::Binary
         bool mergeFaces = false;
         bool keepIndices16b = false;  // Only applicable if 'mergeFaces' == true
+        bool streamingExport = false; // Use GltfStreamWriter instead of RWGltf_CafWriter
     };
     Parameters& parameters() { return m_params; }
     const Parameters& constParameters() const { return m_params; }
 
 private:
+    bool writeFileStreaming(const FilePath& filepath, TaskProgress* progress);
+
     class Properties;
     Parameters m_params;
     DocumentPtr m_document;
@@ -70,15 +70,24 @@ public:
 
 bool OccStlReader::readFile(const FilePath& filepath, TaskProgress* progress)
 {
+    m_mesh.Nullify();
+    if (TaskProgress::isAbortRequested(progress))
+        return false;
+
     auto indicator = makeOccHandle<OccProgressIndicator>(progress);
     m_baseFilename = filepath.stem();
     m_mesh = RWStl::ReadFile(filepath.u8string().c_str(), TKernelUtils::start(indicator));
+    // RWStl checks the abort state only at intervals, mesh might be partial if abort was requested
+    if (TaskProgress::isAbortRequested(progress))
+        m_mesh.Nullify();
+
     return !m_mesh.IsNull();
 }
 
-NCollection_Sequence<TDF_Label> OccStlReader::transfer(DocumentPtr doc, TaskProgress* /*progress*/)
+NCollection_Sequence<TDF_Label> OccStlReader::transfer(DocumentPtr doc, TaskProgress* progress)
 {
-    if (m_mesh.IsNull())
+    // Mesh was entirely built by readFile(), transfer is a constant-time operation
+    if (m_mesh.IsNull() || TaskProgress::isAbortRequested(progress))
         return {};
 
     const TDF_Label entityLabel = doc->newEntityShapeLabel();
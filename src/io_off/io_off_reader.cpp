@@ -153,6 +153,8 @@ bool OffReader::readFile(const FilePath& filepath, TaskProgress* progress)
         return false;
     };
 
+    const CancellationToken cancellationToken = progress->cancellationToken();
+
     // Reset internal data
     m_baseFilename = filepath.stem();
     m_vecVertex.clear();
@@ -212,6 +214,9 @@ bool OffReader::readFile(const FilePath& filepath, TaskProgress* progress)
     // Consume vertices
     m_vecVertex.reserve(vertexCount);
     while (!ifs.eof() && Cpp::cmpLess(m_vecVertex.size(), vertexCount)) {
+        if (cancellationToken.isCancelled())
+            return false;
+
         getNonCommentLine(ifs, strLine);
         const auto arrayStrCoord = getWords<3>(strLine);
         if (hasEmptyString(arrayStrCoord))
@@ -236,6 +241,9 @@ bool OffReader::readFile(const FilePath& filepath, TaskProgress* progress)
     m_vecFacet.reserve(facetCount);
     std::vector<std::string_view> vecWord;
     while (!ifs.eof() && Cpp::cmpLess(m_vecFacet.size(), facetCount)) {
+        if (cancellationToken.isCancelled())
+            return false;
+
         getNonCommentLine(ifs, strLine);
         getWords(strLine, vecWord);
         const Facet facet = { int(m_vecAllFacetIndex.size()), strToNum<int>(vecWord.front()) };
@@ -305,9 +313,13 @@ TDF_Label OffReader::transferMesh(DocumentPtr doc, TaskProgress* progress)
     };
 
     // Transfer vertices and prepare vertex colors
+    const CancellationToken cancellationToken = progress->cancellationToken();
     std::vector<Quantity_Color> vecVertexColor;
     vecVertexColor.reserve(m_vecVertex.size());
     for (const Vertex& vertex : m_vecVertex) {
+        if (cancellationToken.isCancelled())
+            return {};
+
         const auto ivertex = Cpp::indexInSpan(m_vecVertex, vertex);
         MeshUtils::setNode(mesh, ivertex + 1, vertex.coords);
         const std::uint32_t c = vertex.color;
@@ -330,6 +342,9 @@ TDF_Label OffReader::transferMesh(DocumentPtr doc, TaskProgress* progress)
     // Transfer faces
     int iTriangle = 0;
     for (const Facet& facet: m_vecFacet) {
+        if (cancellationToken.isCancelled())
+            return {};
+
         const int facet0 = m_vecAllFacetIndex.at(facet.startIndexInArray);
         if (facet.vertexCount == 3) {
             const int facet1 = m_vecAllFacetIndex.at(facet.startIndexInArray + 1);
@@ -12,6 +12,7 @@
 #include "../base/mesh_access.h"
 #include "../base/messenger.h"
 #include "../base/property_builtins.h"
+#include "../base/task_manager.h"
 #include "../base/task_progress.h"
 #include "../base/text_id.h"
 
@@ -20,25 +21,56 @@
 #include <fstream>
 #include <locale>
 #include <string>
+#include <utility>
 
 namespace Mayo::IO {
 
 struct OffWriterI18N { MAYO_DECLARE_TEXT_ID_FUNCTIONS(Mayo::IO::OffWriterI18N) };
 
-bool OffWriter::transfer(gsl::span<const ApplicationItem> appItems, TaskProgress* /*progress*/)
+bool OffWriter::transfer(gsl::span<const ApplicationItem> appItems, TaskProgress* progress)
 {
+    progress = progress ? progress : &TaskProgress::null();
     m_vecTreeNode.clear();
     m_vecTreeNode.reserve(appItems.size());
-    System::traverseUniqueItems(appItems, [&](const DocumentTreeNode& treeNode) {
+    System::traverseUniqueItemsWithLocation(appItems, [&](const DocumentTreeNode& treeNode, const TopLoc_Location& loc) {
         if (treeNode.isLeaf())
-            m_vecTreeNode.push_back(treeNode);
+            m_vecTreeNode.push_back({ treeNode, loc });
     });
+
+    // Count vertices and facets, required by the OFF header
+    // This only reads the model trees, so they can be traversed concurrently by the threads running
+    // the tasks
+    using VertexFacetCount = std::pair<int, int>;
+    TaskExecutor* executor = progress->taskManager() ? &progress->taskManager()->executor() : nullptr;
+    const VertexFacetCount counts = System::reduceUniqueItemsParallel(
+        appItems,
+        VertexFacetCount{ 0, 0 },
+        [](const DocumentTreeNode& treeNode) {
+            VertexFacetCount nodeCounts{ 0, 0 };
+            if (treeNode.isLeaf()) {
+                // Location doesn't matter for counting
+                IMeshAccess_visitMeshes(treeNode, TopLoc_Location(), [&](const IMeshAccess& mesh) {
+                    nodeCounts.first += mesh.triangulation()->NbNodes();
+                    nodeCounts.second += mesh.triangulation()->NbTriangles();
+                });
+            }
+
+            return nodeCounts;
+        },
+        [](const VertexFacetCount& lhs, const VertexFacetCount& rhs) {
+            return VertexFacetCount{ lhs.first + rhs.first, lhs.second + rhs.second };
+        },
+        executor
+    );
+    m_vertexCount = counts.first;
+    m_facetCount = counts.second;
     return true;
 }
 
 bool OffWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
 {
     progress = progress ? progress : &TaskProgress::null();
+    const CancellationToken cancellationToken = progress->cancellationToken();
     std::ofstream fstr(filepath);
     if (!fstr.is_open()) {
         this->messenger()->emitError(OffWriterI18N::textIdTr("Failed to open file"));
@@ -48,15 +80,8 @@ bool OffWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
     fstr.imbue(std::locale::classic());
     fstr << "OFF\n";
 
-    // Count vertices and facets
-    int vertexCount = 0;
-    int facetCount = 0;
-    for (const DocumentTreeNode& treeNode : m_vecTreeNode) {
-        IMeshAccess_visitMeshes(treeNode, [&](const IMeshAccess& mesh) {
-            vertexCount += mesh.triangulation()->NbNodes();
-            facetCount += mesh.triangulation()->NbTriangles();
-        });
-    }
+    const int vertexCount = m_vertexCount;
+    const int facetCount = m_facetCount;
 
     // Helper function for progress report
     auto fnUpdateProgress = [=](int current) {
@@ -68,11 +93,11 @@ bool OffWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
     fstr << vertexCount << " " << facetCount << " " << 0/*edgeCount*/ << "\n";
     // Write vertices
     int ivertex = 0;
-    for (const DocumentTreeNode& treeNode : m_vecTreeNode) {
-        IMeshAccess_visitMeshes(treeNode, [&](const IMeshAccess& mesh) {
+    for (const TreeNodeItem& item : m_vecTreeNode) {
+        IMeshAccess_visitMeshes(item.treeNode, item.location, [&](const IMeshAccess& mesh) {
             const gp_Trsf& meshTrsf = mesh.location().Transformation();
             const OccHandle<Poly_Triangulation>& triangulation = mesh.triangulation();
-            for (int i = 1; i <= triangulation->NbNodes(); ++i) {
+            for (int i = 1; i <= triangulation->NbNodes() && !cancellationToken.isCancelled(); ++i) {
                 const gp_Pnt pnt = triangulation->Node(i).Transformed(meshTrsf);
                 const std::optional<Quantity_Color> color = mesh.nodeColor(i - 1);
                 fstr << pnt.X() << " " << pnt.Y() << " " << pnt.Z();
@@ -92,10 +117,10 @@ bool OffWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
     // Write facets(triangles)
     int offsetVertex = 0;
     int ifacet = 0;
-    for (const DocumentTreeNode& treeNode : m_vecTreeNode) {
-        IMeshAccess_visitMeshes(treeNode, [&](const IMeshAccess& mesh) {
+    for (const TreeNodeItem& item : m_vecTreeNode) {
+        IMeshAccess_visitMeshes(item.treeNode, item.location, [&](const IMeshAccess& mesh) {
             const OccHandle<Poly_Triangulation>& triangulation = mesh.triangulation();
-            for (int i = 1; i <= triangulation->NbTriangles(); ++i) {
+            for (int i = 1; i <= triangulation->NbTriangles() && !cancellationToken.isCancelled(); ++i) {
                 const Poly_Triangle& tri = triangulation->Triangle(i);
                 fstr << "3 "
                      << offsetVertex + tri.Value(1) - 1 << " "
@@ -108,7 +133,7 @@ bool OffWriter::writeFile(const FilePath& filepath, TaskProgress* progress)
         });
     }
 
-    return true;
+    return !cancellationToken.isCancelled();
 }
 
 void OffWriter::applyProperties(const PropertyGroup*)
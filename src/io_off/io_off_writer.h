@@ -9,6 +9,7 @@
 #include "../base/io_writer.h"
 #include "../base/io_single_format_factory.h"
 
+#include <TopLoc_Location.hxx>
 #include <vector>
 
 namespace Mayo::IO {
@@ -23,7 +24,14 @@ public:
     static std::unique_ptr<PropertyGroup> createProperties(PropertyGroup*)  { return {}; }
 
 private:
-    std::vector<DocumentTreeNode> m_vecTreeNode;
+    struct TreeNodeItem {
+        DocumentTreeNode treeNode;
+        TopLoc_Location location; // Absolute location of the tree node shape
+    };
+
+    std::vector<TreeNodeItem> m_vecTreeNode;
+    int m_vertexCount = 0;
+    int m_facetCount = 0;
 };
 
 // Provides factory to create OffWriter objects
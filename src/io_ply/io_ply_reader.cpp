@@ -15,6 +15,7 @@
 #include "../base/messenger.h"
 #include "../base/point_cloud_data.h"
 #include "../base/property_builtins.h"
+#include "../base/task_progress.h"
 #include "../base/tkernel_utils.h"
 
 #include <miniply/miniply.h>
@@ -26,8 +27,9 @@
 
 namespace Mayo::IO {
 
-bool PlyReader::readFile(const FilePath& filepath, TaskProgress* /*progress*/)
+bool PlyReader::readFile(const FilePath& filepath, TaskProgress* progress)
 {
+    const CancellationToken cancellationToken = progress->cancellationToken();
     miniply::PLYReader reader(filepath.u8string().c_str());
     if (!reader.valid())
         return false;
@@ -53,6 +55,10 @@ bool PlyReader::readFile(const FilePath& filepath, TaskProgress* /*progress*/)
     bool gotVerts = false;
     bool gotFaces = false;
     while (reader.has_element() && (!gotVerts || !gotFaces)) {
+        // miniply loads an element at once, so abort can only be checked between elements
+        if (cancellationToken.isCancelled())
+            return false;
+
         if (reader.element_is(miniply::kPLYVertexElement)) {
             uint32_t prop3Idxs[3] = {};
             if (!reader.load_element() || !reader.find_pos(prop3Idxs)) {
@@ -151,8 +157,9 @@ NCollection_Sequence<TDF_Label> PlyReader::transfer(DocumentPtr doc, TaskProgres
     return {};
 }
 
-TDF_Label PlyReader::transferMesh(DocumentPtr doc, TaskProgress* /*progress*/)
+TDF_Label PlyReader::transferMesh(DocumentPtr doc, TaskProgress* progress)
 {
+    const CancellationToken cancellationToken = progress->cancellationToken();
     // Create target mesh
     assert(Cpp::cmpLessEqual((m_vecIndex.size() / 3), INT_MAX));
     const int triangleCount = static_cast<int>(m_vecIndex.size() / 3);
@@ -162,6 +169,9 @@ TDF_Label PlyReader::transferMesh(DocumentPtr doc, TaskProgress* /*progress*/)
 
     // Copy nodes(vertices) into mesh
     for (int i = 0; Cpp::cmpLess(i, m_vecNodeCoord.size()); i += 3) {
+        if (cancellationToken.isCancelled())
+            return {};
+
         const auto& vec = m_vecNodeCoord;
         const gp_Pnt node = { vec.at(i), vec.at(i + 1), vec.at(i + 2) };
         MeshUtils::setNode(mesh, (i / 3) + 1, node);
@@ -169,6 +179,9 @@ TDF_Label PlyReader::transferMesh(DocumentPtr doc, TaskProgress* /*progress*/)
 
     // Copy triangles indices into mesh
     for (int i = 0; Cpp::cmpLess(i, m_vecIndex.size()); i += 3) {
+        if (cancellationToken.isCancelled())
+            return {};
+
         const auto& vec = m_vecIndex;
         const Poly_Triangle tri = { 1 + vec.at(i), 1 + vec.at(i + 1), 1 + vec.at(i + 2) };
         MeshUtils::setTriangle(mesh, (i / 3) + 1, tri);
@@ -176,6 +189,9 @@ TDF_Label PlyReader::transferMesh(DocumentPtr doc, TaskProgress* /*progress*/)
 
     // Copy normals(optional) into mesh
     for (int i = 0; Cpp::cmpLess(i, m_vecNormalCoord.size()); i += 3) {
+        if (cancellationToken.isCancelled())
+            return {};
+
         const auto& vec = m_vecNormalCoord;
         const MeshUtils::Poly_Triangulation_NormalType n(vec.at(i), vec.at(i + 1), vec.at(i + 2));
         MeshUtils::setNormal(mesh, (i / 3) + 1, n);
@@ -184,6 +200,9 @@ TDF_Label PlyReader::transferMesh(DocumentPtr doc, TaskProgress* /*progress*/)
     // Copy colors(optional) into mesh
     std::vector<Quantity_Color> vecColor;
     for (int i = 0; Cpp::cmpLess(i, m_vecColorComponent.size()); i += 3) {
+        if (cancellationToken.isCancelled())
+            return {};
+
         const auto& vec = m_vecColorComponent;
         const Quantity_Color color = {
             vec.at(i) / 255., vec.at(i + 1) / 255., vec.at(i + 2) / 255.,
@@ -199,17 +218,21 @@ TDF_Label PlyReader::transferMesh(DocumentPtr doc, TaskProgress* /*progress*/)
     return entityLabel;
 }
 
-TDF_Label PlyReader::transferPointCloud(DocumentPtr doc, TaskProgress* /*progress*/)
+TDF_Label PlyReader::transferPointCloud(DocumentPtr doc, TaskProgress* progress)
 {
+    const CancellationToken cancellationToken = progress->cancellationToken();
     const bool hasColors = !m_vecColorComponent.empty();
     const bool hasNormals = false; //!m_vecNormalCoord.empty();
     assert(Cpp::cmpLessEqual(m_vecNodeCoord.size(), INT_MAX));
-    auto gfxPoints = new Graphic3d_ArrayOfPoints(
+    OccHandle<Graphic3d_ArrayOfPoints> gfxPoints = new Graphic3d_ArrayOfPoints(
         static_cast<int>(m_vecNodeCoord.size()), hasColors, hasNormals
     );
 
     // Add nodes(vertices) into point cloud
     for (int i = 0; Cpp::cmpLess(i, m_vecNodeCoord.size()); i += 3) {
+        if (cancellationToken.isCancelled())
+            return {};
+
         const auto& vec = m_vecNodeCoord;
         const gp_Pnt node = { vec.at(i), vec.at(i + 1), vec.at(i + 2) };
         gfxPoints->AddVertex(node);
@@ -15,6 +15,7 @@
 #include "../base/messenger.h"
 #include "../base/property_builtins.h"
 #include "../base/property_enumeration.h"
+#include "../base/task_manager.h"
 #include "../base/task_progress.h"
 #include "../base/tkernel_utils.h"
 
@@ -52,6 +53,13 @@ Endianness hostEndianness()
     return Endianness::Unknown;
 }
 
+// Counts of the items to be recorded by PlyWriter::transfer()
+struct ItemCounts {
+    int itemCount = 0; // Meshes and point clouds
+    size_t nodeCount = 0;
+    size_t faceCount = 0;
+};
+
 } // namespace
 
 struct PlyWriterI18N {
@@ -91,21 +99,50 @@ bool PlyWriter::transfer(gsl::span<const ApplicationItem> appItems, TaskProgress
     // TODO Investigate bad looking 3D mesh when defining vertex colors
     // TODO Investigate task abort issue
 
-    // Count number of faces for progress report
-    int count = 0;
-    System::traverseUniqueItems(appItems, [&](const DocumentTreeNode& docTreeNode) {
-        if (docTreeNode.isLeaf()) {
-            IMeshAccess_visitMeshes(docTreeNode, [&](const IMeshAccess&) { ++count; });
-            if (findLabelDataFlags(docTreeNode.label()) & LabelData_HasPointCloudData)
-                ++count;
-        }
-    });
+    // Count items(meshes and point clouds) for progress report, and nodes/faces to reserve storage
+    // This only reads the model trees, so they can be traversed concurrently by the threads running
+    // the tasks
+    TaskExecutor* executor = progress->taskManager() ? &progress->taskManager()->executor() : nullptr;
+    const ItemCounts counts = System::reduceUniqueItemsParallel(
+        appItems,
+        ItemCounts{},
+        [](const DocumentTreeNode& docTreeNode) {
+            ItemCounts nodeCounts;
+            if (docTreeNode.isLeaf()) {
+                // Location doesn't matter for counting
+                IMeshAccess_visitMeshes(docTreeNode, TopLoc_Location(), [&](const IMeshAccess& mesh) {
+                    ++nodeCounts.itemCount;
+                    nodeCounts.nodeCount += mesh.triangulation()->NbNodes();
+                    nodeCounts.faceCount += mesh.triangulation()->NbTriangles();
+                });
+                if (findLabelDataFlags(docTreeNode.label()) & LabelData_HasPointCloudData) {
+                    ++nodeCounts.itemCount;
+                    auto pntCloud = CafUtils::findAttribute<PointCloudData>(docTreeNode.label());
+                    if (!pntCloud.IsNull() && !pntCloud->points().IsNull())
+                        nodeCounts.nodeCount += pntCloud->points()->VertexNumber();
+                }
+            }
+
+            return nodeCounts;
+        },
+        [](const ItemCounts& lhs, const ItemCounts& rhs) {
+            return ItemCounts{
+                lhs.itemCount + rhs.itemCount, lhs.nodeCount + rhs.nodeCount, lhs.faceCount + rhs.faceCount
+            };
+        },
+        executor
+    );
+    const int count = counts.itemCount;
+    m_vecNode.reserve(counts.nodeCount);
+    m_vecFace.reserve(counts.faceCount);
+    if (m_params.writeColors)
+        m_vecNodeColor.reserve(counts.nodeCount);
 
     // Record face meshes
     int iCount = 0;
-    System::traverseUniqueItems(appItems, [&](const DocumentTreeNode& docTreeNode) {
+    System::traverseUniqueItemsWithLocation(appItems, [&](const DocumentTreeNode& docTreeNode, const TopLoc_Location& loc) {
         if (docTreeNode.isLeaf() && !progress->isAbortRequested()) {
-            IMeshAccess_visitMeshes(docTreeNode, [&](const IMeshAccess& mesh) {
+            IMeshAccess_visitMeshes(docTreeNode, loc, [&](const IMeshAccess& mesh) {
                 this->addMesh(mesh);
                 progress->setValue(MathUtils::toPercent(++iCount, 0, count));
             });
@@ -11,26 +11,34 @@
 #include "test_base.h"
 
 #include "../src/base/application.h"
+#include "../src/base/application_item_selection_model.h"
 #include "../src/base/brep_utils.h"
 #include "../src/base/caf_utils.h"
 #include "../src/base/cpp_utils.h"
 #include "../src/base/enumeration.h"
 #include "../src/base/enumeration_fromenum.h"
+#include "../src/base/fast_signal.h"
 #include "../src/base/filepath.h"
 #include "../src/base/filepath_conv.h"
 #include "../src/base/geom_utils.h"
+#include "../src/base/label_data.h"
 #include "../src/base/libtree.h"
+#include "../src/base/libtree_parallel.h"
 #include "../src/base/occ_handle.h"
 #include "../src/base/mesh_utils.h"
 #include "../src/base/messenger.h"
 #include "../src/base/meta_enum.h"
 #include "../src/base/occt_ncollection_harray1_of_builtintypes.h"
+#include "../src/base/point_cloud_data.h"
 #include "../src/base/property_builtins.h"
 #include "../src/base/property_enumeration.h"
 #include "../src/base/property_value_conversion.h"
 #include "../src/base/settings.h"
 #include "../src/base/string_cache.h"
 #include "../src/base/string_conv.h"
+#include "../src/base/task_executor.h"
+#include "../src/base/task_progress_dispatcher.h"
+#include "../src/base/tracing.h"
 #include "../src/base/task_manager.h"
 #include "../src/base/tkernel_utils.h"
 #include "../src/base/unit.h"
@@ -38,8 +46,11 @@
 
 #include <BRep_Tool.hxx>
 #include <BRepAdaptor_Curve.hxx>
+#include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeTorus.hxx>
+#include <gp_Pln.hxx>
 #include <NCollection_String.hxx>
 #include <TopAbs_ShapeEnum.hxx>
 #include <TDataStd_Name.hxx>
@@ -49,16 +60,22 @@
 
 #include <gsl/util>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <clocale>
 #include <cmath>
 #include <climits>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -175,6 +192,40 @@ struct SignalEmitSpy {
     SignalConnectionHandle sigConnection;
 };
 
+// ISignalThreadHelper implementation storing the functions to be executed in some target thread,
+// they are actually executed on call to execPending()
+class PendingSignalThreadHelper : public ISignalThreadHelper {
+public:
+    std::any getCurrentThreadContext() override {
+        return std::this_thread::get_id();
+    }
+
+    void execInThread(const std::any&, const std::function<void()>& fn) override {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_vecPendingFunction.push_back(fn);
+    }
+
+    size_t pendingCount() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_vecPendingFunction.size();
+    }
+
+    void execPending() {
+        std::vector<std::function<void()>> vecFunction;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            vecFunction.swap(m_vecPendingFunction);
+        }
+
+        for (const std::function<void()>& fn : vecFunction)
+            fn();
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::function<void()>> m_vecPendingFunction;
+};
+
 template<typename T>
 std::shared_ptr<Property> createPropertyPtr()
 {
@@ -215,8 +266,10 @@ void TestBase::Application_test()
         auto _ = gsl::finally([=]{ app->closeDocument(doc); });
         QCOMPARE(doc->entityCount(), 0);
         SignalEmitSpy spyEntityAdded(&app->signalDocumentEntityAdded);
+        SignalEmitSpy spyEntitiesAdded(&app->signalDocumentEntitiesAdded);
         fnAddNewShapeEntity(doc, "SomeShape");
         QCOMPARE(spyEntityAdded.count, 1);
+        QCOMPARE(spyEntitiesAdded.count, 1);
         QCOMPARE(doc->entityCount(), 1);
         QVERIFY(XCaf::isShape(doc->firstEntityNodeLabel()));
         QCOMPARE(CafUtils::labelAttrStdName(doc->firstEntityNodeLabel()), to_OccExtString("SomeShape"));
@@ -258,6 +311,365 @@ void TestBase::DocumentRefCount_test()
     QCOMPARE(doc->GetRefCount(), 1);
 }
 
+void TestBase::DocumentFindTreeNodes_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    // Assembly with two instances of the same part
+    OccHandle<XCAFDoc_ShapeTool> shapeTool = doc->xcaf().shapeTool();
+    const TDF_Label labelPart = shapeTool->AddShape(BRepPrimAPI_MakeBox(10, 10, 10), false/*!makeAssembly*/);
+    const TDF_Label labelAsm = shapeTool->NewShape();
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(20, 0, 0));
+    shapeTool->AddComponent(labelAsm, labelPart, TopLoc_Location());
+    shapeTool->AddComponent(labelAsm, labelPart, TopLoc_Location(trsf));
+    shapeTool->UpdateAssemblies();
+    doc->addEntityTreeNode(labelAsm);
+
+    QCOMPARE(doc->entityCount(), 1);
+    const std::vector<TreeNodeId> vecAsmNodeId = doc->findTreeNodes(labelAsm);
+    QCOMPARE(vecAsmNodeId.size(), 1u);
+    QCOMPARE(vecAsmNodeId.front(), doc->firstEntityNodeId());
+    const std::vector<TreeNodeId> vecPartNodeId = doc->findTreeNodes(labelPart);
+    QCOMPARE(vecPartNodeId.size(), 2u);
+    for (TreeNodeId nodeId : vecPartNodeId) {
+        QCOMPARE(doc->modelTreeNodeLabel(nodeId), labelPart);
+        QCOMPARE(doc->modelTree().nodeRoot(nodeId), doc->firstEntityNodeId());
+    }
+
+    // Adding the same entity again must be a no-op
+    doc->addEntityTreeNode(labelAsm);
+    QCOMPARE(doc->entityCount(), 1);
+
+    doc->destroyEntity(doc->firstEntityNodeId());
+    QVERIFY(doc->findTreeNodes(labelAsm).empty());
+    QVERIFY(doc->findTreeNodes(labelPart).empty());
+}
+
+void TestBase::LabelDataFlags_cache_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    OccHandle<XCAFDoc_ShapeTool> shapeTool = doc->xcaf().shapeTool();
+    const TDF_Label labelBox = shapeTool->AddShape(BRepPrimAPI_MakeBox(10, 10, 10), false/*!makeAssembly*/);
+    const int attrCountBeforeTree = labelBox.NbAttributes();
+    doc->addEntityTreeNode(labelBox);
+
+    // Flags are cached when the model tree is built, but not as a label attribute
+    QCOMPARE(labelBox.NbAttributes(), attrCountBeforeTree);
+    QCOMPARE(findLabelDataFlags(labelBox), computeLabelDataFlags(labelBox));
+    QCOMPARE(doc->labelDataFlags(labelBox), findLabelDataFlags(labelBox));
+    QVERIFY(findLabelDataFlags(labelBox) & LabelData_HasShape);
+    QVERIFY(!(findLabelDataFlags(labelBox) & LabelData_ShapeIsFace));
+    QVERIFY(!(findLabelDataFlags(labelBox) & LabelData_HasPointCloudData));
+
+    // Adding data attribute invalidates the cache
+    PointCloudData::Set(labelBox);
+    QVERIFY(findLabelDataFlags(labelBox) & LabelData_HasPointCloudData);
+
+    // Setting the shape invalidates the cache
+    doc->xcaf().setShape(labelBox, BRepBuilderAPI_MakeFace(gp_Pln(gp::XOY()), 0, 10, 0, 10));
+    QVERIFY(findLabelDataFlags(labelBox) & LabelData_ShapeIsFace);
+    QCOMPARE(findLabelDataFlags(labelBox), computeLabelDataFlags(labelBox));
+}
+
+void TestBase::DocumentAddEntitiesBatch_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    NCollection_Sequence<TDF_Label> seqLabel;
+    for (int i = 0; i < 5; ++i)
+        seqLabel.Append(doc->xcaf().shapeTool()->AddShape(BRepPrimAPI_MakeBox(10, 10, 10), false));
+
+    std::vector<TreeNodeId> vecAddedEntityId;
+    SignalEmitSpy spyEntityAdded(&app->signalDocumentEntityAdded);
+    SignalEmitSpy spyEntitiesAdded(&app->signalDocumentEntitiesAdded);
+    auto conn = doc->signalEntitiesAdded.connectSlot([&](const std::vector<TreeNodeId>& vecEntityId) {
+        vecAddedEntityId = vecEntityId;
+    });
+    doc->addEntityTreeNodeSequence(seqLabel);
+    conn.disconnect();
+
+    // Single batch notification, per-entity notifications are still emitted
+    QCOMPARE(spyEntitiesAdded.count, 1);
+    QCOMPARE(spyEntityAdded.count, 5);
+    QCOMPARE(doc->entityCount(), 5);
+    QCOMPARE(vecAddedEntityId.size(), 5u);
+    for (int i = 0; i < 5; ++i)
+        QCOMPARE(doc->modelTreeNodeLabel(vecAddedEntityId.at(i)), seqLabel.Value(i + 1));
+
+    // Entities already in the model tree are ignored, no notification
+    doc->addEntityTreeNodeSequence(seqLabel);
+    QCOMPARE(spyEntitiesAdded.count, 1);
+    QCOMPARE(spyEntityAdded.count, 5);
+    QCOMPARE(doc->entityCount(), 5);
+}
+
+void TestBase::DocumentCopyEntities_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    // Scratch document isn't owned by the application
+    DocumentPtr scratchDoc = Document::newScratch();
+    QCOMPARE(app->documentCount(), 1);
+    QVERIFY(scratchDoc->isXCafDocument());
+
+    // Assembly with two instances of the same part
+    OccHandle<XCAFDoc_ShapeTool> scratchShapeTool = scratchDoc->xcaf().shapeTool();
+    const TDF_Label labelPart = scratchShapeTool->AddShape(BRepPrimAPI_MakeBox(10, 10, 10), false/*!makeAssembly*/);
+    TDataStd_Name::Set(labelPart, "part");
+    const TDF_Label labelAsm = scratchShapeTool->NewShape();
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(20, 0, 0));
+    scratchShapeTool->AddComponent(labelAsm, labelPart, TopLoc_Location());
+    scratchShapeTool->AddComponent(labelAsm, labelPart, TopLoc_Location(trsf));
+    scratchShapeTool->UpdateAssemblies();
+
+    NCollection_Sequence<TDF_Label> seqSrcLabel;
+    seqSrcLabel.Append(labelAsm);
+    const NCollection_Sequence<TDF_Label> seqNewLabel = doc->copyEntities(seqSrcLabel);
+    QCOMPARE(seqNewLabel.Size(), 1);
+    const TDF_Label labelNewAsm = seqNewLabel.First();
+    QVERIFY(Document::findFrom(labelNewAsm) == doc);
+    QVERIFY(XCaf::shape(labelNewAsm).IsEqual(XCaf::shape(labelAsm)));
+#if OCC_VERSION_HEX >= OCC_VERSION_CHECK(7, 6, 0)
+    // Copied part is shared by the two instances
+    QVERIFY(XCaf::isShapeAssembly(labelNewAsm));
+    const TDF_LabelSequence seqNewComponent = XCaf::shapeComponents(labelNewAsm);
+    QCOMPARE(seqNewComponent.Size(), 2);
+    const TDF_Label labelNewPart = XCaf::shapeReferred(seqNewComponent.First());
+    QCOMPARE(XCaf::shapeReferred(seqNewComponent.Last()), labelNewPart);
+    QVERIFY(CafUtils::labelAttrStdName(labelNewPart) == TCollection_ExtendedString("part"));
+#endif
+
+    doc->addEntityTreeNodeSequence(seqNewLabel);
+    QCOMPARE(doc->entityCount(), 1);
+}
+
+void TestBase::XCafDeduplicateProducts_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    // Two assemblies(as if coming from two files) each one having its own copy of the same part
+    OccHandle<XCAFDoc_ShapeTool> shapeTool = doc->xcaf().shapeTool();
+    NCollection_Sequence<TDF_Label> seqEntity;
+    NCollection_Sequence<TDF_Label> seqPart;
+    for (int i = 0; i < 2; ++i) {
+        const TDF_Label labelPart = shapeTool->AddShape(BRepPrimAPI_MakeBox(10, 10, 10), false/*!makeAssembly*/);
+        const TDF_Label labelOtherPart = shapeTool->AddShape(BRepPrimAPI_MakeBox(5 + i, 5, 5), false/*!makeAssembly*/);
+        const TDF_Label labelAsm = shapeTool->NewShape();
+        shapeTool->AddComponent(labelAsm, labelPart, TopLoc_Location());
+        shapeTool->AddComponent(labelAsm, labelOtherPart, TopLoc_Location());
+        seqEntity.Append(labelAsm);
+        seqPart.Append(labelPart);
+    }
+
+    shapeTool->UpdateAssemblies();
+
+    const XCaf::DeduplicateProductsResult result = doc->xcaf().deduplicateProducts(seqEntity);
+    QCOMPARE(result.productCount, 4);
+    QCOMPARE(result.duplicateCount, 1);
+    QCOMPARE(result.referenceCount, 1);
+    QVERIFY(result.savedMemorySize > 0);
+
+    // Both assemblies now refer to the first part, other parts differ so they are kept
+    const TDF_Label labelKept = seqPart.First();
+    for (const TDF_Label& labelAsm : seqEntity) {
+        const NCollection_Sequence<TDF_Label> seqComponent = XCaf::shapeComponents(labelAsm);
+        QCOMPARE(seqComponent.Size(), 2);
+        QCOMPARE(XCaf::shapeReferred(seqComponent.First()), labelKept);
+        QVERIFY(XCaf::shapeReferred(seqComponent.Last()) != labelKept);
+    }
+
+    QVERIFY(XCaf::shape(seqEntity.First()).NbChildren() == 2);
+    QVERIFY(!XCaf::isShape(seqPart.Last()));
+
+    // Nothing more to deduplicate
+    QCOMPARE(doc->xcaf().deduplicateProducts(seqEntity).duplicateCount, 0);
+}
+
+void TestBase::XCafDeduplicateProducts_sameFingerprint_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    // Tori with different radii but same topology, surface type and vertex position(12, 0, 0)
+    // The last torus is a duplicate of the first one
+    const std::pair<double, double> arrayRadii[] = { { 10., 2. }, { 8., 4. }, { 10., 2. } };
+    OccHandle<XCAFDoc_ShapeTool> shapeTool = doc->xcaf().shapeTool();
+    NCollection_Sequence<TDF_Label> seqEntity;
+    NCollection_Sequence<TDF_Label> seqPart;
+    for (const auto& [majorRadius, minorRadius] : arrayRadii) {
+        const TopoDS_Shape torus = BRepPrimAPI_MakeTorus(majorRadius, minorRadius);
+        const TDF_Label labelPart = shapeTool->AddShape(torus, false/*!makeAssembly*/);
+        const TDF_Label labelAsm = shapeTool->NewShape();
+        shapeTool->AddComponent(labelAsm, labelPart, TopLoc_Location());
+        seqEntity.Append(labelAsm);
+        seqPart.Append(labelPart);
+    }
+
+    shapeTool->UpdateAssemblies();
+
+    const XCaf::DeduplicateProductsResult result = doc->xcaf().deduplicateProducts(seqEntity);
+    QCOMPARE(result.productCount, 3);
+    QCOMPARE(result.duplicateCount, 1);
+    QCOMPARE(XCaf::shapeReferred(XCaf::shapeComponents(seqEntity.Value(1)).First()), seqPart.Value(1));
+    QCOMPARE(XCaf::shapeReferred(XCaf::shapeComponents(seqEntity.Value(2)).First()), seqPart.Value(2));
+    QCOMPARE(XCaf::shapeReferred(XCaf::shapeComponents(seqEntity.Value(3)).First()), seqPart.Value(1));
+    QVERIFY(XCaf::isShape(seqPart.Value(2)));
+    QVERIFY(!XCaf::isShape(seqPart.Value(3)));
+}
+
+void TestBase::XCafDeduplicateProducts_attributes_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    // Geometrically identical parts, only the second one has the same attributes as the first one
+    OccHandle<XCAFDoc_ShapeTool> shapeTool = doc->xcaf().shapeTool();
+    NCollection_Sequence<TDF_Label> seqEntity;
+    NCollection_Sequence<TDF_Label> seqPart;
+    const char* arrayPartName[] = { "part", "part", "other_part", "part" };
+    for (const char* partName : arrayPartName) {
+        const TDF_Label labelPart = shapeTool->AddShape(BRepPrimAPI_MakeBox(10, 10, 10), false/*!makeAssembly*/);
+        TDataStd_Name::Set(labelPart, partName);
+        const TDF_Label labelAsm = shapeTool->NewShape();
+        shapeTool->AddComponent(labelAsm, labelPart, TopLoc_Location());
+        seqEntity.Append(labelAsm);
+        seqPart.Append(labelPart);
+    }
+
+    doc->xcaf().materialTool()->SetMaterial(
+        seqPart.Value(4),
+        new TCollection_HAsciiString("steel"),
+        new TCollection_HAsciiString(""),
+        7.85,
+        new TCollection_HAsciiString("density"),
+        new TCollection_HAsciiString("POSITIVE_RATIO")
+    );
+    shapeTool->UpdateAssemblies();
+
+    const XCaf::DeduplicateProductsResult result = doc->xcaf().deduplicateProducts(seqEntity);
+    QCOMPARE(result.productCount, 4);
+    QCOMPARE(result.duplicateCount, 1);
+    QCOMPARE(result.savedMemorySize, BRepUtils::shapeToString(BRepPrimAPI_MakeBox(10, 10, 10)).size());
+    QCOMPARE(XCaf::shapeReferred(XCaf::shapeComponents(seqEntity.Value(2)).First()), seqPart.Value(1));
+    QVERIFY(!XCaf::isShape(seqPart.Value(2)));
+    for (int i : { 3, 4 }) {
+        QCOMPARE(XCaf::shapeReferred(XCaf::shapeComponents(seqEntity.Value(i)).First()), seqPart.Value(i));
+        QVERIFY(XCaf::isShape(seqPart.Value(i)));
+    }
+}
+
+void TestBase::ApplicationItemSelectionModel_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    std::vector<ApplicationItem> vecItem;
+    for (TreeNodeId id = 1; id <= 6; ++id)
+        vecItem.push_back(ApplicationItem(DocumentTreeNode(doc, id)));
+
+    ApplicationItemSelectionModel selModel;
+    std::vector<ApplicationItem> vecLastSelected;
+    std::vector<ApplicationItem> vecLastDeselected;
+    int changedCount = 0;
+    selModel.signalChanged.connectSlot([&](gsl::span<const ApplicationItem> selected, gsl::span<const ApplicationItem> deselected) {
+        vecLastSelected.assign(selected.begin(), selected.end());
+        vecLastDeselected.assign(deselected.begin(), deselected.end());
+        ++changedCount;
+    });
+
+    // Batch add with doublon, signal only contains new items
+    selModel.add(gsl::span<const ApplicationItem>(vecItem).subspan(0, 4));
+    selModel.add(std::vector<ApplicationItem>{ vecItem.at(5), vecItem.at(1), vecItem.at(5) });
+    QCOMPARE(changedCount, 2);
+    QCOMPARE(vecLastSelected.size(), 1u);
+    QVERIFY(vecLastSelected.front() == vecItem.at(5));
+    QVERIFY(vecLastDeselected.empty());
+    QCOMPARE(selModel.selectedItems().size(), 5u);
+    QVERIFY(selModel.isSelected(vecItem.at(5)));
+    QVERIFY(!selModel.isSelected(vecItem.at(4)));
+
+    // Nothing added, no signal
+    selModel.add(vecItem.at(0));
+    QCOMPARE(changedCount, 2);
+
+    // Batch remove keeps insertion order of remaining items
+    selModel.remove(std::vector<ApplicationItem>{ vecItem.at(1), vecItem.at(4), vecItem.at(3) });
+    QCOMPARE(changedCount, 3);
+    QCOMPARE(vecLastDeselected.size(), 2u);
+    const std::vector<ApplicationItem> vecExpected = { vecItem.at(0), vecItem.at(2), vecItem.at(5) };
+    QVERIFY(std::equal(
+                selModel.selectedItems().begin(), selModel.selectedItems().end(),
+                vecExpected.begin(), vecExpected.end()
+    ));
+    for (const ApplicationItem& item : vecExpected)
+        QVERIFY(selModel.isSelected(item));
+
+    QVERIFY(!selModel.isSelected(vecItem.at(1)));
+    selModel.remove(vecItem.at(5));
+    QVERIFY(!selModel.isSelected(vecItem.at(5)));
+    QVERIFY(selModel.isSelected(vecItem.at(2)));
+
+    // Index of the remaining items is still valid after removal of the first item
+    selModel.add(vecItem.at(4));
+    selModel.remove(vecItem.at(0));
+    selModel.remove(vecItem.at(4));
+    QCOMPARE(selModel.selectedItems().size(), 1u);
+    QVERIFY(selModel.selectedItems().front() == vecItem.at(2));
+    QVERIFY(selModel.isSelected(vecItem.at(2)));
+
+    selModel.clear();
+    QVERIFY(selModel.selectedItems().empty());
+    QCOMPARE(vecLastDeselected.size(), 1u);
+    QVERIFY(!selModel.isSelected(vecItem.at(2)));
+}
+
+void TestBase::ApplicationItemSelectionModel_benchmark()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    auto _ = gsl::finally([=]{ app->closeDocument(doc); });
+
+    const int itemCount = 100 * 1000;
+    std::vector<ApplicationItem> vecItem;
+    vecItem.reserve(itemCount);
+    for (int i = 1; i <= itemCount; ++i)
+        vecItem.push_back(ApplicationItem(DocumentTreeNode(doc, TreeNodeId(i))));
+
+    // Deselect every other item, then all of them
+    std::vector<ApplicationItem> vecHalfItem;
+    for (int i = 0; i < itemCount; i += 2)
+        vecHalfItem.push_back(vecItem.at(i));
+
+    ApplicationItemSelectionModel selModel;
+    QBENCHMARK {
+        selModel.add(vecItem);
+        selModel.remove(vecHalfItem);
+        selModel.remove(vecItem);
+        // Deselect items one by one, last selected first
+        selModel.add(vecItem);
+        for (auto it = vecItem.rbegin(); it != vecItem.rend(); ++it)
+            selModel.remove(*it);
+    }
+
+    QVERIFY(selModel.selectedItems().empty());
+}
+
 void TestBase::CppUtils_toggle_test()
 {
     bool v = false;
@@ -345,6 +757,81 @@ void TestBase::MessageCollecter_only_test_data()
         QTest::newRow(std::string{name}.c_str()) << value;
 }
 
+void TestBase::ConcurrentMessageCollecter_test()
+{
+    ConcurrentMessageCollecter msgCollect(10);
+    msgCollect.ignore(MessageType::Trace);
+    std::vector<std::thread> vecThread;
+    for (int i = 0; i < 4; ++i) {
+        vecThread.emplace_back([&, i]{
+            for (int j = 0; j < 1000; ++j) {
+                msgCollect.warning() << "Unsupported entity #" << (j % 3);
+                msgCollect.emitTrace("Ignored");
+                if (j % 100 == 0)
+                    msgCollect.error() << "Error #" << (i * 1000 + j);
+            }
+        });
+    }
+
+    for (std::thread& thread : vecThread)
+        thread.join();
+
+    // Identical messages are merged across threads
+    int warningCount = 0;
+    int errorCount = 0;
+    for (const ConcurrentMessageCollecter::Entry& entry : msgCollect.entries()) {
+        QVERIFY(entry.type != MessageType::Trace);
+        if (entry.type == MessageType::Warning) {
+            QVERIFY(entry.occurrenceCount > 300);
+            warningCount += entry.occurrenceCount;
+        }
+        else if (entry.type == MessageType::Error) {
+            QCOMPARE(entry.occurrenceCount, 1);
+            errorCount += entry.occurrenceCount;
+        }
+    }
+
+    QCOMPARE(warningCount, 4 * 1000);
+    QCOMPARE(errorCount, 10);
+    QCOMPARE(msgCollect.entries().size(), size_t(3 + 10));
+    QCOMPARE(errorCount + msgCollect.suppressedCount(MessageType::Error), 4 * 10);
+    QCOMPARE(msgCollect.suppressedCount(MessageType::Warning), 0);
+    const std::string strErrors = msgCollect.asString("\n", MessageType::Error);
+    QVERIFY(strErrors.find(std::to_string(4 * 10 - errorCount) + " more message(s) suppressed") != std::string::npos);
+    QVERIFY(msgCollect.asString("\n", MessageType::Warning).find("(x") != std::string::npos);
+
+    msgCollect.clear();
+    QVERIFY(msgCollect.entries().empty());
+    msgCollect.emitWarning("Single");
+    QCOMPARE(msgCollect.asString("\n", MessageType::Warning), std::string{"Single"});
+}
+
+void TestBase::ConcurrentMessageCollecter_errorAfterWarnings_test()
+{
+    ConcurrentMessageCollecter msgCollect(100);
+    std::thread thread([&]{
+        for (int i = 0; i < 150; ++i)
+            msgCollect.warning() << "Warning #" << i;
+
+        msgCollect.error() << "Error";
+    });
+    thread.join();
+    for (int i = 0; i < 150; ++i)
+        msgCollect.warning() << "Warning #" << (1000 + i);
+
+    msgCollect.error() << "Other error";
+
+    // Limit applies to each message type, errors aren't suppressed by previous warnings
+    const std::vector<ConcurrentMessageCollecter::Entry> vecEntry = msgCollect.entries();
+    const auto warningCount = std::count_if(vecEntry.cbegin(), vecEntry.cend(), [](const auto& entry) {
+        return entry.type == MessageType::Warning;
+    });
+    QCOMPARE(warningCount, 100);
+    QCOMPARE(msgCollect.suppressedCount(MessageType::Warning), 2 * 150 - 100);
+    QCOMPARE(msgCollect.suppressedCount(MessageType::Error), 0);
+    QCOMPARE(msgCollect.asString("\n", MessageType::Error), std::string{"Error\nOther error"});
+}
+
 void TestBase::OccHandle_test()
 {
     {
@@ -1046,6 +1533,236 @@ void TestBase::LibTask_test()
     QCOMPARE(vecProgressRec.back().value, 100.);
 }
 
+void TestBase::LibTaskProgress_concurrentChildren_test()
+{
+    // Children of the same TaskProgress updated concurrently must not lose any increment
+    TaskManager taskMgr;
+    double valueBeforeEnd = 0.;
+    const TaskId taskId = taskMgr.newTask([&](TaskProgress* progress) {
+        std::vector<std::thread> vecThread;
+        for (int i = 0; i < 4; ++i) {
+            vecThread.emplace_back([=]{
+                TaskProgress subProgress(progress, 25);
+                for (int j = 0; j <= 1000; ++j)
+                    subProgress.setValue(j / 10.);
+            });
+        }
+
+        for (std::thread& thread : vecThread)
+            thread.join();
+
+        valueBeforeEnd = progress->value();
+    });
+
+    std::atomic<int> signalCount = 0;
+    taskMgr.signalProgressChanged.connectSlot([&](TaskId, double) { ++signalCount; });
+    taskMgr.run(taskId);
+    taskMgr.waitForDone(taskId);
+    QVERIFY(std::abs(valueBeforeEnd - 100.) < 1e-6);
+    // Signal emission is throttled
+    QVERIFY(signalCount < 4 * 1000);
+}
+
+void TestBase::LibTaskProgress_abort_test()
+{
+    // Abort requested on a task must be seen by nested TaskProgress objects and by the tasks of a
+    // child TaskManager linked with setAbortSource()
+    // Loops are bounded in time, so the test fails instead of hanging if abort isn't seen
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    auto fnWaitAbort = [=](const CancellationToken& token) {
+        while (!token.isCancelled() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::yield();
+
+        return token.isCancelled();
+    };
+
+    TaskManager taskMgr(2);
+    std::atomic<bool> isJobStarted = false;
+    std::atomic<bool> isChildAbortSeen = false;
+    std::atomic<bool> isNestedTaskAbortSeen = false;
+    const TaskId taskId = taskMgr.newTask([&](TaskProgress* progress) {
+        TaskProgress child(progress, 50);
+        TaskProgress grandChild(&child, 50);
+        TaskManager childTaskMgr(&progress->taskManager()->executor());
+        childTaskMgr.setAbortSource(&grandChild);
+        const TaskId nestedTaskId = childTaskMgr.newTask([&](TaskProgress* nestedProgress) {
+            isNestedTaskAbortSeen = fnWaitAbort(nestedProgress->cancellationToken());
+        });
+        childTaskMgr.run(nestedTaskId, TaskAutoDestroy::Off);
+        isJobStarted = true;
+        isChildAbortSeen = fnWaitAbort(grandChild.cancellationToken()) && child.isAbortRequested();
+        childTaskMgr.waitForDone(nestedTaskId);
+    });
+    taskMgr.run(taskId, TaskAutoDestroy::Off);
+    while (!isJobStarted)
+        std::this_thread::yield();
+
+    taskMgr.requestAbort(taskId);
+    QVERIFY(taskMgr.waitForDone(taskId));
+    QVERIFY(isChildAbortSeen);
+    QVERIFY(isNestedTaskAbortSeen);
+    QVERIFY(!CancellationToken().isCancelled());
+    QVERIFY(!TaskProgress::null().cancellationToken().isCancelled());
+}
+
+void TestBase::LibTaskProgressDispatcher_test()
+{
+    TaskManager taskMgr;
+    int flushRequestCount = 0;
+    TaskProgressDispatcher dispatcher(&taskMgr, [&]{ ++flushRequestCount; });
+    std::unordered_map<TaskId, double> mapDelivered;
+    int deliveredCount = 0;
+    dispatcher.signalProgressChanged.connectSlot([&](TaskId taskId, double pct) {
+        mapDelivered.insert_or_assign(taskId, pct);
+        ++deliveredCount;
+    });
+
+    // Only the latest value of each task is delivered
+    for (int i = 0; i <= 100; ++i) {
+        taskMgr.signalProgressChanged.send(1, i);
+        taskMgr.signalProgressChanged.send(2, i / 2.);
+    }
+
+    QCOMPARE(flushRequestCount, 1);
+    QVERIFY(dispatcher.hasPendingUpdates());
+    dispatcher.flush();
+    QVERIFY(!dispatcher.hasPendingUpdates());
+    QCOMPARE(deliveredCount, 2);
+    QCOMPARE(mapDelivered.at(1), 100.);
+    QCOMPARE(mapDelivered.at(2), 50.);
+    QCOMPARE(dispatcher.sentUpdateCount(), uint64_t(202));
+    QCOMPARE(dispatcher.deliveredUpdateCount(), uint64_t(2));
+
+    // Pending update is dropped on task end
+    taskMgr.signalProgressChanged.send(1, 10.);
+    taskMgr.signalEnded.send(1);
+    QCOMPARE(flushRequestCount, 2);
+    dispatcher.flush();
+    QCOMPARE(deliveredCount, 2);
+}
+
+void TestBase::LibTaskExecutor_priority_test()
+{
+    std::vector<TaskPriority> vecPriority;
+    std::atomic<bool> isWorkerStarted = false;
+    std::atomic<bool> isWorkerBusy = true;
+    {
+        TaskExecutor executor(1);
+        // Keep the single worker busy while jobs are posted
+        executor.post([&]{
+            isWorkerStarted = true;
+            while (isWorkerBusy)
+                std::this_thread::yield();
+        });
+        while (!isWorkerStarted)
+            std::this_thread::yield();
+
+        for (TaskPriority priority : { TaskPriority::Low, TaskPriority::Normal, TaskPriority::High })
+            executor.post([&, priority]{ vecPriority.push_back(priority); }, priority);
+
+        isWorkerBusy = false;
+    } // Executor destructor waits for pending jobs
+
+    const std::vector<TaskPriority> vecExpected = { TaskPriority::High, TaskPriority::Normal, TaskPriority::Low };
+    QVERIFY(vecPriority == vecExpected);
+}
+
+void TestBase::LibTaskExecutor_nestedTasks_test()
+{
+    // Each task runs sub-tasks and waits for them, which must not dead-lock even if there are more
+    // tasks than threads
+    TaskManager taskMgr(2);
+    std::atomic<int> subTaskCount = 0;
+    std::vector<TaskId> vecTaskId;
+    for (int i = 0; i < 6; ++i) {
+        vecTaskId.push_back(taskMgr.newTask([&](TaskProgress* progress) {
+            TaskManager childTaskMgr(&progress->taskManager()->executor());
+            std::vector<TaskId> vecSubTaskId;
+            for (int j = 0; j < 10; ++j)
+                vecSubTaskId.push_back(childTaskMgr.newTask([&](TaskProgress*) { ++subTaskCount; }));
+
+            for (TaskId subTaskId : vecSubTaskId)
+                childTaskMgr.run(subTaskId, TaskAutoDestroy::Off);
+
+            for (TaskId subTaskId : vecSubTaskId)
+                childTaskMgr.waitForDone(subTaskId);
+        }));
+    }
+
+    for (TaskId taskId : vecTaskId)
+        taskMgr.run(taskId, TaskAutoDestroy::Off);
+
+    for (TaskId taskId : vecTaskId)
+        QVERIFY(taskMgr.waitForDone(taskId));
+
+    QCOMPARE(subTaskCount.load(), 60);
+    QCOMPARE(taskMgr.executor().threadCount(), 2);
+}
+
+void TestBase::LibTaskManager_dependencies_test()
+{
+    // Diamond graph: A -> {B, C} -> D
+    TaskManager taskMgr(2);
+    std::mutex mutexOrder;
+    std::vector<char> vecOrder;
+    auto fnJob = [&](char name) {
+        return [&, name](TaskProgress*) {
+            std::lock_guard<std::mutex> lock(mutexOrder);
+            vecOrder.push_back(name);
+        };
+    };
+
+    const TaskId taskA = taskMgr.newTask(fnJob('A'));
+    const TaskId taskB = taskMgr.newContinuation(taskA, fnJob('B'));
+    const TaskId taskC = taskMgr.newContinuation(taskA, fnJob('C'));
+    const TaskId taskBC = taskMgr.newTaskWhenAll({ taskB, taskC });
+    const TaskId taskD = taskMgr.newContinuation(taskBC, fnJob('D'));
+
+    // Run order doesn't matter, dependent tasks are scheduled when their dependencies are finished
+    for (TaskId taskId : { taskD, taskBC, taskC, taskB, taskA })
+        taskMgr.run(taskId, TaskAutoDestroy::Off);
+
+    QVERIFY(taskMgr.waitForDone(taskD));
+    QCOMPARE(vecOrder.size(), size_t(4));
+    QCOMPARE(vecOrder.front(), 'A');
+    QCOMPARE(vecOrder.back(), 'D');
+
+    // Dependency on a finished task is ignored
+    const TaskId taskE = taskMgr.newContinuation(taskD, fnJob('E'));
+    taskMgr.run(taskE, TaskAutoDestroy::Off);
+    QVERIFY(taskMgr.waitForDone(taskE));
+    QCOMPARE(vecOrder.back(), 'E');
+}
+
+void TestBase::Tracing_test()
+{
+    const uint64_t spanCountOnEntry = Tracing::spanCount();
+    {
+        const Tracing::ScopedSpan span("test", "Tracing_test/disabled");
+    }
+    QCOMPARE(Tracing::spanCount(), spanCountOnEntry);
+
+    Tracing::setEnabled(true);
+    auto _ = gsl::finally([]{ Tracing::setEnabled(false); });
+    std::vector<std::thread> vecThread;
+    for (int i = 0; i < 4; ++i) {
+        vecThread.emplace_back([]{
+            for (int j = 0; j < 5000; ++j) {
+                const Tracing::ScopedSpan span("test", "Tracing_test/\"span\"");
+            }
+        });
+    }
+
+    for (std::thread& thread : vecThread)
+        thread.join();
+
+    QCOMPARE(Tracing::spanCount(), spanCountOnEntry + 4 * 5000);
+    const std::string json = Tracing::toChromeTraceJson();
+    QVERIFY(json.find(R"("name":"Tracing_test/\"span\"")") != std::string::npos);
+    QVERIFY(json.find(R"("ph":"X")") != std::string::npos);
+    QVERIFY(json.find("Tracing_test/disabled") == std::string::npos);
+}
+
 void TestBase::LibTree_test()
 {
     const TreeNodeId nullptrId = 0;
@@ -1125,8 +1842,381 @@ void TestBase::LibTree_removeRoot_test()
     tree.removeRoot(root2);
     QVERIFY(tree.nodeCount() > 0);
     tree.removeRoot(root1);
-    // All root nodes removed: the count of nodes must be 0
-    QCOMPARE(tree.nodeCount(), 0);
+    // All root nodes removed: all the slots are free for reuse
+    QVERIFY(tree.roots().empty());
+    QCOMPARE(tree.deletedNodeCount(), tree.nodeCount());
+    QVERIFY(tree.isNodeDeleted(root1));
+    QVERIFY(tree.isNodeDeleted(root2));
+}
+
+void TestBase::LibTree_recycleRemovedNodes_test()
+{
+    auto fnTest = [](auto& tree) {
+        const TreeNodeId root1 = tree.appendChild(0, "root1");
+        const TreeNodeId root2 = tree.appendChild(0, "root2");
+        const TreeNodeId root1Child1 = tree.appendChild(root1, "1-child1");
+        tree.appendChild(root1, "1-child2");
+        QCOMPARE(tree.nodeCount(), 4);
+
+        tree.removeRoot(root1);
+        QCOMPARE(tree.deletedNodeCount(), 3);
+        QVERIFY(tree.isNodeDeleted(root1Child1));
+        QVERIFY(tree.nodeData(root1Child1).empty());
+
+        // Slots of removed nodes are reused, but identifiers of removed nodes must not refer to
+        // new nodes
+        const TreeNodeId root2Child1 = tree.appendChild(root2, "2-child1");
+        const TreeNodeId root3 = tree.appendChild(0, "root3");
+        QCOMPARE(tree.nodeCount(), 4);
+        QCOMPARE(tree.deletedNodeCount(), 1);
+        QVERIFY(root2Child1 != root1 && root2Child1 != root1Child1);
+        QVERIFY(root3 != root1 && root3 != root1Child1);
+        QVERIFY(tree.isNodeDeleted(root1));
+        QVERIFY(tree.isNodeDeleted(root1Child1));
+        QVERIFY(tree.nodeData(root1Child1).empty());
+        QCOMPARE(tree.nodeParent(root1Child1), 0);
+        QCOMPARE(tree.nodeParent(root2Child1), root2);
+        QCOMPARE(tree.nodeChildFirst(root3), 0);
+        QCOMPARE(tree.nodeData(root3), std::string{"root3"});
+        QCOMPARE(tree.roots().size(), 2);
+
+        // Identifiers stay unique along many add/remove cycles, the slot being retired once its
+        // generation is exhausted
+        std::unordered_set<TreeNodeId> setId;
+        for (int i = 0; i < 200; ++i) {
+            const TreeNodeId id = tree.appendChild(0, "temp");
+            QVERIFY(setId.insert(id).second);
+            tree.removeRoot(id);
+        }
+
+        QVERIFY(tree.nodeCount() < 10);
+        QCOMPARE(tree.nodeData(root3), std::string{"root3"});
+    };
+
+    Tree<std::string, TreeLayout::ArrayOfStructs> treeAoS;
+    fnTest(treeAoS);
+    Tree<std::string, TreeLayout::StructOfArrays> treeSoA;
+    fnTest(treeSoA);
+}
+
+void TestBase::LibTree_compact_test()
+{
+    auto fnPreOrderData = [](const auto& tree) {
+        std::string strData;
+        traverseTree_preOrder(tree, [&](TreeNodeId id) { strData += tree.nodeData(id) + ";"; });
+        return strData;
+    };
+
+    auto fnTest = [=](auto& tree) {
+        const TreeNodeId root1 = tree.appendChild(0, "root1");
+        const TreeNodeId root2 = tree.appendChild(0, "root2");
+        tree.appendChild(root1, "1-child1");
+        const TreeNodeId root2Child1 = tree.appendChild(root2, "2-child1");
+        tree.appendChild(root2Child1, "2-child1-child1");
+        tree.appendChild(root2, "2-child2");
+        const TreeNodeId root3 = tree.appendChild(0, "root3");
+        tree.appendChild(root3, "3-child1");
+
+        tree.removeRoot(root1);
+        const std::string strPreOrderData = fnPreOrderData(tree);
+        QCOMPARE(tree.nodeCount(), 8);
+
+        const std::unordered_map<TreeNodeId, TreeNodeId> mapNewId = tree.compact();
+        QCOMPARE(mapNewId.size(), 6);
+        QVERIFY(mapNewId.find(root1) == mapNewId.cend());
+        QCOMPARE(mapNewId.at(root2), 1);
+        QCOMPARE(mapNewId.at(root2Child1), 2);
+        QCOMPARE(mapNewId.at(root3), 5);
+        QCOMPARE(tree.nodeCount(), 6);
+        QCOMPARE(tree.deletedNodeCount(), 0);
+        QCOMPARE(tree.roots().size(), 2);
+        QCOMPARE(tree.roots()[0], mapNewId.at(root2));
+        QCOMPARE(tree.roots()[1], mapNewId.at(root3));
+        QCOMPARE(tree.nodeParent(mapNewId.at(root2Child1)), mapNewId.at(root2));
+        QCOMPARE(fnPreOrderData(tree), strPreOrderData);
+
+        // Compacting a tree without deleted nodes gives identity mapping
+        for (const auto& [oldId, newId] : tree.compact())
+            QCOMPARE(newId, oldId);
+    };
+
+    Tree<std::string, TreeLayout::ArrayOfStructs> treeAoS;
+    fnTest(treeAoS);
+    Tree<std::string, TreeLayout::StructOfArrays> treeSoA;
+    fnTest(treeSoA);
+}
+
+void TestBase::LibTree_parallelTraversal_test()
+{
+    // Tree with wide and unbalanced sub-trees
+    Tree<int> tree;
+    int dataSum = 0;
+    for (int i = 0; i < 3; ++i) {
+        const TreeNodeId rootId = tree.appendChild(0, i);
+        dataSum += i;
+        for (int j = 0; j < 50 * (i + 1); ++j) {
+            const TreeNodeId childId = tree.appendChild(rootId, j);
+            dataSum += j;
+            for (int k = 0; k < j % 7; ++k) {
+                tree.appendChild(childId, k);
+                dataSum += k;
+            }
+        }
+    }
+
+    // Each node visited once, after its parent
+    TaskExecutor executor(4);
+    std::vector<std::atomic<int>> vecVisitCount(tree.nodeCount() + 1);
+    std::atomic<bool> okParentVisitedFirst = true;
+    traverseTree_parallel(tree, [&](TreeNodeId id) {
+        const TreeNodeId parentId = tree.nodeParent(id);
+        if (parentId != 0 && vecVisitCount.at(parentId) != 1)
+            okParentVisitedFirst = false;
+
+        ++vecVisitCount.at(id);
+    }, executor);
+    QVERIFY(okParentVisitedFirst);
+    for (TreeNodeId id = 1; id <= tree.nodeCount(); ++id)
+        QCOMPARE(vecVisitCount.at(id).load(), 1);
+
+    // Parallel-reduce gives same result as sequential traversal
+    auto fnNodeData = [&](TreeNodeId id) { return tree.nodeData(id); };
+    auto fnSum = [](int lhs, int rhs) { return lhs + rhs; };
+    QCOMPARE(traverseTree_parallelReduce(tree, 0, fnNodeData, fnSum, executor), dataSum);
+
+    // Sub-tree traversal from a worker thread of the executor can't dead-lock
+    const TreeNodeId root2 = tree.roots()[1];
+    int root2NodeCount = 0;
+    int root2DataSum = 0;
+    traverseTree_preOrder(root2, tree, [&](TreeNodeId id) {
+        ++root2NodeCount;
+        root2DataSum += tree.nodeData(id);
+    });
+    std::atomic<int> visitCount = 0;
+    int root2ReduceSum = 0;
+    TaskManager taskMgr(&executor);
+    const TaskId taskId = taskMgr.newTask([&](TaskProgress*) {
+        traverseTree_parallel(root2, tree, [&](TreeNodeId) { ++visitCount; }, executor);
+        root2ReduceSum = traverseTree_parallelReduce(root2, tree, 0, fnNodeData, fnSum, executor);
+    });
+    taskMgr.run(taskId, TaskAutoDestroy::Off);
+    QVERIFY(taskMgr.waitForDone(taskId));
+    QCOMPARE(visitCount.load(), root2NodeCount);
+    QCOMPARE(root2ReduceSum, root2DataSum);
+
+    // Traversal completes even if all the worker threads are busy, the calling thread visits the
+    // sub-trees not claimed by the workers
+    std::atomic<bool> releaseWorkers = false;
+    std::atomic<int> busyWorkerCount = 0;
+    for (int i = 0; i < executor.threadCount(); ++i) {
+        executor.post([&]{
+            ++busyWorkerCount;
+            while (!releaseWorkers)
+                std::this_thread::yield();
+
+            --busyWorkerCount;
+        });
+    }
+
+    while (busyWorkerCount != executor.threadCount())
+        std::this_thread::yield();
+
+    QCOMPARE(traverseTree_parallelReduce(tree, 0, fnNodeData, fnSum, executor), dataSum);
+    releaseWorkers = true;
+    while (busyWorkerCount != 0)
+        std::this_thread::yield();
+
+    // Removed nodes are not visited
+    tree.removeRoot(root2);
+    visitCount = 0;
+    traverseTree_parallel(root2, tree, [&](TreeNodeId) { ++visitCount; }, executor);
+    QCOMPARE(visitCount.load(), 0);
+    QCOMPARE(traverseTree_parallelReduce(root2, tree, -1, fnNodeData, fnSum, executor), -1);
+}
+
+void TestBase::LibTree_traversePreOrder_benchmark_data()
+{
+    QTest::addColumn<bool>("structOfArrays");
+    QTest::addColumn<bool>("fragmented");
+    QTest::addColumn<bool>("compacted");
+
+    QTest::newRow("AoS") << false << false << false;
+    QTest::newRow("AoS-fragmented") << false << true << false;
+    QTest::newRow("AoS-compacted") << false << true << true;
+    QTest::newRow("SoA") << true << false << false;
+    QTest::newRow("SoA-fragmented") << true << true << false;
+    QTest::newRow("SoA-compacted") << true << true << true;
+}
+
+void TestBase::LibTree_traversePreOrder_benchmark()
+{
+    QFETCH(bool, structOfArrays);
+    QFETCH(bool, fragmented);
+    QFETCH(bool, compacted);
+
+    // Builds ~1M nodes tree having the payload of a model tree(TDF_Label is two pointers)
+    // In "fragmented" mode, entities are interleaved with entities being removed afterwards
+    using Payload = std::array<void*, 2>;
+    auto fnBenchmark = [=](auto& tree) {
+        std::vector<TreeNodeId> vecRootToRemove;
+        for (int i = 0; i < 1000; ++i) {
+            for (int j = 0; j < (fragmented ? 2 : 1); ++j) {
+                const TreeNodeId rootId = tree.appendChild(0, Payload{});
+                for (int k = 0; k < 100; ++k) {
+                    const TreeNodeId childId = tree.appendChild(rootId, Payload{});
+                    for (int l = 0; l < 9; ++l)
+                        tree.appendChild(childId, Payload{});
+                }
+
+                if (j == 1)
+                    vecRootToRemove.push_back(rootId);
+            }
+        }
+
+        for (TreeNodeId rootId : vecRootToRemove)
+            tree.removeRoot(rootId);
+
+        if (compacted)
+            tree.compact();
+
+        size_t visitCount = 0;
+        QBENCHMARK {
+            visitCount = 0;
+            traverseTree_preOrder(tree, [&](TreeNodeId) { ++visitCount; });
+        }
+
+        QCOMPARE(visitCount, 1000 * 1001);
+    };
+
+    if (structOfArrays) {
+        Tree<Payload, TreeLayout::StructOfArrays> tree;
+        fnBenchmark(tree);
+    }
+    else {
+        Tree<Payload, TreeLayout::ArrayOfStructs> tree;
+        fnBenchmark(tree);
+    }
+}
+
+void TestBase::FastSignal_test()
+{
+    // Small callables are stored inline
+    {
+        const int offset = 1;
+        const SmallFunction<int(int)> fnSmall([=](int value) { return value + offset; });
+        QVERIFY(fnSmall.isStoredInline());
+        QCOMPARE(fnSmall(1), 2);
+        const std::array<int, 64> arrayBig = { 5 };
+        SmallFunction<int(int)> fnBig([=](int value) { return value + arrayBig.front(); });
+        QVERIFY(!fnBig.isStoredInline());
+        const SmallFunction<int(int)> fnMoved(std::move(fnBig));
+        QVERIFY(!fnBig);
+        QCOMPARE(fnMoved(1), 6);
+    }
+
+    // Direct calls when no ISignalThreadHelper
+    {
+        struct Receiver {
+            void onValue(int value) { sum += value; }
+            int sum = 0;
+        };
+
+        FastSignal<int> signal;
+        Receiver receiver;
+        int count = 0;
+        FastSignalConnection conn = signal.connectSlot([&](int) { ++count; });
+        signal.connectSlot(&Receiver::onValue, &receiver);
+        signal.send(2);
+        QCOMPARE(count, 1);
+        QCOMPARE(receiver.sum, 2);
+        QCOMPARE(signal.slotCount(), size_t(2));
+        conn.disconnect();
+        QVERIFY(!conn.isActive());
+        signal.send(3);
+        QCOMPARE(count, 1);
+        QCOMPARE(receiver.sum, 5);
+        QCOMPARE(signal.slotCount(), size_t(1));
+    }
+
+    // Cross-thread calls are batched in a single queued function
+    auto helper = new PendingSignalThreadHelper;
+    setGlobalSignalThreadHelper(std::unique_ptr<ISignalThreadHelper>(helper));
+    auto _ = gsl::finally([]{ setGlobalSignalThreadHelper(nullptr); });
+    FastSignal<int, const std::string&> signal;
+    std::vector<int> vecValue;
+    std::string lastStr;
+    FastSignalConnection conn = signal.connectSlot([&](int value, const std::string& str) {
+        vecValue.push_back(value);
+        lastStr = str;
+    });
+    std::thread([&]{
+        for (int i = 0; i < 1000; ++i)
+            signal.send(i, std::to_string(i));
+    }).join();
+    QVERIFY(vecValue.empty());
+    QCOMPARE(helper->pendingCount(), size_t(1));
+    helper->execPending();
+    QCOMPARE(vecValue.size(), size_t(1000));
+    QVERIFY(std::is_sorted(vecValue.cbegin(), vecValue.cend()));
+    QCOMPARE(lastStr, std::string("999"));
+
+    // Calls pending on disconnection are dropped
+    std::thread([&]{ signal.send(1000, {}); }).join();
+    conn.disconnect();
+    helper->execPending();
+    QCOMPARE(vecValue.size(), size_t(1000));
+}
+
+void TestBase::Signal_emission_benchmark_data()
+{
+    QTest::addColumn<bool>("fastSignal");
+    QTest::addColumn<bool>("crossThread");
+
+    QTest::newRow("Signal") << false << false;
+    QTest::newRow("Signal-crossThread") << false << true;
+    QTest::newRow("FastSignal") << true << false;
+    QTest::newRow("FastSignal-crossThread") << true << true;
+}
+
+void TestBase::Signal_emission_benchmark()
+{
+    QFETCH(bool, fastSignal);
+    QFETCH(bool, crossThread);
+
+    // Emission cost of a signal having the arguments of TaskManager::signalProgressChanged
+    // In "crossThread" mode the slot is connected from another thread, so each call goes through
+    // the ISignalThreadHelper object. Pending calls are executed within the benchmark loop
+    auto helper = new PendingSignalThreadHelper;
+    setGlobalSignalThreadHelper(std::unique_ptr<ISignalThreadHelper>(helper));
+    auto _ = gsl::finally([]{ setGlobalSignalThreadHelper(nullptr); });
+    auto fnBenchmark = [=](auto& signal) {
+        uint64_t callCount = 0;
+        uint64_t emitCount = 0;
+        auto fnSlot = [&](TaskId, double) { ++callCount; };
+        if (crossThread)
+            std::thread([&]{ signal.connectSlot(fnSlot); }).join();
+        else
+            signal.connectSlot(fnSlot);
+
+        QBENCHMARK {
+            for (int i = 0; i < 1000; ++i)
+                signal.send(TaskId(i), i / 10.);
+
+            emitCount += 1000;
+            helper->execPending();
+        }
+
+        QCOMPARE(callCount, emitCount);
+    };
+
+    if (fastSignal) {
+        FastSignal<TaskId, double> signal;
+        fnBenchmark(signal);
+    }
+    else {
+        Signal<TaskId, double> signal;
+        fnBenchmark(signal);
+    }
 }
 
 void TestBase::Span_test()
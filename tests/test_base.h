@@ -17,6 +17,15 @@ class TestBase : public QObject {
 private slots:
     void Application_test();
     void DocumentRefCount_test();
+    void DocumentFindTreeNodes_test();
+    void LabelDataFlags_cache_test();
+    void DocumentAddEntitiesBatch_test();
+    void DocumentCopyEntities_test();
+    void XCafDeduplicateProducts_test();
+    void XCafDeduplicateProducts_sameFingerprint_test();
+    void XCafDeduplicateProducts_attributes_test();
+    void ApplicationItemSelectionModel_test();
+    void ApplicationItemSelectionModel_benchmark();
 
     void CppUtils_toggle_test();
 
@@ -28,6 +37,8 @@ private slots:
     void MessageCollecter_ignoreSingleMessageType_test_data();
     void MessageCollecter_only_test();
     void MessageCollecter_only_test_data();
+    void ConcurrentMessageCollecter_test();
+    void ConcurrentMessageCollecter_errorAfterWarnings_test();
 
     void OccHandle_test();
 
@@ -82,9 +93,25 @@ private slots:
     void UnitSystem_test_data();
 
     void LibTask_test();
+    void LibTaskProgress_concurrentChildren_test();
+    void LibTaskProgress_abort_test();
+    void LibTaskProgressDispatcher_test();
+    void LibTaskExecutor_priority_test();
+    void LibTaskExecutor_nestedTasks_test();
+    void LibTaskManager_dependencies_test();
+    void Tracing_test();
     void LibTree_test();
     void LibTree_nodeRoot_test();
     void LibTree_removeRoot_test();
+    void LibTree_recycleRemovedNodes_test();
+    void LibTree_compact_test();
+    void LibTree_parallelTraversal_test();
+    void LibTree_traversePreOrder_benchmark_data();
+    void LibTree_traversePreOrder_benchmark();
+
+    void FastSignal_test();
+    void Signal_emission_benchmark_data();
+    void Signal_emission_benchmark();
 
     void Span_test();
 
@@ -11,9 +11,14 @@
 #include "../src/base/mesh_utils.h"
 #include "../src/graphics/graphics_scene.h"
 #include "../src/graphics/graphics_shape_object_driver.h"
+#include "../src/gui/gui_application.h"
+#include "../src/io_image/io_image.h"
 
 #include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
 #include <BRep_Tool.hxx>
+#include <Image_AlienPixMap.hxx>
+#include <Standard_Failure.hxx>
 
 #include <QtTest/QtTest>
 
@@ -53,4 +58,57 @@ void TestGraphics::Regression_bugGitHub255_test()
     });
 }
 
+void TestGraphics::ImageBatchRenderer_test()
+{
+    auto app = makeOccHandle<Application>();
+    auto doc = app->newDocument();
+    const TDF_Label boxLabel = doc->newEntityShapeLabel();
+    doc->xcaf().setShape(boxLabel, BRepPrimAPI_MakeBox(25, 25, 25));
+    doc->addEntityTreeNode(boxLabel);
+    const TDF_Label cylinderLabel = doc->newEntityShapeLabel();
+    doc->xcaf().setShape(cylinderLabel, BRepPrimAPI_MakeCylinder(10, 40));
+    doc->addEntityTreeNode(cylinderLabel);
+    QCOMPARE(doc->entityCount(), 2);
+
+    GuiApplication guiApp(app);
+    guiApp.setAutomaticDocumentMapping(false);
+    guiApp.addGraphicsObjectDriver(makeOccHandle<GraphicsShapeObjectDriver>());
+
+    // Standard views of each entity, last job has a specific size so the virtual window is resized
+    std::vector<IO::ImageBatchRenderer::Job> vecJob;
+    for (TreeNodeId entityId : doc->allEntityNodeIds()) {
+        for (const IO::ImageBatchRenderer::StandardView& view : IO::ImageBatchRenderer::standardViews()) {
+            IO::ImageBatchRenderer::Job job;
+            job.doc = doc;
+            job.entityId = entityId;
+            job.cameraOrientation = view.cameraOrientation;
+            job.filepath = "tests/outputs/batch_" + std::to_string(entityId) + "_" + std::string(view.name) + ".png";
+            vecJob.push_back(job);
+        }
+    }
+
+    vecJob.back().width = 40;
+    vecJob.back().height = 30;
+
+    IO::ImageWriter::Parameters params;
+    params.width = 64;
+    params.height = 48;
+    IO::ImageBatchRenderer renderer(&guiApp, params);
+    renderer.setEncodingThreadCount(2);
+    int imageCount = 0;
+    try {
+        imageCount = renderer.run(vecJob);
+    } catch (const Standard_Failure& err) {
+        QSKIP(qPrintable(QString("No OpenGL offscreen rendering: %1").arg(err.GetMessageString())));
+    }
+
+    QCOMPARE(imageCount, int(vecJob.size()));
+    for (const IO::ImageBatchRenderer::Job& job : vecJob) {
+        Image_AlienPixMap pixmap;
+        QVERIFY(pixmap.Load(job.filepath.u8string().c_str()));
+        QCOMPARE(int(pixmap.SizeX()), job.width > 0 ? job.width : params.width);
+        QCOMPARE(int(pixmap.SizeY()), job.height > 0 ? job.height : params.height);
+    }
+}
+
 } // namespace Mayo
\ No newline at end of file
@@ -13,6 +13,7 @@ class TestGraphics : public QObject {
     Q_OBJECT
 private slots:
     void Regression_bugGitHub255_test();
+    void ImageBatchRenderer_test();
 };
 
 } // namespace Mayo
@@ -10,19 +10,34 @@
 #include "../src/base/io_system.h"
 #include "../src/base/occ_static_variables_rollback.h"
 #include "../src/base/string_conv.h"
+#include "../src/base/task_manager.h"
+#include "../src/base/task_progress.h"
 #include "../src/io_dxf/io_dxf.h"
 #include "../src/io_occ/io_occ.h"
+#if OCC_VERSION_HEX >= 0x070500
+#  include "../src/io_occ/io_occ_gltf_stream_writer.h"
+#endif
 #include "../src/io_off/io_off_reader.h"
 #include "../src/io_off/io_off_writer.h"
 #include "../src/io_ply/io_ply_reader.h"
 #include "../src/io_ply/io_ply_writer.h"
 #include <common/mayo_config.h>
+#ifdef MAYO_HAVE_GMIO
+#  include "../src/io_gmio/io_gmio_amf_writer.h"
+#  include "../src/io_gmio/zip_deflate_writer.h"
+#  include <zlib.h>
+#endif
 
 #include <BRep_Tool.hxx>
 #include <Interface_ParamType.hxx>
 #include <Interface_Static.hxx>
+#include <TopExp_Explorer.hxx>
 #include <TopoDS.hxx>
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
 // Needed for Q_FECTH()
 Q_DECLARE_METATYPE(Mayo::IO::Format)
 
@@ -282,6 +297,332 @@ void TestIO::IO_bugGitHub258_test()
     QCOMPARE(triangulation->NbTriangles(), 12);
 }
 
+void TestIO::IO_performanceReport_test()
+{
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    const FilePath listFilepath[] = { "tests/inputs/cube.step", "tests/inputs/cube.brep" };
+    IO::PerformanceReport importReport;
+    const bool okImport = m_ioSystem->importInDocument()
+            .targetDocument(doc)
+            .withFilepaths(listFilepath)
+            .withPerformanceReport(&importReport)
+            .execute()
+        ;
+    QVERIFY(okImport);
+    QCOMPARE(importReport.files.size(), size_t(2));
+    for (const IO::PerformanceReport::FileEntry& entry : importReport.files) {
+        QVERIFY(entry.success);
+        QVERIFY(entry.format != IO::Format_Unknown);
+        QCOMPARE(entry.fileSize, uint64_t(filepathFileSize(entry.filepath)));
+        QCOMPARE(entry.entityCount, 1);
+        QCOMPARE(entry.faceCount, 6);
+        QVERIFY(entry.readTime_ms > 0.);
+    }
+
+    QVERIFY(importReport.totalTime_ms > 0.);
+    const std::string strJson = importReport.toJson();
+    QVERIFY(strJson.find("\"format\": \"STEP\"") != std::string::npos);
+    QVERIFY(strJson.find("\"faceCount\": 6") != std::string::npos);
+
+    const FilePath outputFilepath = "tests/outputs/performance_report.brep";
+    IO::PerformanceReport exportReport;
+    const bool okExport = m_ioSystem->exportApplicationItems()
+            .targetFile(outputFilepath)
+            .targetFormat(IO::Format_OCCBREP)
+            .withItem(ApplicationItem{doc})
+            .withPerformanceReport(&exportReport)
+            .execute()
+        ;
+    QVERIFY(okExport);
+    QCOMPARE(exportReport.files.size(), size_t(1));
+    QVERIFY(exportReport.files.front().success);
+    QCOMPARE(exportReport.files.front().entityCount, 2);
+    QCOMPARE(exportReport.files.front().fileSize, uint64_t(filepathFileSize(outputFilepath)));
+    QVERIFY(exportReport.files.front().fileSize > 0);
+}
+
+void TestIO::IO_importInScratchDocuments_test()
+{
+    // Formats whose transfers run concurrently(BRep, OFF, PLY, STL) are mixed with formats whose
+    // transfers are serialized(STEP, IGES). Each format appears several times
+    const FilePath listFilepath[] = {
+        "tests/inputs/cube.step", "tests/inputs/cube.iges", "tests/inputs/cube.brep",
+        "tests/inputs/cube.off", "tests/inputs/cube.ply", "tests/inputs/cube.stla",
+        "tests/inputs/cube.step", "tests/inputs/cube.iges", "tests/inputs/cube.brep",
+        "tests/inputs/cube.off", "tests/inputs/cube.ply", "tests/inputs/cube.stlb"
+    };
+
+    // Repeat to increase the chance of concurrent transfers
+    for (int i = 0; i < 4; ++i) {
+        auto app = makeOccHandle<Application>();
+        DocumentPtr doc = app->newDocument();
+        const bool okImport = m_ioSystem->importInDocument()
+                .targetDocument(doc)
+                .withFilepaths(listFilepath)
+                .withTransferInScratchDocuments(true)
+                .execute()
+            ;
+        QVERIFY(okImport);
+        QCOMPARE(doc->entityCount(), int(std::size(listFilepath)));
+        for (TreeNodeId entityId : doc->allEntityNodeIds()) {
+            const TDF_Label entityLabel = doc->modelTreeNodeLabel(entityId);
+            QVERIFY(XCaf::isShape(entityLabel));
+            QVERIFY(!XCaf::shape(entityLabel).IsNull());
+        }
+
+        app->closeDocument(doc);
+    }
+}
+
+void TestIO::IO_readerAbortRequested_test()
+{
+    QFETCH(QString, strFilePath);
+
+    // Abort is requested before the task runs, reader must stop at its first check point
+    // Abort latency on large inputs is measured by mayo_bench(see option --max-abort-latency)
+    const FilePath filepath = strFilePath.toStdString();
+    std::unique_ptr<IO::Reader> reader = m_ioSystem->createReader(m_ioSystem->probeFormat(filepath));
+    QVERIFY(reader);
+    TaskManager taskMgr;
+    bool okRead = true;
+    const TaskId taskId = taskMgr.newTask([&](TaskProgress* progress) {
+        okRead = reader->readFile(filepath, progress);
+    });
+    taskMgr.requestAbort(taskId);
+    taskMgr.exec(taskId);
+    QVERIFY(!okRead);
+}
+
+void TestIO::IO_readerAbortRequested_test_data()
+{
+    QTest::addColumn<QString>("strFilePath");
+
+    QTest::newRow("OFF") << "tests/inputs/cube.off";
+    QTest::newRow("PLY") << "tests/inputs/cube.ply";
+    QTest::newRow("DXF") << "tests/inputs/lwpolyline_closed_duplicate_last_vertex.dxf";
+    QTest::newRow("STL(binary)") << "tests/inputs/cube.stlb";
+    QTest::newRow("STL(ascii)") << "tests/inputs/cube.stla";
+}
+
+#ifdef MAYO_HAVE_GMIO
+namespace {
+
+struct ZipEntryContents {
+    std::string filename;
+    std::string data; // Uncompressed
+    std::string error;
+};
+
+// Minimal reader of ZIP archives having a single "deflate" entry, independent of ZipDeflateWriter
+// Supports ZIP64 extensions
+ZipEntryContents readSingleEntryZipArchive(const FilePath& filepath)
+{
+    std::ifstream ifs(filepath, std::ios::binary);
+    const std::string bytes{ std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>() };
+    auto fnLE = [&](uint64_t pos, int byteCount) {
+        uint64_t v = 0;
+        for (int i = byteCount - 1; i >= 0; --i)
+            v = (v << 8) | uint8_t(bytes.at(pos + i));
+
+        return v;
+    };
+
+    ZipEntryContents entry;
+    constexpr size_t EndOfCentralDirSize = 22;
+    constexpr size_t Zip64EndOfCentralDirLocatorSize = 20;
+    if (bytes.size() < EndOfCentralDirSize || fnLE(bytes.size() - EndOfCentralDirSize, 4) != 0x06054b50) {
+        entry.error = "End of central directory not found";
+        return entry;
+    }
+
+    const uint64_t posEndOfCentralDir = bytes.size() - EndOfCentralDirSize;
+    uint64_t posCentralDir = fnLE(posEndOfCentralDir + 16, 4);
+    if (posCentralDir == UINT32_MAX) {
+        const uint64_t posLocator = posEndOfCentralDir - Zip64EndOfCentralDirLocatorSize;
+        const uint64_t posZip64EndOfCentralDir = fnLE(posLocator + 8, 8);
+        if (fnLE(posLocator, 4) != 0x07064b50 || fnLE(posZip64EndOfCentralDir, 4) != 0x06064b50) {
+            entry.error = "ZIP64 end of central directory not found";
+            return entry;
+        }
+
+        posCentralDir = fnLE(posZip64EndOfCentralDir + 48, 8);
+    }
+
+    if (fnLE(posCentralDir, 4) != 0x02014b50 || fnLE(posCentralDir + 10, 2) != 8/*deflate*/) {
+        entry.error = "Invalid central directory header";
+        return entry;
+    }
+
+    const auto crc = static_cast<uint32_t>(fnLE(posCentralDir + 16, 4));
+    uint64_t compressedSize = fnLE(posCentralDir + 20, 4);
+    uint64_t uncompressedSize = fnLE(posCentralDir + 24, 4);
+    const auto filenameLength = fnLE(posCentralDir + 28, 2);
+    const auto extraLength = fnLE(posCentralDir + 30, 2);
+    uint64_t posLocalHeader = fnLE(posCentralDir + 42, 4);
+    entry.filename = bytes.substr(posCentralDir + 46, filenameLength);
+    // ZIP64 extra field contains the values marked 0xFFFFFFFF, in that order
+    const uint64_t posExtra = posCentralDir + 46 + filenameLength;
+    if (extraLength > 0 && fnLE(posExtra, 2) == 0x0001) {
+        uint64_t posValue = posExtra + 4;
+        for (uint64_t* value : { &uncompressedSize, &compressedSize, &posLocalHeader }) {
+            if (*value == UINT32_MAX) {
+                *value = fnLE(posValue, 8);
+                posValue += 8;
+            }
+        }
+    }
+
+    if (fnLE(posLocalHeader, 4) != 0x04034b50) {
+        entry.error = "Invalid local file header";
+        return entry;
+    }
+
+    const uint64_t posData = posLocalHeader + 30 + fnLE(posLocalHeader + 26, 2) + fnLE(posLocalHeader + 28, 2);
+    entry.data.resize(uncompressedSize);
+    z_stream zstream = {};
+    inflateInit2(&zstream, -MAX_WBITS);
+    zstream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(bytes.data() + posData));
+    zstream.avail_in = static_cast<uInt>(compressedSize);
+    zstream.next_out = reinterpret_cast<Bytef*>(entry.data.data());
+    zstream.avail_out = static_cast<uInt>(uncompressedSize);
+    const int res = inflate(&zstream, Z_FINISH);
+    inflateEnd(&zstream);
+    if (res != Z_STREAM_END || zstream.total_out != uncompressedSize)
+        entry.error = "Inflate failed";
+    else if (crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(entry.data.data()), zstream.total_out) != crc)
+        entry.error = "CRC mismatch";
+
+    return entry;
+}
+
+} // namespace
+#endif
+
+void TestIO::IO_GmioAmfWriter_zipArchive_test()
+{
+#ifdef MAYO_HAVE_GMIO
+    QFETCH(bool, useZip64);
+
+    // Export AMF file compressed in a ZIP archive
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    const bool okImport = m_ioSystem->importInDocument()
+            .targetDocument(doc)
+            .withFilepath("tests/inputs/cube.stla")
+            .execute()
+        ;
+    QVERIFY(okImport);
+
+    const FilePath amfFilePath = useZip64 ? "tests/outputs/cube_zip64.amf.zip" : "tests/outputs/cube.amf.zip";
+    IO::GmioAmfWriter writer;
+    writer.parameters().createZipArchive = true;
+    writer.parameters().useZip64 = useZip64;
+    writer.parameters().zipEntryFilename = "cube.amf";
+    const ApplicationItem appItem(doc);
+    QVERIFY(writer.transfer(gsl::span<const ApplicationItem>(&appItem, 1), &TaskProgress::null()));
+    QVERIFY(writer.writeFile(amfFilePath, &TaskProgress::null()));
+    app->closeDocument(doc);
+
+    // Read back the archive and check the AMF contents
+    const ZipEntryContents amfEntry = readSingleEntryZipArchive(amfFilePath);
+    QVERIFY2(amfEntry.error.empty(), amfEntry.error.c_str());
+    QCOMPARE(amfEntry.filename, std::string("cube.amf"));
+    QVERIFY(amfEntry.data.find("<amf") != std::string::npos);
+    QVERIFY(amfEntry.data.find("</amf>") != std::string::npos);
+
+    // Data spanning many compression chunks
+    const FilePath dataFilePath = "tests/outputs/zip_deflate_writer.zip";
+    std::string data;
+    for (uint64_t i = 0; data.size() < 5 * 1024 * 1024; ++i)
+        data += std::to_string(i * 7919 % 100003) + ';';
+
+    IO::ZipDeflateWriter::Options zipOptions;
+    zipOptions.entryFilename = "data.txt";
+    zipOptions.useZip64 = useZip64;
+    IO::ZipDeflateWriter zipWriter(dataFilePath, zipOptions);
+    for (size_t pos = 0; pos < data.size(); pos += 100000)
+        QVERIFY(zipWriter.write(data.data() + pos, std::min<size_t>(100000, data.size() - pos)));
+
+    QVERIFY(zipWriter.finish());
+    QVERIFY(!zipWriter.isZip64Required());
+    QCOMPARE(zipWriter.uncompressedSize(), uint64_t(data.size()));
+    const ZipEntryContents dataEntry = readSingleEntryZipArchive(dataFilePath);
+    QVERIFY2(dataEntry.error.empty(), dataEntry.error.c_str());
+    QCOMPARE(dataEntry.filename, std::string("data.txt"));
+    QVERIFY(dataEntry.data == data);
+#endif
+}
+
+void TestIO::IO_GmioAmfWriter_zipArchive_test_data()
+{
+    QTest::addColumn<bool>("useZip64");
+
+    QTest::newRow("ZIP") << false;
+    QTest::newRow("ZIP64") << true;
+}
+
+void TestIO::IO_OccGltfStreamWriter_test()
+{
+#if OCC_VERSION_HEX >= 0x070600 && defined(OPENCASCADE_HAVE_RAPIDJSON)
+    QFETCH(QString, strOutputFilePath);
+    QFETCH(bool, isBinary);
+
+    auto app = makeOccHandle<Application>();
+    DocumentPtr doc = app->newDocument();
+    const bool okImport = m_ioSystem->importInDocument()
+            .targetDocument(doc)
+            .withFilepath("tests/inputs/cube.obj")
+            .execute()
+        ;
+    QVERIFY(okImport);
+    QVERIFY(doc->entityCount() > 0);
+
+    IO::GltfStreamWriter::Options options;
+    options.isBinary = isBinary;
+    IO::GltfStreamWriter writer(options);
+    const bool okWrite = writer.write(
+                strOutputFilePath.toStdString(), doc->xcaf().topLevelFreeShapes(), &TaskProgress::null()
+    );
+    QVERIFY2(okWrite, writer.errorMessage().c_str());
+    QCOMPARE(writer.meshCount(), 1);
+    QVERIFY(writer.binaryDataSize() > 0);
+    QCOMPARE(writer.binaryDataSize() % 4, uint64_t(0));
+    app->closeDocument(doc);
+
+    // Read back the glTF file and check the triangles are all there
+    doc = app->newDocument();
+    const bool okImportOutput = m_ioSystem->importInDocument()
+            .targetDocument(doc)
+            .withFilepath(strOutputFilePath.toStdString())
+            .execute()
+        ;
+    QVERIFY(okImportOutput);
+    QVERIFY(doc->entityCount() > 0);
+    int triangleCount = 0;
+    for (TreeNodeId entityId : doc->allEntityNodeIds()) {
+        const TopoDS_Shape shape = doc->xcaf().shape(doc->modelTreeNodeLabel(entityId));
+        for (TopExp_Explorer expl(shape, TopAbs_FACE); expl.More(); expl.Next()) {
+            TopLoc_Location locFace;
+            auto triangulation = BRep_Tool::Triangulation(TopoDS::Face(expl.Current()), locFace);
+            if (!triangulation.IsNull())
+                triangleCount += triangulation->NbTriangles();
+        }
+    }
+
+    QCOMPARE(triangleCount, 12);
+#endif
+}
+
+void TestIO::IO_OccGltfStreamWriter_test_data()
+{
+    QTest::addColumn<QString>("strOutputFilePath");
+    QTest::addColumn<bool>("isBinary");
+
+    QTest::newRow("GLB") << "tests/outputs/cube_stream.glb" << true;
+    QTest::newRow("glTF") << "tests/outputs/cube_stream.gltf" << false;
+}
+
 void TestIO::IO_dxfReplaceTextControlCodes_test()
 {
     QFETCH(QString, strInput);
@@ -25,6 +25,16 @@ private slots:
     void IO_bugGitHub166_test();
     void IO_bugGitHub166_test_data();
     void IO_bugGitHub258_test();
+    void IO_performanceReport_test();
+    void IO_importInScratchDocuments_test();
+    void IO_readerAbortRequested_test();
+    void IO_readerAbortRequested_test_data();
+
+    void IO_GmioAmfWriter_zipArchive_test();
+    void IO_GmioAmfWriter_zipArchive_test_data();
+
+    void IO_OccGltfStreamWriter_test();
+    void IO_OccGltfStreamWriter_test_data();
 
     void IO_dxfReplaceTextControlCodes_test();
     void IO_dxfReplaceTextControlCodes_test_data();